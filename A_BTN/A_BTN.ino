@@ -7,6 +7,10 @@ const byte THIS_MODULE = ARDUINO_BTN;  // Not sure if/where I will use this - in
 // A_BTN is only active when the system is in Manual mode, Running state.  Turnout button presses are ignored during all other
 // modes and states.  P.O.V. support can be added later if relevant.
 
+// 10/19/26: A real HALT now flushes the LCD before looping forever, so "HALT pin low!" is actually displayed.
+// 10/19/26: LCD text is now written by LCD.poll() each loop instead of inside send(), and flushed on fatal errors.
+// 10/19/26: Buttons are now scanned with two whole-port reads and debounced all at once, and every new press is queued, so
+//           simultaneous presses are no longer lost.  Replaces the blocking turnoutButtonDebounce() and RELEASE_DELAY_MS.
 // 04/22/18: Updating new global const, message and LCD display classes.
 // 09/16/17: Brought a lot of loop code out to functions; much streamlining, variable re-naming.
 // 09/13/17: Changed variable suffixes and constant names for better programming form.
@@ -84,8 +88,23 @@ byte msgOutgoing[RS485_MAX_LEN];              // No need to initialize contents.
 Centipede shiftRegister;          // create Centipede shift register object
 
 // *** MISC CONSTANTS AND GLOBALS: needed by A-BTN:
-unsigned long lastReleaseTimeMS      =   0;  // To prevent operator from pressing turnout buttons too quickly
-const unsigned long RELEASE_DELAY_MS = 200;  // Force operator to wait this many milliseconds between presses
+// 10/19/26: Buttons 1..32 are on Centipede pins 0..31, which is ports 0 and 1, so one scan is just two portRead() calls.
+// Each scan feeds a 2-bit vertical counter per button: a button must read the same for 4 scans in a row
+// before its debounced state changes.  All 32 counters are updated together with a few bitwise operations on unsigned longs.
+const unsigned long BUTTON_SCAN_MS   =   5;  // Scan interval; 4 scans x 5ms = 20ms debounce, same as the old delay(20)
+unsigned long lastScanTimeMS         =   0;  // millis() of the most recent button scan
+unsigned long buttonState            =   0;  // Debounced state, bit 0 = button #1, 1 = pressed
+unsigned long buttonCount0           =   0;  // Low bit of each button's vertical counter
+unsigned long buttonCount1           =   0;  // High bit of each button's vertical counter
+
+// *** BUTTON PRESS BUFFER...
+// Circular buffer of button numbers that have been pressed but not yet sent to A-MAS.  Sending a press waits for A-MAS to ask
+// for it, so presses that are debounced in the meantime wait here.  Same head/tail/count logic as our other circular buffers.
+const byte MAX_BUTTONS_TO_BUF        =  32;  // Operator would have to press every button at once to fill it
+byte buttonPressBufHead              =   0;  // Next array element to be written.
+byte buttonPressBufTail              =   0;  // Next array element to be removed.
+byte buttonPressBufCount             =   0;  // Num active elements in buffer.  Max is MAX_BUTTONS_TO_BUF.
+byte buttonPressBuf[MAX_BUTTONS_TO_BUF];     // Button numbers 1..TOTAL_TURNOUTS
 
 // *****************************************************************************************
 // **************************************  S E T U P  **************************************
@@ -116,6 +135,8 @@ void loop() {
 
   checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, release relays and just stop
 
+  LCD.poll();  // Trickle any new LCD text out to the display; never waits.
+
   // See if there is an incoming message.  If so, handle accordingly; otherwise watch for a button press.
   // Note that the ONLY message A-BTN cares about is a "mode broadcast" from A-MAS, and also of course
   // we need a "send button change" request message, but only after we ask A-MAS to ask us.
@@ -141,23 +162,22 @@ void loop() {
   if ((modeCurrent == MODE_MANUAL) && (stateCurrent == STATE_RUNNING)) {
 
     // If we get here, then we know we are in MODE_MANUAL, STATE_RUNNING.  This is the only case where we look for button presses.
-    // And, don't even bother checking for button press unless we have waited at least RELEASE_DELAY_MS since the last button release.
-    if ((millis() - lastReleaseTimeMS) > RELEASE_DELAY_MS) {
-
-      // Okay, it's been at least RELEASE_DELAY_MS since operator released a turnout control button, so check for another press...
-      // Find the FIRST control panel pushbutton that is being pressed.  Only handles one at a time.
-      byte buttonPressed = turnoutButtonPressed();   // Returns 0 if no button pressed; otherwise button number that was pressed.
-      if (buttonPressed > 0) {   // Operator pressed a pushbutton!
-
-        Message.sendTurnoutButtonPress(buttonPressed);  // Don't even need to send it the message buffer!
-
-        // The operator *just* pressed the button, so wait for bounce and final release before moving on...
-        turnoutButtonDebounce(buttonPressed);
+    // Scan all 32 buttons every BUTTON_SCAN_MS, and queue every button that was newly pressed (debounced) during this scan.
+    if ((millis() - lastScanTimeMS) >= BUTTON_SCAN_MS) {
+      lastScanTimeMS = millis();
+      turnoutButtonScan();
+    }
 
-        lastReleaseTimeMS = millis();   // Keep track of the last time a button was released
+    // Send at most one queued button press per pass through loop().
+    byte buttonPressed = 0;
+    if (buttonPressBufDequeue(&buttonPressed)) {   // Operator pressed a pushbutton!
+      Message.sendTurnoutButtonPress(buttonPressed);  // Don't even need to send it the message buffer!
+    }
 
-      }  // end of "if button pressed" code block
-    }    // end of "if we've waited long enough since button was released...
+  } else {   // Not Manual/Running, so forget about any presses not yet sent; they are meaningless in any other mode.
+    buttonPressBufHead  = 0;
+    buttonPressBufTail  = 0;
+    buttonPressBufCount = 0;
   }      // end of "if we are in manual mode, running state...
 
 }  // end of main loop()
@@ -199,39 +219,60 @@ void initializeShiftRegisterPins() {
   return;
 }
 
-byte turnoutButtonPressed() {
-  // Scans the Centipede input shift register connected to the control panel turnout buttons, and returns the button number being
-  // pressed, if any, or zero if no buttons currently being pressed.
-  // Rev 08/28/17.
-  byte bp = 0;  // This will be set to button number pressed, if any
-  for (int pinNum = 0; pinNum < TOTAL_TURNOUTS; pinNum++) {    // For Centipede input pin = 0..31
-    if (shiftRegister.digitalRead(pinNum) == LOW) {            // LOW == 0x0; HIGH == 0x1
-      bp = pinNum + 1;  // i.e. pin 0 = button/turnout 1
+void turnoutButtonScan() {
+  // Rev 10/19/26.  Was turnoutButtonPressed() + turnoutButtonDebounce(), which read one pin at a time and waited for release.
+  // Reads the Centipede input shift register connected to the control panel turnout buttons as two 16-bit ports, runs every
+  // button through its vertical counter, and enqueues each button whose debounced state just went from released to pressed.
+  // Buttons pull their pin LOW when pressed, so invert the raw reading to get 1 = pressed.
+  unsigned long rawPressed = ~(((unsigned long)(unsigned int)shiftRegister.portRead(1) << 16) |
+                                (unsigned long)(unsigned int)shiftRegister.portRead(0));
+  unsigned long delta = rawPressed ^ buttonState;               // Buttons that read differently than their debounced state
+  buttonCount1 = (buttonCount1 ^ buttonCount0) & delta;         // Count up for buttons that differ; reset the rest to zero
+  buttonCount0 = ~buttonCount0 & delta;
+  unsigned long toggle = delta & ~(buttonCount0 | buttonCount1);  // Counter wrapped: differed for 4 scans in a row
+  buttonState ^= toggle;
+  unsigned long newlyPressed = toggle & buttonState;
+  for (byte i = 0; i < TOTAL_TURNOUTS; i++) {
+    if (bitRead(newlyPressed, i)) {
       chirp();  // operator feedback!
-      sprintf(lcdString, "Button %2i pressed.", bp);
+      sprintf(lcdString, "Button %2i pressed.", i + 1);   // i.e. pin 0 = button/turnout 1
       LCD.send(lcdString);
       Serial.println(lcdString);
-      break;
+      buttonPressBufEnqueue(i + 1);
     }
   }
-  return bp;
+  return;
 }
 
-void turnoutButtonDebounce(const byte tButtonPressed) {
-  // After we detect a control panel turnout button press, and presumably after we have acted on it, we need a delay
-  // before we can resume checking for subsequent button presses (or even another press of this same button.)
-  // We must allow for some bounce when the pushbutton is pressed, and then more bounce when it is released.
-  // Rev 09/14/17.
-
-  // Wait long enough to for pushbutton to stop possibly bouncing so our look for "release button" will be valid
-  delay(20);  // don't let operator press buttons too quickly
-  // Now watch and wait for the operator to release the pushbutton...
-  while (shiftRegister.digitalRead(tButtonPressed - 1) == LOW) { }    // LOW == 0x0; HIGH == 0x1
-  // We also need some debounce after the operator releases the button
-  delay(20);
+void buttonPressBufEnqueue(const byte tButtonNum) {
+  // Rev: 10/19/26.  Insert a button number at the head of the button press buffer, then increment head and count.
+  // If the buffer is already full, trigger a fatal error and terminate.
+  if (buttonPressBufCount < MAX_BUTTONS_TO_BUF) {
+    buttonPressBuf[buttonPressBufHead] = tButtonNum;
+    buttonPressBufHead = (buttonPressBufHead + 1) % MAX_BUTTONS_TO_BUF;
+    buttonPressBufCount++;
+  } else {
+    sprintf(lcdString, "%.20s", "Button buf ovrflw!");
+    LCD.send(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(6);
+  }
   return;
 }
 
+bool buttonPressBufDequeue(byte * tButtonNum) {
+  // Rev: 10/19/26.  Retrieve the oldest button number, if any, from the button press buffer.
+  // Returns 'false' if buffer is empty, and the passed parameter remains undefined.  Not fatal.
+  if (buttonPressBufCount > 0) {
+    * tButtonNum = buttonPressBuf[buttonPressBufTail];
+    buttonPressBufTail = (buttonPressBufTail + 1) % MAX_BUTTONS_TO_BUF;
+    buttonPressBufCount--;
+    return true;
+  } else {
+    return false;  // Button press buffer is empty
+  }
+}
+
 // ***************************************************************************
 // *** HERE ARE FUNCTIONS USED BY VIRTUALLY ALL ARDUINOS *** REV: 09-12-16 ***
 // ***************************************************************************
@@ -240,6 +281,7 @@ void endWithFlashingLED(int numFlashes) {
   // Rev 10/05/16: Version for Arduinos WITHOUT relays that should be released.
 
 
+  LCD.flush();  // Make sure the error message is actually on the LCD before we stop.
   requestEmergencyStop();
   while (true) {
     for (int i = 1; i <= numFlashes; i++) {
@@ -289,6 +331,7 @@ void checkIfHaltPinPulledLow() {
       sprintf(lcdString, "%.20s", "HALT pin low!  End.");
       LCD.send(lcdString);
       Serial.println(lcdString);
+      LCD.flush();  // Make sure the message is actually on the LCD before we stop.
       while (true) { }  // For a real halt, just loop forever.
     } else {
       sprintf(lcdString, "False HALT detected.");
@@ -24,6 +24,10 @@ const byte THIS_MODULE = ARDUINO_LED;  // Not sure if/where I will use this - in
 // Note that HEAD == TAIL *both* when the buffer is empty and when full, so we use COUNT as the test for full/empty status.
 
 // IMPORTANT: LARGE AMOUNTS OF THIS CODE ARE IDENTIAL IN A-SWT, SO ALWAYS UPDATE A-SWT WHEN WE MAKE CHANGES TO THIS CODE.
+// 10/19/26: The FRAM1 layout check is now FramLayout::verify(), which also works on an 8K FRAM1 with the double-level tables.
+// 10/19/26: At startup, confirm FRAM1 holds the Route and Park tables we were compiled for, and that no record is damaged.
+// 10/19/26: Route, Park 1 and Park 2 records are read through FramTable, so repeated route commands are served from RAM.
+// 10/19/26: Turnout LEDs are recomputed only for the turnout that changed and its facing partner, and written a port at a time.
 // 07/19/18: Added F() macros to all Serial.print commands with literal text strings, saving 1 byte/char of RAM.
 // 04/22/18: Updating new global const, message and LCD display classes.
 // 09/16/17: Changed variable suffixes from Length to Len, No/Number to Num, Record to Rec, etc.
@@ -136,12 +140,15 @@ Centipede shiftRegister;          // create Centipede shift register object
 // Control buffer in each FRAM is first 128 bytes (address 0..127) reserved for any special purpose we want such as config info.
 #include <SPI.h>
 #include "Hackscribble_Ferro.h"
+#include "FramLayout.h"       // Layout header and per-record CRCs of the FRAM1 tables, checked at startup
+#include "FramTable.h"        // Typed, cached access to the Route, Park 1 and Park 2 tables in FRAM1
 const unsigned int FRAM_CONTROL_BUF_SIZE = 128;  // This defaults to 64 bytes in the library, but we modified it
 // FRAM1 stores the Route Reference, Park 1 Reference, and Park 2 Reference tables.
 // FRAM1 control block (first 128 bytes):
 // Address 0..2 (3 bytes)   = Version number month, date, year i.e. 07, 13, 16
 // Address 3..6 (4 bytes)   = Last known position of each turnout.  Bit 0 = Normal, 1 = Reverse.
 // Address 7..36 (30 bytes) = Last known train locations for train 1 thru 10: trainNum, blockNum, direction
+// Address 77..124 (48 bytes) = FramLayout header: layout version, and start/records/length/CRC address of each table
 byte               FRAM1ControlBuf[FRAM_CONTROL_BUF_SIZE];
 unsigned int       FRAM1BufSize             =   0;  // We will retrieve this via a function call, but it better be 128!
 unsigned long      FRAM1Bottom              =   0;  // Should be 128 (address 0..127)
@@ -165,6 +172,7 @@ const byte         FRAM1_PARK2_REC_LEN      =  52;  // Was 43 until 12/3/17
 const byte         FRAM1_PARK2_RECS         =   4;
 const byte         FRAM1_RECS_PER_PARK2     =   6;  // Max number of block/turnout records in a single Park 2 route in the route table.
 Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);   // Create the FRAM1 object!
+FramLayout         FRAM1Layout(&FRAM1);           // Describes the FRAM1 tables so we can check their CRCs; see checkFRAM1Layout()
 // FRAM2 control block (first 128 bytes) contains no data - we don't need a version number because we don't have any initial data to read.
 // FRAM2 stores the Delayed Action table.  Table is 12 bytes per record, perhaps 400 records => approx. 5K bytes.
 // byte               FRAM2ControlBuf[FRAM_CONTROL_BUF_SIZE];
@@ -193,6 +201,7 @@ const byte LED_GREEN_SOLID                =   1;  // Green turnout indicator LED
 const byte LED_GREEN_BLINKING             =   2;  // Green turnout indicator LED lit blinking
 const unsigned long LED_FLASH_MS          = 500;  // Toggle "conflicted" LEDs every 1/2 second
 const unsigned long LED_REFRESH_MS        = 100;  // Refresh LEDs on control panel every 50ms, just so it isn't constant
+const byte TOTAL_FACING_PAIRS             =   8;  // Number of LEDs shared by two facing turnouts (see TURNOUT_FACING_PAIR[])
 
 // *****************************************************************************************
 // *********************** S T R U C T U R E   D E F I N I T I O N S ***********************
@@ -244,6 +253,15 @@ struct park2Reference {                 // Each record 52 bytes long, total of j
 };
 park2Reference park2Element;  // Use this to hold individual elements when retrieved
 
+// Each table keeps its most recently used records in RAM, so a route that is set again (the usual case) skips the FRAM read.
+// Records are numbered from 0, so Route n is record n - 1.  The structs must be exactly the FRAM record length.
+static_assert(sizeof(routeReference) == FRAM1_ROUTE_REC_LEN, "routeReference must match FRAM1_ROUTE_REC_LEN");
+static_assert(sizeof(park1Reference) == FRAM1_PARK1_REC_LEN, "park1Reference must match FRAM1_PARK1_REC_LEN");
+static_assert(sizeof(park2Reference) == FRAM1_PARK2_REC_LEN, "park2Reference must match FRAM1_PARK2_REC_LEN");
+FramTable<routeReference, FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, 4> routeTable(&FRAM1);
+FramTable<park1Reference, FRAM1_PARK1_START, FRAM1_PARK1_RECS, 2> park1Table(&FRAM1);
+FramTable<park2Reference, FRAM1_PARK2_START, FRAM1_PARK2_RECS, 2> park2Table(&FRAM1);
+
 // *** TURNOUT COMMAND BUFFER...
 // 09/19/17: Re-wrote per new circular buffer logic.
 // Create a circular buffer to store incoming RS485 "set turnout" commands from A-MAS.
@@ -306,6 +324,37 @@ const byte LEDNormalTurnoutPin[TOTAL_TURNOUTS] =
 const byte LEDReverseTurnoutPin[TOTAL_TURNOUTS] =
    {16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63};
 
+// *** FACING TURNOUT PAIRS THAT SHARE AN LED...
+// Rev: 10/19/26.  The same eight conflicts listed above, as a table.  Each pair is two turnouts (0..31, one less than turnout number)
+// and the orientation of each whose LED pins are wired together.  The shared LED is solid or dark when both sides agree, and
+// blinks when one side is lit and the other is not.  The pins come from LEDNormalTurnoutPin[] or LEDReverseTurnoutPin[].
+struct facingPairStruct {
+  byte turnoutA;               // 0..31
+  char dirA;                   // 'N' or 'R'
+  byte turnoutB;               // 0..31
+  char dirB;                   // 'N' or 'R'
+};
+const facingPairStruct TURNOUT_FACING_PAIR[TOTAL_FACING_PAIRS] = {
+  { 0, 'R',  2, 'R'},          //  1R/3R   are pins 16 & 18
+  { 1, 'R',  4, 'R'},          //  2R/5R   are pins 17 & 20
+  { 5, 'R',  6, 'R'},          //  6R/7R   are pins 21 & 22
+  { 1, 'N',  2, 'N'},          //  2N/3N   are pins  1 &  2
+  { 3, 'N',  4, 'N'},          //  4N/5N   are pins  3 &  4
+  {11, 'N', 12, 'R'},          // 12N/13R  are pins 11 & 28
+  {16, 'N', 17, 'R'},          // 17N/18R  are pins 32 & 49
+  {26, 'N', 27, 'R'}           // 27N/28R  are pins 42 & 59
+};
+// turnoutFacingPairMask[0..31] has bit p set if that turnout is part of TURNOUT_FACING_PAIR[p].  Built once in setup() so that
+// a single turnout change only has to look at the (at most two) pairs it belongs to.
+byte turnoutFacingPairMask[TOTAL_TURNOUTS];
+
+// *** TURNOUT LED FRAME...
+// Rev: 10/19/26.  16-bit image of each of the four Centipede ports that drive the green LEDs.  updateLEDs() renders
+// turnoutLEDStatus[] into LEDFrame[] and only writes the ports that differ from LEDFrameWritten[].  A 1 bit is an LED that's off.
+unsigned int LEDFrame[4]        = {65535,65535,65535,65535};
+unsigned int LEDFrameWritten[4] = {65535,65535,65535,65535};  // initializeShiftRegisterPins() sets all HIGH
+bool turnoutLEDStatusChanged = false;   // Set when turnoutLEDStatus[] changes, so updateLEDs() repaints without waiting
+
 // *****************************************************************************************
 // **************************************  S E T U P  **************************************
 // *****************************************************************************************
@@ -318,6 +367,7 @@ void setup() {
   Wire.begin();                         // Start I2C for Centipede shift register
   shiftRegister.initialize();           // Set all registers to default
   initializeShiftRegisterPins();        // Set all chips on Centipede shift register to OUTPUT, high (i.e. turn off all LEDs)
+  initializeFacingPairMask();           // Build the turnout-to-facing-pair map used by turnoutLEDUpdate()
   initializePinIO();                    // Initialize all of the I/O pins
   initializeLCDDisplay();               // Initialize the Digole 20 x 04 LCD display
   sprintf(lcdString, APPVERSION);       // Display the application version number on the LCD display
@@ -377,10 +427,12 @@ void loop() {
         Serial.println(lcdString);
         // Retrieve route number "routeNum" from Route Reference table (FRAM1) and create a new record in the
         // turnout command buffer for each turnout in the route...
-        unsigned long FRAM1Address = FRAM1_ROUTE_START + ((routeNum - 1) * FRAM1_ROUTE_REC_LEN); // Rec # vs Route # offset by 1
-        byte b[FRAM1_ROUTE_REC_LEN];  // create a byte array to hold one Route Reference record
-        FRAM1.read(FRAM1Address, FRAM1_ROUTE_REC_LEN, b);  // (address, number_of_bytes_to_read, data
-        memcpy(&routeElement, b, FRAM1_ROUTE_REC_LEN);
+        if (routeTable.get(routeNum - 1, &routeElement) != ferroOK) {   // Rec # vs Route # offset by 1; also catches route 0 or too high
+          sprintf(lcdString, "%.20s", "Bad route number!");
+          sendToLCD(lcdString);
+          Serial.println(lcdString);
+          endWithFlashingLED(3);
+        }
         for (byte j = 0; j < FRAM1_RECS_PER_ROUTE; j++) {   // There are up to FRAM1_RECS_PER_ROUTE turnout|block commands per route, look at each one
           // If the first character is a 'T', then add this turnout to the command buffer.
           // The first character could also be 'B' for Block; ignore those here.
@@ -413,10 +465,12 @@ void loop() {
         Serial.println(lcdString);
         // Retrieve route number "routeNum" from Park 1 route Reference table (FRAM1) and create a new record in the
         // turnout command buffer for every turnout in the route...
-        unsigned long FRAM1Address = FRAM1_PARK1_START + ((routeNum - 1) * FRAM1_PARK1_REC_LEN); // Rec # vs Route # offset by 1
-        byte b[FRAM1_PARK1_REC_LEN];  // create a byte array to hold one Route Reference record
-        FRAM1.read(FRAM1Address, FRAM1_PARK1_REC_LEN, b);  // (address, number_of_bytes_to_read, data
-        memcpy(&park1Element, b, FRAM1_PARK1_REC_LEN);
+        if (park1Table.get(routeNum - 1, &park1Element) != ferroOK) {   // Rec # vs Route # offset by 1; also catches route 0 or too high
+          sprintf(lcdString, "%.20s", "Bad Park 1 number!");
+          sendToLCD(lcdString);
+          Serial.println(lcdString);
+          endWithFlashingLED(3);
+        }
         for (int j = 0; j < FRAM1_RECS_PER_PARK1; j++) {   // There are up to FRAM1_RECS_PER_PARK1 turnout|block commands per PARK1 route, look at each one
           // If the first character is a 'T', then add this turnout to the command buffer.
           // The first character could also be 'B' for Block; ignore those here.
@@ -449,10 +503,12 @@ void loop() {
         Serial.println(lcdString);
         // Retrieve route number "routeNum" from Park 2 route Reference table (FRAM1) and create a new record in the
         // turnout command buffer for every turnout in the route...
-        unsigned long FRAM1Address = FRAM1_PARK2_START + ((routeNum - 1) * FRAM1_PARK2_REC_LEN); // Rec # vs Route # offset by 1
-        byte b[FRAM1_PARK2_REC_LEN];  // create a byte array to hold one Route Reference record
-        FRAM1.read(FRAM1Address, FRAM1_PARK2_REC_LEN, b);  // (address, number_of_bytes_to_read, data
-        memcpy(&park2Element, b, FRAM1_PARK2_REC_LEN);
+        if (park2Table.get(routeNum - 1, &park2Element) != ferroOK) {   // Rec # vs Route # offset by 1; also catches route 0 or too high
+          sprintf(lcdString, "%.20s", "Bad Park 2 number!");
+          sendToLCD(lcdString);
+          Serial.println(lcdString);
+          endWithFlashingLED(3);
+        }
         for (int j = 0; j < FRAM1_RECS_PER_PARK2; j++) {   // There are up to FRAM1_RECS_PER_PARK2 turnout|block commands per PARK2 route, look at each one
           // If the first character is a 'T', then add this turnout to the command buffer.
           // The first character could also be 'B' for Block; ignore those here.
@@ -634,134 +690,77 @@ void turnoutCmdBufProcess() {   // Special version for A-LED, not the same as us
       // For example, we might update turnoutPosition[7] = 'R' to indicate turnout #7 is now in Reverse orientation
       turnoutDir[turnoutNumSingle - 1] = turnoutDirSingle;  // 'R' and 'N' are the only valid possibilities
 
-      // Now that we have revised our "turnoutPosition[0..31] = N or R" array, we should fully re-populate our turnoutLEDStatus[] array
-      // that indicates which green turnout LEDs should be on, off, or blinking -- taking into account "conflicts."
-      // There are 8 special cases, where we have an LED that is shared by two turnouts.  If the LED should bit lit based
-      // on one of the pair, but off according to the other turnout, then the shared LED should be blinking.
-      // This means that if two facing turnouts, that share an LED, are aligned with each other, then the LED will be solid.
-      // If those two turnouts are BOTH aligned away from each other, then the LED will be dark.
-      // Finally if one, but not both, turnout is aligned with the other, then the LED will blink.
-
-      // First update the "lit" status of the newly-acquired turnout LED(s) to illuminate Normal or Revers, and turn off it's opposite.
-      // This is done via the turnoutLEDStatus[0..63] array, where each element represents an LED, NOT A TURNOUT NUMBER.
-      // The offset to the LED number into the turnoutLEDStatus[0..63] array is found in the LEDNormalTurnoutPin[0..31] (for turnouts 1..32 'Normal')
-      // and LEDReverseTurnoutPin[0..31] (for turnouts 1..32 'Reverse') arrays, which are defined as constant byte arrays at the top of the code.
-      // I.e. suppose we just read Turnout #7 is now set to Reverse:
-      // Look up LEDNormalTurnoutPin[6] (turnout #7) =  Centipede pin 6, and LEDReverseTurnoutPin[6] (also turnout #7) = Centipede pin 22.
-      // So we will want to set LED #6 (7N) off (turnoutLEDStatus[6] = 0), and set LED #22 (7R) on (turnoutLEDStatus[22] = 1).
-      // For simplicity, and since this is all that this Arduino does, we'll re-populate the entire turnoutLEDStatus[] array every time
-      // we pass through this block -- i.e. every time a turnout changes its orientation.
-      // Then we will address any conflicts that should be resolved (facing turnouts that are misaligned.)
-
-      // Here is the "Map" of which turnout position LEDs are connected to which outputs on the Centipede shift registers:
-      // 1N = Centipede output 0      1R = Centipede output 16
-      // ...                          ...
-      // 16N = Centipede output 15    16R = Centipede output 31
-      // 17N = Centipede output 32    17R = Centipede output 48
-      // ...                          ...
-      // 32N = Centipede output 47    32R = Centipede output 63
-      // The above "map" is defined in the LEDNormalTurnoutPin[0..31] and LEDReverseTurnoutPin[0..31] arrays:
-      // const byte LEDNormalTurnoutPin[TOTAL_TURNOUTS] = 
-      //   { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47};
-      // const byte LEDReverseTurnoutPin[TOTAL_TURNOUTS] =
-      //   {16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63};
-
-      for (byte i = 0; i < TOTAL_TURNOUTS; i++) {
-        if (turnoutDir[i] == 'N') {
-          turnoutLEDStatus[LEDNormalTurnoutPin[i]] = LED_GREEN_SOLID;
-          turnoutLEDStatus[LEDReverseTurnoutPin[i]] = LED_DARK;
-        } else if (turnoutDir[i] == 'R') {
-          turnoutLEDStatus[LEDNormalTurnoutPin[i]] = LED_DARK;
-          turnoutLEDStatus[LEDReverseTurnoutPin[i]] = LED_GREEN_SOLID;
-        }
-      }
-
-      // Now we need to identify any conflicting turnout orientations, and set the appropriate turnoutLEDStatus[]'s to 2 = blinking.
-      // Here is a cross-reference of the possibly conflicting turnouts/orientations and their Centipede shift register pin numbers.
-      // Conflicting means when facing turnouts are not either *both* aligned with each other, or *both* aligned against the other.
-      // We are just going to hard-code this rather than be table-driven, because this isn't a commercial product.
-      // NOTE: This code must be modified if used on a new layout, obviously.
-      // 1R/3R are pins 16 & 18
-      // 2R/5R are pins 17 & 20
-      // 6R/7R are pins 21 & 22
-      // 2N/3N are pins 1 & 2
-      // 4N/5N are pins 3 & 4
-      // 12N/13R are pins 11 & 28
-      // 17N/18R are pins 32 & 49
-      // 27N/28R are pins 42 & 59
-      // If one of the above pair is "on" and the other is "off", then both pins (which are connected together) should be set to blink.
-      // DON'T FORGET TO SUBTRACT 1 FROM TURNOUT NUMBER WHEN SUBSTITUTING IN TURNOUTPOSITION[]
-
-      if ((turnoutDir[0] == 'R') && (turnoutDir[2] == 'N')) {   // Remember turnoutPosition[0] refers to turnout #1
-        turnoutLEDStatus[16] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[18] = LED_GREEN_BLINKING;
-      }
-      if ((turnoutDir[0] == 'N') && (turnoutDir[2] == 'R')) {   // Remember turnoutPosition[0] refers to turnout #1
-        turnoutLEDStatus[16] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[18] = LED_GREEN_BLINKING;
-      }
+      // Now that we have revised our "turnoutPosition[0..31] = N or R" array, update turnoutLEDStatus[] for just the LEDs that
+      // this turnout can affect: its own N and R LEDs, plus the shared LED of any facing pair it belongs to.
+      turnoutLEDUpdate(turnoutNumSingle - 1);
+    }
+  }
+  return;
+}
 
-      if ((turnoutDir[1] == 'R') && (turnoutDir[4] == 'N')) {
-        turnoutLEDStatus[17] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[20] = LED_GREEN_BLINKING;
-      }
-      if ((turnoutDir[1] == 'N') && (turnoutDir[4] == 'R')) {
-        turnoutLEDStatus[17] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[20] = LED_GREEN_BLINKING;
-      }
- 
-      if ((turnoutDir[5] == 'R') && (turnoutDir[6] == 'N')) {
-        turnoutLEDStatus[21] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[22] = LED_GREEN_BLINKING;
-      }
-      if ((turnoutDir[5] == 'N') && (turnoutDir[6] == 'R')) {
-        turnoutLEDStatus[21] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[22] = LED_GREEN_BLINKING;
-      }
+void initializeFacingPairMask() {
+  // Rev 10/19/26: Build turnoutFacingPairMask[0..31] from TURNOUT_FACING_PAIR[], so each turnout knows which pairs it is in.
+  for (byte i = 0; i < TOTAL_TURNOUTS; i++) {
+    turnoutFacingPairMask[i] = 0;
+  }
+  for (byte p = 0; p < TOTAL_FACING_PAIRS; p++) {
+    bitSet(turnoutFacingPairMask[TURNOUT_FACING_PAIR[p].turnoutA], p);
+    bitSet(turnoutFacingPairMask[TURNOUT_FACING_PAIR[p].turnoutB], p);
+  }
+  return;
+}
 
-      if ((turnoutDir[1] == 'N') && (turnoutDir[2] == 'R')) {
-        turnoutLEDStatus[1] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[1] = LED_GREEN_BLINKING;
-      }
-      if ((turnoutDir[1] == 'R') && (turnoutDir[2] == 'N')) {
-        turnoutLEDStatus[1] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[1] = LED_GREEN_BLINKING;
-      }
+byte turnoutLEDPin(const byte tTurnoutIndex, const char tDir) {
+  // Rev 10/19/26: Returns the Centipede pin 0..63 of the green LED for turnout 0..31 in orientation 'N' or 'R'.
+  if (tDir == 'N') {
+    return LEDNormalTurnoutPin[tTurnoutIndex];
+  } else {
+    return LEDReverseTurnoutPin[tTurnoutIndex];
+  }
+}
 
-      if ((turnoutDir[3] == 'N') && (turnoutDir[4] == 'R')) {
-        turnoutLEDStatus[3] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[4] = LED_GREEN_BLINKING;
-      }
-      if ((turnoutDir[3] == 'R') && (turnoutDir[4] == 'N')) {
-        turnoutLEDStatus[3] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[4] = LED_GREEN_BLINKING;
-      }
+void turnoutLEDSetStatus(const byte tPin, const byte tStatus) {
+  // Rev 10/19/26: Update one element of turnoutLEDStatus[], and flag updateLEDs() if it actually changed.
+  if (turnoutLEDStatus[tPin] != tStatus) {
+    turnoutLEDStatus[tPin] = tStatus;
+    turnoutLEDStatusChanged = true;
+  }
+  return;
+}
 
-      if ((turnoutDir[11] == 'N') && (turnoutDir[12] == 'N')) {
-        turnoutLEDStatus[11] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[28] = LED_GREEN_BLINKING;
-      }
-      if ((turnoutDir[11] == 'R') && (turnoutDir[12] == 'R')) {
-        turnoutLEDStatus[11] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[28] = LED_GREEN_BLINKING;
-      }
+void turnoutLEDUpdate(const byte tTurnoutIndex) {
+  // Rev 10/19/26: Recompute turnoutLEDStatus[] for only the LEDs affected by turnout tTurnoutIndex (0..31) changing.
+  // Previously we re-populated all 64 LEDs and re-checked all eight conflicts after every single turnout.
+  // First the turnout's own two LEDs: lit on the side it is thrown to, dark on the other.
+  // Then, for each facing pair this turnout belongs to, the shared LED is re-evaluated from both turnouts: if exactly one side
+  // is lit, both pins (which are wired together) blink.  A pin belongs to at most one pair, so this can't undo another pair.
+  // Turnouts that are still unknown (' ') leave their LEDs alone, as before.
+  if (turnoutDir[tTurnoutIndex] == 'N') {
+    turnoutLEDSetStatus(LEDNormalTurnoutPin[tTurnoutIndex], LED_GREEN_SOLID);
+    turnoutLEDSetStatus(LEDReverseTurnoutPin[tTurnoutIndex], LED_DARK);
+  } else if (turnoutDir[tTurnoutIndex] == 'R') {
+    turnoutLEDSetStatus(LEDNormalTurnoutPin[tTurnoutIndex], LED_DARK);
+    turnoutLEDSetStatus(LEDReverseTurnoutPin[tTurnoutIndex], LED_GREEN_SOLID);
+  }
 
-      if ((turnoutDir[16] == 'N') && (turnoutDir[17] == 'N')) {
-        turnoutLEDStatus[32] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[49] = LED_GREEN_BLINKING;
+  for (byte p = 0; p < TOTAL_FACING_PAIRS; p++) {
+    if (bitRead(turnoutFacingPairMask[tTurnoutIndex], p) == 1) {
+      char dirA = turnoutDir[TURNOUT_FACING_PAIR[p].turnoutA];
+      char dirB = turnoutDir[TURNOUT_FACING_PAIR[p].turnoutB];
+      byte pinA = turnoutLEDPin(TURNOUT_FACING_PAIR[p].turnoutA, TURNOUT_FACING_PAIR[p].dirA);
+      byte pinB = turnoutLEDPin(TURNOUT_FACING_PAIR[p].turnoutB, TURNOUT_FACING_PAIR[p].dirB);
+      bool litA = (dirA == TURNOUT_FACING_PAIR[p].dirA);
+      bool litB = (dirB == TURNOUT_FACING_PAIR[p].dirB);
+      // Start from each side's own solid/dark status, since an earlier conflict may have left it blinking.
+      if (dirA != ' ') {
+        turnoutLEDSetStatus(pinA, (litA ? LED_GREEN_SOLID : LED_DARK));
       }
-      if ((turnoutDir[16] == 'R') && (turnoutDir[17] == 'R')) {
-        turnoutLEDStatus[32] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[49] = LED_GREEN_BLINKING;
+      if (dirB != ' ') {
+        turnoutLEDSetStatus(pinB, (litB ? LED_GREEN_SOLID : LED_DARK));
       }
-
-      if ((turnoutDir[26] == 'N') && (turnoutDir[27] == 'N')) {
-        turnoutLEDStatus[42] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[59] = LED_GREEN_BLINKING;
-      }
-      if ((turnoutDir[26] == 'R') && (turnoutDir[27] == 'R')) {
-        turnoutLEDStatus[42] = LED_GREEN_BLINKING;
-        turnoutLEDStatus[59] = LED_GREEN_BLINKING;
+      if ((dirA != ' ') && (dirB != ' ') && (litA != litB)) {   // Conflict, so blink the shared LED
+        turnoutLEDSetStatus(pinA, LED_GREEN_BLINKING);
+        turnoutLEDSetStatus(pinB, LED_GREEN_BLINKING);
       }
     }
   }
@@ -769,58 +768,49 @@ void turnoutCmdBufProcess() {   // Special version for A-LED, not the same as us
 }
 
 void updateLEDs() {
+  // Rev 10/19/26: Now renders into LEDFrame[] and writes only changed ports with portWrite(), instead of 64 digitalWrite()s.
+  // Repaints as soon as turnoutLEDStatus[] changes, and otherwise every LED_REFRESH_MS so blinking and mode/state changes are
+  // picked up.  An unchanged panel costs no I2C traffic at all.
   // Rev 10/23/16: Based on the array of current turnout status, update every green turnout-indicator LED on the control panel.
   // Note that although there are not actually two LEDs for every turnout - since facing turnouts share an LED - we have 64
   // outputs wired, so we can code as if there are 64 LEDs.
   // Any facing turnouts THAT ARE NOT IN SYNC will have their shared LED blinking.  Otherwise, just turn each green LED on or
   // off, as appropriate.
-  // We will update all green LEDs after every LED_REFRESH_MS number of milliseconds passes i.e every 1/10 second or whatever.
-  // However we will only flash them at a rate of toggling every LED_FLASH_MS milliseconds i.e. every 1/2 second or so.
+  // We will only flash them at a rate of toggling every LED_FLASH_MS milliseconds i.e. every 1/2 second or so.
   // When we have facing turnouts that may not be aligned with each other (i.e. "conflicted",) we want the dual-role LED to
   // blink, rather than be on or off.  I can't think of any other way to indicate those cases.
 
   // At this point, we should already have: turnoutLEDStatus[0..63] = 0 (off), 1 (on), or 2 (blinking)
   // So now just update the physical LEDs on the control panel.
-  // const int LED_FLASH_MS = 500;           // Toggle "conflicted" LEDs every 1/2 second
-  // const int LED_REFRESH_MS = 100;         // Refresh LEDs on control panel every 50ms, just so it isn't constant
-
-  // We have two delay periods, because we want the flashing LEDs to toggle on/off only every 1/2 second or so, but when we
-  // are updating the LEDs because a bunch of turnouts are being thrown, we want to turn them on or off at the same rate
-  // that they are physically being thrown by A-SWT -- about every 110ms at this point.  I.e. faster than the blink rate.
   static unsigned long LEDRefreshProcessed = millis(); // Delay between updating the LEDs on the control panel i.e. 1/10 second.
-  static unsigned long LEDFlashProcessed = millis();   // Delay between toggling flashing LEDs on control panel i.e. 1/2 second.
-  static bool LEDsOn = false;    // Toggle this variable to know when conflict LEDs should be on versus off.  NOT USED YET
-  
-  if ((((millis() - LEDRefreshProcessed) > LED_REFRESH_MS))) {
-    // If we get here, then we should refresh the status of the LEDs on the control panel in case turnoutPosition[] has changed.
-    LEDRefreshProcessed = millis();  // Reset "refresh delay" timer.  HAVE NOT USED THIS YET.
-    
-    // Write a ZERO to a bit to turn on the LED, write a ONE to a bit to turn the LED off.  Opposite of our turnoutLEDStatus[] array.
-
-    for (byte i = 0; i < TOTAL_TURNOUTS * 2; i++) {    // For every "bit" of the Centipede shift register output
-      if (stateCurrent == STATE_STOPPED) {   // Darken all green LEDs when in ANY mode, if Stopped
-        shiftRegister.digitalWrite(i, HIGH);       // turn off the LED
-      } else if (modeCurrent == MODE_REGISTER) {  // Darken all green LEDs when in Register mode, any state
-        shiftRegister.digitalWrite(i, HIGH);       // turn off the LED
-      } else {   // mode is not MODE_REGISTER, and state is either STATE_RUNNING or STATE_STOPPING, so okay to illuminate LEDs
-        if (turnoutLEDStatus[i] == LED_DARK) {   // LED should be off
-          shiftRegister.digitalWrite(i, HIGH);       // turn off the LED
-        } else if (turnoutLEDStatus[i] == LED_GREEN_SOLID) {   // LED should be on
-          shiftRegister.digitalWrite(i, LOW);        // turn on the LED
-        } else {                          // Must be 2 = LED_GREEN_BLINKING
-          if (LEDsOn) {
-            shiftRegister.digitalWrite(i, LOW);        // turn on the LED until we have code to handle this
-          } else {
-            shiftRegister.digitalWrite(i, HIGH);        // turn on the LED until we have code to handle this
-          }
-        }
+
+  if ((!turnoutLEDStatusChanged) && ((millis() - LEDRefreshProcessed) <= LED_REFRESH_MS)) {
+    return;
+  }
+  LEDRefreshProcessed = millis();  // Reset "refresh delay" timer.
+  turnoutLEDStatusChanged = false;
+
+  bool LEDsOn = (((millis() / LED_FLASH_MS) % 2) == 0);   // Should conflicted LEDs be on or off at this moment?
+  bool allDark = ((stateCurrent == STATE_STOPPED) || (modeCurrent == MODE_REGISTER));  // Darken all green LEDs if Stopped or Register
+
+  // Write a ZERO to a bit to turn on the LED, write a ONE to a bit to turn the LED off.  Opposite of our turnoutLEDStatus[] array.
+  for (byte i = 0; i < TOTAL_TURNOUTS * 2; i++) {    // For every "bit" of the Centipede shift register output
+    bool lit = false;
+    if (!allDark) {   // mode is not MODE_REGISTER, and state is either STATE_RUNNING or STATE_STOPPING, so okay to illuminate LEDs
+      if (turnoutLEDStatus[i] == LED_GREEN_SOLID) {
+        lit = true;
+      } else if (turnoutLEDStatus[i] == LED_GREEN_BLINKING) {
+        lit = LEDsOn;
       }
     }
+    bitWrite(LEDFrame[i >> 4], (i & 0x0F), (lit ? 0 : 1));
   }
 
-  if ((millis() - LEDFlashProcessed) > LED_FLASH_MS) {
-    LEDFlashProcessed = millis();   // Reset flash timer (about every 1/2 second)
-    LEDsOn = !LEDsOn;    // Invert flash toggle
+  for (byte i = 0; i < 4; i++) {   // Now send only the ports that actually changed
+    if (LEDFrame[i] != LEDFrameWritten[i]) {
+      shiftRegister.portWrite(i, LEDFrame[i]);
+      LEDFrameWritten[i] = LEDFrame[i];
+    }
   }
   return;
 }
@@ -1000,10 +990,29 @@ void initializeFRAM1AndGetControlBlock() {
     }
   }
 
+  checkFRAM1Layout();  // Fatal error if the tables are not what we expect, or any record is damaged
+
   // A-MAS will also retrieve last-known-turnout and last-known-train positions from control block, but nobody else needs this.
   return;
 }
 
+void checkFRAM1Layout() {
+  // Rev: 10/19/26.  Called by initializeFRAM1AndGetControlBlock() once the control block has been read.
+  // Populate_FRAM_Route_Reference stamps FRAM1 with a description of the Route, Park 1 and Park 2 tables and CRCs of their
+  // records.  FRAM1Layout.verify() checks that description matches our FRAM1_ constants (if not, FRAM1 was populated for a
+  // different layout, or before 10/19/26, and must be populated again), then reads every record and checks the CRCs, which takes
+  // a few tens of milliseconds.  If anything is wrong, lcdString says what.
+  FRAM1Layout.addTable(FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, FRAM1_ROUTE_REC_LEN, "Rte");
+  FRAM1Layout.addTable(FRAM1_PARK1_START, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN, "Pk1");
+  FRAM1Layout.addTable(FRAM1_PARK2_START, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN, "Pk2");
+  if (!FRAM1Layout.verify(FRAM1ControlBuf, "FRAM1", lcdString)) {
+    sendToLCD(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(1);
+  }
+  return;
+}
+
 void initializeLCDDisplay() {
   // Rev 09/26/17 by RDP
   LCDDisplay.begin();                     // Required to initialize LCD
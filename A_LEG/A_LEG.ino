@@ -14,6 +14,16 @@ char APPVERSION[21] = "A-LEG Rev. 07/19/18";
 // GOOD IDEA: If smoke is on, how about a command to turn OFF smoke on all locos if they have been running for more than 10 minutes?
 
 
+// 10/19/26: A failed FRAM2 read of the Delayed Action table is now a fatal error, instead of acting on garbage.
+// 10/19/26: The FRAM1 layout check is now FramLayout::verify(), which also works on an 8K FRAM1 with the double-level tables.
+// 10/19/26: Moved the Train Stopping table arithmetic into the TrainStopping library, so it can be checked on a PC.
+//           Its use when a train enters its destination siding is in the Auto/Park sensor code that's still commented out.
+// 10/19/26: At startup, confirm FRAM1 holds the Route and Park tables we were compiled for, and that no record is damaged.
+// 10/19/26: Delayed Action table scans now read FRAM2 as one stream instead of one SPI transaction per record.
+// 10/19/26: Snoop the 'O' occupancy snapshot from A-SNS when a mode starts, and replace sensorStatus[] with it.
+// 10/19/26: Added 'V' and 'K' speed calibration messages from A-MAS; calibrated mm/sec curves are saved in FRAM1 and used for stopping.
+// 10/19/26: Added trainStopping[][][] lookup table, built at startup, to time the slow-down when a train enters its destination siding.
+// 10/19/26: Added 'H' horn/whistle pattern Delayed Action records, expanded one quilling-horn command at a time by hornPatternProcess().
 // 07/19/18: Added F() macros to all Serial.print commands with literal text strings, saving 1 byte/char of RAM.
 // 09/16/17: Changed variable suffixes from Length to Len, No/Number to Num, Record to Rec, etc.
 // 02/29/17: Adding logic for Auto mode, and populating and processing Delayed Action and Train Progress tables.
@@ -111,15 +121,26 @@ char APPVERSION[21] = "A-LEG Rev. 07/19/18";
 //      6  Cksum      Byte  0..255
 
 // A-SNS to A-MAS:  Sensor status update for a single sensor change (A-LEG snoops directly, and updates Train Progress etc.)
-// Rev: 08/31/17
+// Rev: 10/19/26
 // OFFSET  DESC       SIZE  CONTENTS
-//      0  Length     Byte  7
+//      0  Length     Byte  11
 //      1  To         Byte  1 (A_MAS)
 //      2  From       Byte  3 (A_SNS)
 //      3  Command    Char  'S' Sensor status update
 //      4  Sensor #   Byte  1..52 (Note that as of Sept 2017, we have disconnected sensor 53 from the layout)
 //      5  Trip/Clr   Byte  [0|1] 0-Cleared, 1=Tripped
-//      6  Checksum   Byte  0..255
+//   6..9  Captured   ULong micros() on A-SNS when the change was seen, low byte first.  For speed calculations.
+//     10  Checksum   Byte  0..255
+
+// A-SNS to A-MAS:  Occupancy snapshot, the status of every sensor in one message (A-LEG snoops directly)
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  13
+//      1  To         Byte  1 (A_MAS)
+//      2  From       Byte  3 (A_SNS)
+//      3  Command    Char  'O' Occupancy snapshot
+//  4..11  Sensors    Byte  64 bits: 0=Cleared, 1=Tripped.  Sensor #1 is bit 0 of byte 4, sensor #9 is bit 0 of byte 5, etc.
+//     12  Checksum   Byte  0..255
 
 // A-MAS to A-LEG: Tell A-LEG if operator wants SMOKE, based on a/n query by A-OCC.  Registration mode only.
 // Rev: 09/27/17
@@ -154,6 +175,31 @@ char APPVERSION[21] = "A-LEG Rev. 07/19/18";
 //      7  Last?      Char  'N' means there will be another identified train message coming; 'Y' means we are done and no train data in this record.
 //      8  Cksum      Byte  0..255
 
+// A-MAS to A-LEG: Set a train's speed for the next step of a speed calibration run.  Auto mode (calibration run) only.
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  7
+//      1  To         Byte  2 (A-LEG)
+//      2  From       Byte  1 (A_MAS)
+//      3  Msg Type   Char  'V' = Velocity step
+//      4  Train No.  Byte  [1..MAX_TRAINS]
+//      5  Speed      Byte  Legacy absolute speed 0..199.  Zero ends the run.
+//      6  Cksum      Byte  0..255
+
+// A-MAS to A-LEG: Fitted speed calibration curve for a train, at the end of a calibration run.  We save it in our own FRAM1 control block.
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  10
+//      1  To         Byte  2 (A-LEG)
+//      2  From       Byte  1 (A_MAS)
+//      3  Msg Type   Char  'K' = Calibration curve
+//      4  Train No.  Byte  [1..MAX_TRAINS]
+//      5  Slope      Byte  2 bytes, low byte first: mm/sec per Legacy speed step, times 256
+//      6  Slope      Byte
+//      7  Intercept  Byte  2 bytes, low byte first, signed: mm/sec at Legacy speed zero
+//      8  Intercept  Byte
+//      9  Cksum      Byte  0..255
+
 // A-MAS to A-LEG:  Command to set a new Route (regular, or Park 1 or Park 2) or a registered train.  AUTO and PARK MODE only.
 // Rev: 08/31/17
 // OFFSET  DESC       SIZE  CONTENTS
@@ -219,13 +265,18 @@ Centipede shiftRegister;          // create Centipede shift register object
 // Control buffer in each FRAM is first 128 bytes (address 0..127) reserved for any special purpose we want such as config info.
 #include <SPI.h>
 #include "Hackscribble_Ferro.h"
+#include "FramLayout.h"       // Layout header and per-record CRCs of the FRAM1 tables, checked at startup
+#include "TrainStopping.h"    // Stopping distance and slow-down delay arithmetic for the Train Stopping table
 const unsigned int FRAM_CONTROL_BUF_SIZE = 128;  // This defaults to 64 bytes in the library, but we modified it
 // FRAM1 stores the Route Reference, Park 1 Reference, and Park 2 Reference tables.
 // FRAM1 control block (first 128 bytes):
 // Address 0..2 (3 bytes)   = Version number month, date, year i.e. 07, 13, 16
 // Address 3..6 (4 bytes)   = Last known position of each turnout.  Bit 0 = Normal, 1 = Reverse.
 // Address 7..36 (30 bytes) = Last known train locations for train 1 thru 10: trainNum, blockNum, direction
+// Address 37..76 (40 bytes) = Speed calibration curve for train 1 thru 8: 'Y' if calibrated, slope (2 bytes), intercept (2 bytes)
+// Address 77..124 (48 bytes) = FramLayout header: layout version, and start/records/length/CRC address of each table
 byte               FRAM1ControlBuf[FRAM_CONTROL_BUF_SIZE];
+const byte         FRAM1_CALIBRATION_OFFSET =  37;  // Offset into the FRAM1 control block of the speed calibration curves
 unsigned int       FRAM1BufSize             =   0;  // We will retrieve this via a function call, but it better be 128!
 unsigned long      FRAM1Bottom              =   0;  // Should be 128 (address 0..127)
 unsigned long      FRAM1Top                 =   0;  // Highest address we can write to...should be 8191 (addresses are 0..8191 = 8192 bytes total)
@@ -248,6 +299,7 @@ const byte         FRAM1_PARK2_REC_LEN      =  52;  // Was 43 until 12/3/17
 const byte         FRAM1_PARK2_RECS         =   4;
 const byte         FRAM1_RECS_PER_PARK2     =   6;  // Max number of block/turnout records in a single Park 2 route in the route table.
 Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);   // Create the FRAM1 object!
+FramLayout         FRAM1Layout(&FRAM1);           // Describes the FRAM1 tables so we can check their CRCs; see checkFRAM1Layout()
 // FRAM2 control block (first 128 bytes) contains no data - we don't need a version number because we don't have any initial data to read.
 // FRAM2 stores the Delayed Action table.  Table is 12 bytes per record, perhaps 400 records => approx. 5K bytes.
 byte               FRAM2ControlBuf[FRAM_CONTROL_BUF_SIZE];
@@ -316,6 +368,23 @@ const byte SMOKE_OFF                 =    0;   // Legacy command value for smoke
 const byte SMOKE_ON                  =    3;   // Legacy command value for smoke = high
 const byte STARTUP_SLOW              =  251;   // Legacy command value for slow loco startup sequence
 const byte STARTUP_FAST              =  252;   // Legacy command value for immediate loco startup
+const byte QUILLING_HORN_OFF         =  224;   // Legacy basic command for quilling horn intensity zero, which stops the horn/whistle
+
+// HORN/WHISTLE PATTERNS Rev: 10/19/26.
+// A whole horn or whistle signal (i.e. "= = o =" for a grade crossing) is stored as a single Delayed Action 'H' record, rather than a
+// dozen or more separate 'B'asic quilling-horn records.  parm1 holds the pattern and parm2 holds the train number 1..8, so that the
+// toot lengths, delays, and intensities can be looked up in the Train Reference table when the pattern is sounded.
+// The pattern is up to four toots, two bits per toot, sounded starting with the LOW-order bits.  00 = end of pattern, 01 = short "o",
+// 10 = long "=".  The pattern ends at the first 00 pair, or after four toots.
+const byte HORN_TOOT_END             = 0b00;
+const byte HORN_TOOT_SHORT           = 0b01;
+const byte HORN_TOOT_LONG            = 0b10;
+const byte HORN_STOPPED              = 0b00000001;  // o        Stopped, air brakes applied, pressure equalized.
+const byte HORN_APPROACHING          = 0b00000010;  // =        Approaching station.
+const byte HORN_ACKNOWLEDGE          = 0b00000101;  // o o      Ack. of any communication i.e. an order to start the train.
+const byte HORN_PROCEED              = 0b00001010;  // = =      Release brakes and proceed.
+const byte HORN_GRADE_CROSSING       = 0b10011010;  // = = o =  Approaching grade crossing.
+const byte HORN_BACKING_UP           = 0b00010101;  // o o o    Stopped, going to back up.  Only used in Park mode.
 bool smokeOn                         = false;  // Defined during registration; turn on loco smoke when starting up?
 bool slowStartup                     = false;  // Defined during registration; fast or slow startup sequence when starting locos?
 bool registrationComplete            = false;  // registrationComplete is used during Registration mode...
@@ -497,15 +566,8 @@ trainReferenceStruct trainReference[MAX_TRAINS] = {
   {"SF PA   ",'T',   0, 'D', 'P', 100, 100, 350, 1, 250, 4, 1000, 15, 20, 0, 1,  0,   0, 3,  0,   0, 5,   0,   0, 7,}
 };
 
-// TRAIN DECELERATION STRUCTURE Rev: 1/17/17.
-struct trainDecelerationStruct {
-  byte trainNum;                  // 1..8 matches Train Reference; not same as Legacy ID which could be a Train or Engine of any value up to 4 digits
-  byte fromSpeed;                 // The Legacy speed 1..199 that the train enters the siding; corresponds to Slow, Med, or High speed
-  unsigned int mmPerSecond;       // Speed in mm/second that the train travels at "fromSpeed."
-  byte toSpeed;                   // The Legacy speed 1..199 that is our target "crawl" speed.  Always 20 as of 1/17/17.
-  byte momentum;                  // The Legacy momentum setting 1..8 at which the stopping distance is calculated
-  unsigned int mmDistance;        // Distance required to slow from "fromSpeed" to "toSpeed" at "momentum", not including latency.
-};
+// TRAIN DECELERATION STRUCTURE Rev: 10/19/26.
+// trainDecelerationStruct is now in the TrainStopping library, which builds the Train Stopping table below from this data.
 
 // TRAIN DECELERATION DATA Rev: 01-17-17.
 // This is a READ-ONLY table, total size around 640 bytes.  Could be stored in FRAM 3.
@@ -533,6 +595,28 @@ trainDecelerationStruct trainDeceleration[DECELERATION_RECS] = {
   {2, 100, 374, 20, 4, 1397,}
 };
 
+// SPEED CALIBRATION CURVE TABLE Rev: 10/19/26.
+// Measured by A-MAS during a speed calibration run and sent to us in a 'K' message: mm/sec = (slopeQ8 * legacySpeed / 256) + intercept.
+// Saved in our FRAM1 control block (same layout as the A-MAS FRAM1 control block.)  When a train is calibrated, its rates in the Train
+// Reference table, and its entry speeds in the Train Stopping table, come from the curve rather than from hand-measured data.
+struct trainCalibrationStruct {
+  char calibrated;                // 'Y' if this train has been calibrated; anything else means use the hand-entered data
+  unsigned int slopeQ8;           // mm/sec per Legacy speed step, times 256
+  int intercept;                  // mm/sec at Legacy speed zero (may be negative)
+};
+trainCalibrationStruct trainCalibration[MAX_TRAINS];
+
+// TRAIN STOPPING TABLE Rev: 10/19/26.
+// Built once at startup by trainStoppingInit() from the Train Deceleration data above, so that when a train trips a destination entry
+// sensor, planning the stop is just a table lookup plus one multiply (see trainStoppingDelay().)  No floating point is used.
+// There is one element for each train, for each of the three speeds it can enter a siding at (Low, Medium, High per the Train Reference
+// table), and for each momentum 1..8.  If the train's speed setting falls between two measured fromSpeeds, the speed and stopping distance
+// are interpolated linearly (8-bit fixed-point fraction.)  Elements with no usable measurements have msPerMmQ8 == 0.  See TrainStopping.h.
+// Total size is 8 trains * 3 speeds * 8 momentums * 4 bytes = 768 bytes of RAM.
+const byte MOMENTUM_LEVELS = 8;      // Legacy momentum 1..8, stored in element 0..7
+const byte SPEED_LEVELS    = 3;      // Low, Medium, High, stored in element 0..2
+trainStoppingStruct trainStopping[MAX_TRAINS][SPEED_LEVELS][MOMENTUM_LEVELS];
+
 // DESCRIPTION OF CIRCULAR BUFFERS Rev: 9/5/17.
 // We use CLOCKWISE circular buffers, and tracks HEAD, TAIL, and COUNT.
 // HEAD always points to the UNUSED cell where the next new element will be inserted (enqueued), UNLESS the queue is full,
@@ -600,9 +684,9 @@ struct delayedAction {
   unsigned long timeRipe;         // Time in millis() to execute this record (or n/a if Sensor type)
   char deviceType;                // Engine, Train, Accessory, sWitch, or Route (usually E or T, sometimes Accessory)
   byte deviceNum;              // Engine or train number, or accessory number, etc.
-  char cmdType;               // E, A, M, S, B, D, F, C, T,  or Y
+  char cmdType;               // E, A, M, S, B, D, F, C, T, H, or Y
   byte parm1;           // i.e. command parm, or 0 or 1 for Acc'y off/on
-  byte parm2;           // Possibly never used.  Maybe used for horn length, intensity?
+  byte parm2;           // Train number 1..8 for 'H' horn/whistle pattern records; otherwise possibly never used.
 };
 delayedAction actionElement = { 'E',0,0,0,'E',0,' ',0,0 };  // Use this to hold individual elements when retrieved
 
@@ -619,6 +703,20 @@ delayedAction actionElement = { 'E',0,0,0,'E',0,' ',0,0 };  // Use this to hold
 // Thus there is no "initialize delayed action table" function needed, just reset this variable to zero (except to populate with test data if desired.)
 unsigned int totalDelayedActionRecs = 0;    // This is first "new" record in the Delayed Action table.  Equals the number of occupied records so far.
 
+// HORN PATTERN SEQUENCER Rev: 10/19/26.
+// When an 'H' Delayed Action record ripens, the pattern is copied into the element for that train, and hornPatternProcess() expands it into
+// quilling-horn Basic commands one at a time, each time a toot needs to start, continue, or stop.  Thus the Legacy command buffer never holds
+// more than one horn command, and the timing of each toot is not thrown off by other commands waiting in the buffer.
+struct hornPatternStruct {
+  char deviceType;                // E or T, or ' ' if no pattern is being sounded for this train
+  byte deviceNum;                 // Legacy engine or train number
+  byte pattern;                   // Remaining toots, two bits each, current toot in the low-order bits
+  byte repeatsLeft;               // Number of additional intensity commands still to send to hold the current long toot
+  bool sounding;                  // True while the current toot is sounding; false while waiting between toots
+  unsigned long timeNextStep;     // millis() at which to send the next command for this pattern
+};
+hornPatternStruct hornPattern[MAX_TRAINS];  // hornPattern[0..MAX_TRAINS - 1]; thus, trainNum 1..MAX_TRAINS is always 1 more than the index.
+
 // *****************************************************************************************
 // **************************************  S E T U P  **************************************
 // *****************************************************************************************
@@ -647,7 +745,9 @@ void setup() {
   Serial.println(lcdString);
   for (byte i = 0; i < MAX_TRAINS; i++) {
     trainProgressInit(i + 1);  // First train is Train #1 (not zero) because functions accept actual train numbers, not zero-offset numbers.
+    hornPattern[i].deviceType = ' ';  // No horn/whistle pattern being sounded
   }
+  trainStoppingInit();                  // Build the stopping-distance lookup table from the Train Deceleration data
 
   #ifdef TEST_DATA
     populateDelayedActionTable();       // For test mode only, put some test data in the Delayed Action table.
@@ -694,6 +794,14 @@ void loop() {
       RS485UpdateModeState(&modeOld, &modeCurrent, &modeChanged, &stateOld, &stateCurrent, &stateChanged);
     }
 
+    // CHECK FOR OCCUPANCY SNAPSHOT FROM A-SNS...
+    // 10/19/26: A-MAS asks for one whenever a mode starts.  It isn't a sensor change, so it's fine in any mode, even Registration.
+    if (RS485fromSNStoMAS_SnapshotMessage()) {
+      for (byte i = 0; i < sizeof(sensorStatus); i++) {   // 0..63 for sensors 1..64
+        sensorStatus[i] = bitRead(RS485MsgIncoming[4 + (i / 8)], (i % 8));
+      }
+    }
+
     // ****************************************************************
     // ********** CODE ASSOCIATED WITH MANUAL / P.O.V. MODES **********
     // ****************************************************************
@@ -753,6 +861,39 @@ void loop() {
       slowStartup = RS485GetSlowStartup();  //  Returns slowStartup = true or false
     }
 
+    // CHECK FOR SPEED CALIBRATION COMMANDS FROM A-MAS.
+    // These will only occur during an Auto mode calibration run.  A-MAS does the timing; we just set the speed, and save the resulting curve.
+    if (RS485fromMAStoLEG_CalibrationSpeedMessage()) {
+      byte tTrain = RS485MsgIncoming[4];
+      actionElement.status = 'T';           // Time-type (versus Sensor-type or Expired record)
+      actionElement.sensorNum = 0;
+      actionElement.sensorTripType = 0;
+      actionElement.timeRipe = millis();    // Execute asap
+      actionElement.deviceType = trainReference[tTrain - 1].engOrTrain;
+      actionElement.deviceNum = trainReference[tTrain - 1].legacyID;
+      actionElement.cmdType = 'M';          // Momentum
+      actionElement.parm1 = MOMENTUM_CHANGING;
+      actionElement.parm2 = 0;
+      writeActionElement();                 // Add this record to the Delayed Action table
+      actionElement.timeRipe = millis() + 100;
+      actionElement.cmdType = 'A';          // Absolute speed
+      actionElement.parm1 = RS485MsgIncoming[5];
+      writeActionElement();                 // Add this record to the Delayed Action table
+    }
+    if (RS485fromMAStoLEG_CalibrationCurveMessage()) {
+      byte tTrain = RS485MsgIncoming[4];
+      trainCalibration[tTrain - 1].calibrated = 'Y';
+      trainCalibration[tTrain - 1].slopeQ8 = word(RS485MsgIncoming[6], RS485MsgIncoming[5]);
+      trainCalibration[tTrain - 1].intercept = (int)word(RS485MsgIncoming[8], RS485MsgIncoming[7]);
+      memcpy(FRAM1ControlBuf + FRAM1_CALIBRATION_OFFSET, &trainCalibration, sizeof(trainCalibration));
+      FRAM1.writeControlBlock(FRAM1ControlBuf);
+      trainCalibrationApply(tTrain);
+      trainStoppingInit();                  // Rebuild the stopping table using the new curve
+      sprintf(lcdString, "Train %2i calibrated.", tTrain);
+      sendToLCD(lcdString);
+      Serial.println(lcdString);
+    }
+
     // If the RS485 message is a "New Train Registered" message from A-OCC (via operator), then register and startup the train.
     // This should only occur when we are in Registration mode, so no need to check.
     if (RS485fromOCCtoMAS_RegistrationMessage()) {  // This confirms it's an OCC "train registration" message, though could be real or "done" type.
@@ -886,9 +1027,18 @@ void loop() {
                       sprintf(lcdString, "Prep stop loco %2d", sensorTrain);
                       sendToLCD(lcdString);
                       Serial.print(lcdString);
-                      // For the initial version 3/1/17, let's keep it simple without a bunch of calculations, and just set momentum to medium, wait a few seconds,
-                      // then set absolute speed to Crawl.  Also turn on the bell.  Also add a 'S'ensor 'T'rip record for Stop Immed on tripping dest. exit sensor.
-                      // IN THE FUTURE, we need to add a lot of code to calculate delay and slow-down parameters based on deceleration data
+                      // 10/19/26: Look up how long to wait before slowing, using the highest momentum that still lets the train reach crawl speed before the
+                      // exit sensor.  If we have no deceleration data for this train/speed, fall back to slowing immediately at medium momentum.
+                      // Also turn on the bell.  Also add a 'S'ensor 'T'rip record for Stop Immed on tripping dest. exit sensor.
+                      byte tDestBlock = trainProgress[tTrain][tPointer].blockNum;
+                      byte tMomentum = MOMENTUM_CHANGING;
+                      unsigned long tSlowDelayMS = 0;
+                      for (byte m = MOMENTUM_LEVELS; m >= 1; m--) {
+                        if (trainStoppingDelay(sensorTrain, blockReservation[tDestBlock - 1].blockSpeed, m, blockReservation[tDestBlock - 1].blockLen, &tSlowDelayMS)) {
+                          tMomentum = m;
+                          break;
+                        }
+                      }
                       actionElement.status = 'T';         // Timer record
                       actionElement.timeRipe = millis();  // Execute asap
                       actionElement.deviceType = trainReference[sensorTrain - 1].engOrTrain;
@@ -897,15 +1047,15 @@ void loop() {
                       actionElement.parm1 = 245;
                       writeActionElement();  // Add this record to the Delayed Action table
                       actionElement.status = 'T';         // Timer record
-                      actionElement.timeRipe = millis();  // Execute asap
+                      actionElement.timeRipe = millis() + tSlowDelayMS;  // Execute when the train is far enough into the siding
                       actionElement.deviceType = trainReference[sensorTrain - 1].engOrTrain;
                       actionElement.deviceNum = trainReference[sensorTrain - 1].legacyID;
                       actionElement.cmdType = 'M';  // Momentum
-                      actionElement.parm1 = MOMENTUM_CHANGING;  //  i.e. around 3 or 4
+                      actionElement.parm1 = tMomentum;  //  Highest momentum that fits the siding, else MOMENTUM_CHANGING
                       writeActionElement();  // Add this record to the Delayed Action table
                       byte tLegacySpeed = trainReference[sensorTrain - 1].crawlSpeed;
                       actionElement.status = 'T';         // Timer record
-                      actionElement.timeRipe = millis() + 100;  // Execute asap
+                      actionElement.timeRipe = millis() + tSlowDelayMS + 100;  // Execute right after the momentum command
                       actionElement.deviceType = trainReference[sensorTrain - 1].engOrTrain;
                       actionElement.deviceNum = trainReference[sensorTrain - 1].legacyID;
                       actionElement.cmdType = 'A';  // Absolute speed
@@ -1170,12 +1320,27 @@ void loop() {
 // One to try to retrieve a record, and another to execute.  And maybe each of those needs to go in its own function.
 
 
+  // 10/19/26: Read the table as a single FRAM2 stream rather than sending the opcode and address again for every record.
+  // The stream must be closed before we can write a record back, and is always closed after the loop.
+  if (totalDelayedActionRecs > 0) {
+    if (FRAM2.beginRead(FRAM2_ACTION_START, (unsigned long)totalDelayedActionRecs * FRAM2_ACTION_LEN) != ferroOK) {
+      sprintf(lcdString, "%.20s", "FRAM2 read error!");
+      sendToLCD(lcdString);
+      Serial.println(lcdString);
+      endWithFlashingLED(6);
+    }
+  }
   for (unsigned int delayedActionRec = 0; delayedActionRec < totalDelayedActionRecs; delayedActionRec++) {  // Using offset 0 for ease of calcs
 
     // FRAM addresses must be UNSIGNED LONG
     unsigned long FRAM2Address = FRAM2_ACTION_START + (delayedActionRec * FRAM2_ACTION_LEN);
     byte b[FRAM2_ACTION_LEN];  // create a byte array to hold one Delayed Action record
-    FRAM2.read(FRAM2Address, FRAM2_ACTION_LEN, b);  // (address, number_of_bytes_to_read, data
+    if (FRAM2.streamRead(FRAM2_ACTION_LEN, b) != ferroOK) {  // Next record from the stream
+      sprintf(lcdString, "%.20s", "FRAM2 read error!");
+      sendToLCD(lcdString);
+      Serial.println(lcdString);
+      endWithFlashingLED(6);
+    }
     memcpy(&actionElement, b, FRAM2_ACTION_LEN);
 
     // Now actionElement has been populated with the record just read.
@@ -1203,12 +1368,14 @@ void loop() {
       // Write back the record as "Expired" since we're going to process it now.
       actionElement.status = 'E';    // Set new status of this record to Expired and update the record in FRAM2
       memcpy(b, &actionElement, FRAM2_ACTION_LEN);
+      FRAM2.endStream();   // Close the read stream before writing
       FRAM2.write(FRAM2Address, FRAM2_ACTION_LEN, b);  // (address, number_of_bytes_to_write, data
 
       actionRecFound = true;   // Tells the code following this "for" loop to process actionElement.
       break;                      // Bail out of this "for" loop and process the valid element
     }
   }   // End of for...try to find the first applicable record in the Delayed Action table loop
+  FRAM2.endStream();   // Harmless if already closed above
 
   // If we have a valid record to process in actionElement, then actionRecFound will be "true"
 
@@ -1256,6 +1423,7 @@ void loop() {
     //   F = Railsounds Effect(9 - byte Legacy extended command)
     //   C = Effect Control(9 - byte Legacy extended command)
     //   T = TMCC command
+    //   H = Horn/whistle pattern (parm1 = pattern, parm2 = train number 1..8.)  Expanded into quilling-horn commands by hornPatternProcess().
     //   Y = Accessory command (parm will be 0=off, 1=on).  On-board relay throw; not Legacy/TMCC.
     //   W = sWitch (UNUSED in any foreseeable version)
     //   R = Route (UNUSED in any foreseeable version)
@@ -1436,6 +1604,12 @@ void loop() {
         }
         legacyCmdBufTransmit();  // attempt immediate execution
         break;
+      case 'H':  // Horn/whistle pattern.  Don't put anything in the Legacy buffer yet; hornPatternProcess() sends each toot when it's due.
+        sprintf(lcdString, "%c %i HORN %02X", actionElement.deviceType, actionElement.deviceNum, actionElement.parm1);
+        sendToLCD(lcdString);
+        Serial.println(lcdString);
+        hornPatternStart(actionElement.parm2, actionElement.deviceType, actionElement.deviceNum, actionElement.parm1);
+        break;
       case 'Y':  // Accessory on or off, needs special handling -- open or close a relay, not a Legacy/TMCC command.
 
 
@@ -1453,6 +1627,7 @@ void loop() {
   // be able to be executed until LEGACY_MIN_INTERVAL has passed.  Also the 3-byte extended commands require basically
   // three times through this loop() in order for all three sets of 3 bytes to be sent to Legacy.
   // Not to mention LEGACY_REPEATS will double or triple the number of commands in the buffer, and we can only do 3 at a time.
+  hornPatternProcess();    // Add the next horn/whistle command to the Legacy buffer, if any pattern has a toot to start or stop.
   legacyCmdBufTransmit();  // Send 3 bytes to Legacy, if available in buffer.
 
 }   // end of loop()
@@ -1509,7 +1684,7 @@ void initializeShiftRegisterPins() {
 
 void populateDelayedActionTable() {
   // Rev 01-16-17.  Populate Delayed Action table with some test data.  This is ONLY CALLED when running in test mode, can delete any time.
-  const unsigned int delayedActionTestRecs = 50;   // Just a guess at how many records we might need in all, probably will need 400 or so eventually
+  const unsigned int delayedActionTestRecs = 34;   // Just a guess at how many records we might need in all, probably will need 400 or so eventually
   // Create an array of Delayed Action records for test data...
   delayedAction actionArray[delayedActionTestRecs] = {
     // Sensor/Timer/Expired, Sensor_Num, 0=Clear/1=Trip, Time_Ripe, Eng/Train/Accy/Switch/Route, Device_Num, Cmd_Type, Parm_1, Parm_2
@@ -1534,24 +1709,11 @@ void populateDelayedActionTable() {
     // how quickly I can do short blows, etc.
     // IMPORTANT: Rather than using the generic "Blow Horn 1" basic command 28, we will be using the "Quilling Horn Intensity" basic command
     // 224 + [0..25].  224 is "horn/whistle off" and 225 thru 239 is maximum intensity.  Can ramp up in intensity on long blows.
-    { 'T',0,0,41000,'E',14,'B',225,0 },   // Blow horn
-    { 'T',0,0,41250,'E',14,'B',228,0 },   // Continuous blows must be not more than 300ms apart, at least on F-unit
-    { 'T',0,0,41500,'E',14,'B',231,0 },   // If they are 350ms apart, they become separate short toots on F-unit
-    { 'T',0,0,41750,'E',14,'B',234,0 },   // 250ms is still continuous with the 1484 steam loco
-    { 'T',0,0,42000,'E',14,'B',237,0 },
-    { 'T',0,0,42250,'E',14,'B',239,0 },
-    { 'T',0,0,42500,'E',14,'B',239,0 },
-    { 'T',0,0,42750,'E',14,'B',239,0 },
-    { 'T',0,0,44100,'E',14,'B',225,0 },   // Short horn bursts must be 350ms apart to guarantee non continuous (at least on F-unit)
-    { 'T',0,0,44200,'E',14,'B',224,0 },   // Putting a 224 (Quilling Horn 0) seems to stop the horn.  250ms toot plus 200ms pause works great on steam 1484.
-                                            // 250ms plus 200ms pause works on Big Boy, but is kind of thumpy, not enough delay.
-    { 'T',0,0,44550,'E',14,'B',225,0 },   // If they are 300ms apart, they become continuous on F-unit
-    { 'T',0,0,44650,'E',14,'B',224,0 },   // 225 is kind of a quiet horn, 239 is crazy loud, 230 is good on both steam and diesel
-    { 'T',0,0,45000,'E',14,'B',225,0 },   // 350 on steam is still continuous -- and louder than the above continuous for some reason
-    { 'T',0,0,45100,'E',14,'B',224,0 },
-    { 'T',0,0,45450,'E',14,'B',225,0 },   // 400ms on steam is partly separate, partly continuous
-    { 'T',0,0,44550,'E',14,'B',224,0 },
-    { 'T',0,0,45900,'E',14,'B',239,0 },   // 450ms on steam is goofy -- alternating from low and high volume whistle
+    // Continuous blows must be not more than 300ms apart, at least on F-unit; if 350ms apart they become separate short toots.
+    // Short horn bursts must be 350ms apart to guarantee non continuous (at least on F-unit.)  Putting a 224 (Quilling Horn 0) stops the horn.
+    // 225 is kind of a quiet horn, 239 is crazy loud, 230 is good on both steam and diesel.
+    // 10/19/26: The whole signal is now one 'H' pattern record; toot timing and intensity come from the Train Reference table (train 2 = Big Boy.)
+    { 'T',0,0,41000,'E',14,'H',HORN_GRADE_CROSSING,2 },   // = = o = Approaching grade crossing
     { 'T',0,0,43000,'E',14,'B',160,0 },  // RPMs all the way down
     { 'T',0,0,43500,'E',14,'A',0,0 },    // Abs speed zero
     { 'T',0,0,51000,'E',14,'B',253,0 },
@@ -1591,16 +1753,89 @@ void populateDelayedActionTable() {
   return;
 }
 
+void trainCalibrationApply(const byte tTrainNum) {
+  // Rev: 10/19/26.  If train tTrainNum has been calibrated, replace its hand-entered mm/sec rates in the Train Reference table with rates from the curve.
+  if (trainCalibration[tTrainNum - 1].calibrated != 'Y') return;
+  trainReference[tTrainNum - 1].crawlRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].crawlSpeed);
+  trainReference[tTrainNum - 1].lowRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].lowSpeed);
+  trainReference[tTrainNum - 1].mediumRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].mediumSpeed);
+  trainReference[tTrainNum - 1].highRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].highSpeed);
+  return;
+}
+
+unsigned int trainCalibrationRate(const byte tTrainNum, const byte tLegacySpeed) {
+  // Rev: 10/19/26.  Returns mm/sec at Legacy speed tLegacySpeed, per train tTrainNum's calibration curve.  Never less than zero.
+  long tRate = (((long)trainCalibration[tTrainNum - 1].slopeQ8 * tLegacySpeed) >> 8) + trainCalibration[tTrainNum - 1].intercept;
+  if (tRate < 0) tRate = 0;
+  return tRate;
+}
+
+void trainStoppingInit() {
+  // Rev: 10/19/26.  Populate the trainStopping[][][] lookup table from trainDeceleration[], for each train's Low/Medium/High Legacy speed
+  // and each momentum.  TrainStopping::build() does the interpolation; a calibrated train's curve supplies its entry speeds.
+  for (byte tTrain = 0; tTrain < MAX_TRAINS; tTrain++) {
+    for (byte tLevel = 0; tLevel < SPEED_LEVELS; tLevel++) {
+      byte tSpeed = trainReference[tTrain].lowSpeed;
+      if (tLevel == 1) tSpeed = trainReference[tTrain].mediumSpeed;
+      if (tLevel == 2) tSpeed = trainReference[tTrain].highSpeed;
+      long tCalibratedRate = -1;
+      if (trainCalibration[tTrain].calibrated == 'Y') {   // Measured speed beats interpolated speed
+        tCalibratedRate = trainCalibrationRate(tTrain + 1, tSpeed);
+      }
+      for (byte tMomentum = 1; tMomentum <= MOMENTUM_LEVELS; tMomentum++) {
+        trainStopping[tTrain][tLevel][tMomentum - 1] = TrainStopping::build(tTrain + 1, tSpeed, tMomentum, trainDeceleration,
+                                                                            DECELERATION_RECS, tCalibratedRate, LEGACY_LATENCY_MS);
+      }
+    }
+  }
+  return;
+}
+
+bool trainStoppingDelay(const byte tTrainNum, const char tBlockSpeed, const byte tMomentum, const unsigned int tBlockLen, unsigned long * tDelayMS) {
+  // Rev: 10/19/26.  Called when train tTrainNum (1..8) trips the entry sensor of its destination siding, which it entered at tBlockSpeed (L/M/H.)
+  // Returns true, and sets tDelayMS to the number of ms to wait before setting momentum tMomentum (1..8) and crawl speed, so that the train reaches
+  // crawl speed just as it arrives at the exit sensor of a tBlockLen mm siding.
+  // Returns false if we have no deceleration data for this train, speed, and momentum, or if the train can't slow down in time at this momentum.
+  // NOTE: The only caller so far is the destination-entry logic in loop(), which is still inside the commented-out Auto/Park sensor
+  // block, so this isn't run on the layout yet.  It goes live when that block does; until then TrainStoppingTest is what checks it.
+  *tDelayMS = 0;
+  byte tLevel;
+  if (tBlockSpeed == 'L') {
+    tLevel = 0;
+  } else if (tBlockSpeed == 'M') {
+    tLevel = 1;
+  } else if (tBlockSpeed == 'H') {
+    tLevel = 2;
+  } else {
+    return false;
+  }
+  if ((tTrainNum < 1) || (tTrainNum > MAX_TRAINS) || (tMomentum < 1) || (tMomentum > MOMENTUM_LEVELS)) return false;
+  return TrainStopping::slowDelay(&trainStopping[tTrainNum - 1][tLevel][tMomentum - 1], tBlockLen, tDelayMS);
+}
+
 void writeActionElement() {             // Add a new record to the Delayed Action table.
   // Insert the record in the first Expired (available) element in Delayed Action table, or add a new record at the end.
   // totalDelayedActionRecs tracks the number of records that have been written at some point, even if expired.
   // First find an empty slot, either an expired record or a new record at the end...
+  // 10/19/26: Scan as one FRAM2 read stream; closed as soon as we find a slot (or run out of records.)
   unsigned int availableDelayedActionRec = 0;
+  if (totalDelayedActionRecs > 0) {
+    if (FRAM2.beginRead(FRAM2_ACTION_START, (unsigned long)totalDelayedActionRecs * FRAM2_ACTION_LEN) != ferroOK) {
+      sprintf(lcdString, "%.20s", "FRAM2 read error!");
+      sendToLCD(lcdString);
+      Serial.println(lcdString);
+      endWithFlashingLED(6);
+    }
+  }
   while (availableDelayedActionRec < totalDelayedActionRecs) {  // See if we have an expired record we can write to
     delayedAction tempElement;   // To read status of existing records, so we don't step on record we are supposed to write
-    unsigned long FRAM2Address = FRAM2_ACTION_START + (availableDelayedActionRec * FRAM2_ACTION_LEN);  // Address of record number to check
     byte b[FRAM2_ACTION_LEN];  // create a byte array to hold one Delayed Action record
-    FRAM2.read(FRAM2Address, FRAM2_ACTION_LEN, b);  // (address, number_of_bytes_to_read, data
+    if (FRAM2.streamRead(FRAM2_ACTION_LEN, b) != ferroOK) {  // Next record from the stream
+      sprintf(lcdString, "%.20s", "FRAM2 read error!");
+      sendToLCD(lcdString);
+      Serial.println(lcdString);
+      endWithFlashingLED(6);
+    }
     memcpy(&tempElement, b, FRAM2_ACTION_LEN);
     // Now tempElement has been populated with the record just read.
     if (tempElement.status == 'E') {            // Expired record -- great, we will write here!
@@ -1608,6 +1843,7 @@ void writeActionElement() {             // Add a new record to the Delayed Actio
     }
     availableDelayedActionRec++;
   }
+  FRAM2.endStream();   // Done reading; must be closed before the write below
   // availableDelayedActionRec will now hold the record number we need to write to.
   // If all previous records are unavailable, be sure to increment totalDelayedActionRecs
   if (availableDelayedActionRec == totalDelayedActionRecs) {     // Account for zero-offset record numbers vs. actual number of records occupied
@@ -1715,6 +1951,87 @@ void legacyCmdBufTransmit() {
   }
 }
 
+void hornPatternStart(const byte tTrainNum, const char tDeviceType, const byte tDeviceNum, const byte tPattern) {
+  // Rev: 10/19/26.  Begin sounding a horn/whistle pattern (from an 'H' Delayed Action record) for train 1..MAX_TRAINS.
+  // Nothing is sent to Legacy here; hornPatternProcess() sends the first toot the next time through loop().
+  // If this train is already sounding a pattern, the new pattern simply replaces it.
+  if ((tTrainNum < 1) || (tTrainNum > MAX_TRAINS)) {   // Bad data in the Delayed Action table
+    sprintf(lcdString, "Bad horn train %3i", tTrainNum);
+    sendToLCD(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(6);
+  }
+  hornPattern[tTrainNum - 1].deviceType = tDeviceType;
+  hornPattern[tTrainNum - 1].deviceNum = tDeviceNum;
+  hornPattern[tTrainNum - 1].pattern = tPattern;
+  hornPattern[tTrainNum - 1].repeatsLeft = 0;
+  hornPattern[tTrainNum - 1].sounding = false;
+  hornPattern[tTrainNum - 1].timeNextStep = millis();
+  return;
+}
+
+void hornPatternProcess() {
+  // Rev: 10/19/26.  If any train's horn/whistle pattern is due for its next step, put that ONE quilling-horn command in the Legacy buffer.
+  // We only add a horn command when the Legacy buffer is empty, so it will go out in the very next 25ms slot and the toot timing will be
+  // accurate.  Each toot is expanded from the Train Reference table as follows:
+  //   Short "o": 224 + shortTootIntensity, wait shortTootLen, 224 (off), wait shortTootDelay.
+  //   Long  "=": 224 + longTootIntensity every longTootLen ms, longTootRepeats times, then 224 (off), wait longTootDelay.
+  //              A train whose longTootRepeats is 0 has no long toot, so its "=" toots are skipped.
+  // Horn commands are only sent once, not LEGACY_REPEATS times, or the timing of the toots would be lost.
+  if (!legacyCmdBufIsEmpty()) return;
+  for (byte tTrain = 0; tTrain < MAX_TRAINS; tTrain++) {   // tTrain is the "real" train number - 1
+    if (hornPattern[tTrain].deviceType == ' ') continue;   // No pattern being sounded for this train
+    if ((long)(millis() - hornPattern[tTrain].timeNextStep) < 0) continue;   // Not yet time for the next step
+    byte tToot = hornPattern[tTrain].pattern & 0b11;       // The toot that is about to start, or is already sounding
+    byte tLegacyParm = QUILLING_HORN_OFF;
+    if ((hornPattern[tTrain].sounding == false) && (tToot == HORN_TOOT_END)) {   // Pattern is complete
+      hornPattern[tTrain].deviceType = ' ';
+      continue;
+    } else if ((hornPattern[tTrain].sounding == false) && (tToot == HORN_TOOT_LONG) &&
+               (trainReference[tTrain].longTootRepeats == 0)) {   // This train has no long toot, so skip it
+      hornPattern[tTrain].pattern = hornPattern[tTrain].pattern >> 2;
+      continue;
+    } else if (hornPattern[tTrain].sounding == false) {   // Start the next toot
+      hornPattern[tTrain].sounding = true;
+      if (tToot == HORN_TOOT_SHORT) {
+        tLegacyParm = QUILLING_HORN_OFF + trainReference[tTrain].shortTootIntensity;
+        hornPattern[tTrain].repeatsLeft = 0;
+        hornPattern[tTrain].timeNextStep = millis() + trainReference[tTrain].shortTootLen;
+      } else {   // HORN_TOOT_LONG
+        tLegacyParm = QUILLING_HORN_OFF + trainReference[tTrain].longTootIntensity;
+        hornPattern[tTrain].repeatsLeft = trainReference[tTrain].longTootRepeats - 1;
+        hornPattern[tTrain].timeNextStep = millis() + trainReference[tTrain].longTootLen;
+      }
+    } else if (hornPattern[tTrain].repeatsLeft > 0) {    // Hold the long toot a while longer
+      tLegacyParm = QUILLING_HORN_OFF + trainReference[tTrain].longTootIntensity;
+      hornPattern[tTrain].repeatsLeft--;
+      hornPattern[tTrain].timeNextStep = millis() + trainReference[tTrain].longTootLen;
+    } else {   // End of this toot, so turn the horn off and pause before the next toot
+      tLegacyParm = QUILLING_HORN_OFF;
+      hornPattern[tTrain].sounding = false;
+      hornPattern[tTrain].pattern = hornPattern[tTrain].pattern >> 2;
+      if (tToot == HORN_TOOT_SHORT) {
+        hornPattern[tTrain].timeNextStep = millis() + trainReference[tTrain].shortTootDelay;
+      } else {
+        hornPattern[tTrain].timeNextStep = millis() + trainReference[tTrain].longTootDelay;
+      }
+    }
+    if (hornPattern[tTrain].deviceType == 'E') {
+      legacy11 = 0xF8;
+    }
+    else {
+      legacy11 = 0xF9;
+    }
+    legacy12 = (hornPattern[tTrain].deviceNum * 2) + 1;  // Shift left one bit, fill with '1'
+    legacy13 = tLegacyParm;
+    legacyCmdBufEnqueue(legacy11);
+    legacyCmdBufEnqueue(legacy12);
+    legacyCmdBufEnqueue(legacy13);
+    return;   // Only one command per call, so the buffer never holds more than one horn command
+  }
+  return;
+}
+
 void checkIfPowerMasterOnOffPressed() {            // Check the four control panel "PowerMaster" on/off switches to turn power on or off
   if (digitalRead(PIN_PANEL_BROWN_ON) == LOW)  {   // Is the operator pressing the control panel "Brown track power on" button at this moment?
     // create actionElement to turn engine 91 absolute speed 1
@@ -1901,6 +2218,18 @@ bool RS485fromSNStoMAS_SensorMessage() {
   return false;
 }
 
+bool RS485fromSNStoMAS_SnapshotMessage() {
+  // Rev: 10/19/26.  Occupancy snapshot from A-SNS to A-MAS, with the status of every sensor.
+  if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_MAS) {
+    if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_SNS) {
+      if (RS485MsgIncoming[3] == 'O') {  // It's an occupancy snapshot from A-SNS
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool RS485fromMAStoLEG_SmokeMessage() {
   if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_LEG) {
     if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) {
@@ -1951,6 +2280,30 @@ bool RS485GetSlowStartup() {
   return s;  // slowStartup gets set true or false
 }
 
+bool RS485fromMAStoLEG_CalibrationSpeedMessage() {
+  // Rev: 10/19/26.  Returns true if this is a command from A-MAS to set a train's speed during a calibration run
+  if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_LEG) {
+    if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) {
+      if (RS485MsgIncoming[3] == 'V') {  // It's a Velocity step command
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool RS485fromMAStoLEG_CalibrationCurveMessage() {
+  // Rev: 10/19/26.  Returns true if this is a message from A-MAS with a train's newly-fitted speed calibration curve
+  if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_LEG) {
+    if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) {
+      if (RS485MsgIncoming[3] == 'K') {  // It's a calibration curve
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool RS485fromMAStoLEG_RouteMessage() {
   // Returns true if this is a command from A-MAS assigning a new route for a given train
   if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_LEG) {
@@ -2325,7 +2678,31 @@ void initializeFRAM1AndGetControlBlock() {
     }
   }
 
+  checkFRAM1Layout();  // Fatal error if the tables are not what we expect, or any record is damaged
+
   // A-MAS will also retrieve last-known-turnout and last-known-train positions from control block, but nobody else needs this.
+  // But we do want the speed calibration curve of each train, if any, which we saved here when A-MAS sent it to us.
+  memcpy(&trainCalibration, FRAM1ControlBuf + FRAM1_CALIBRATION_OFFSET, sizeof(trainCalibration));
+  for (byte i = 0; i < MAX_TRAINS; i++) {
+    trainCalibrationApply(i + 1);
+  }
+  return;
+}
+
+void checkFRAM1Layout() {
+  // Rev: 10/19/26.  Called by initializeFRAM1AndGetControlBlock() once the control block has been read.
+  // Populate_FRAM_Route_Reference stamps FRAM1 with a description of the Route, Park 1 and Park 2 tables and CRCs of their
+  // records.  FRAM1Layout.verify() checks that description matches our FRAM1_ constants (if not, FRAM1 was populated for a
+  // different layout, or before 10/19/26, and must be populated again), then reads every record and checks the CRCs, which takes
+  // a few tens of milliseconds.  If anything is wrong, lcdString says what.
+  FRAM1Layout.addTable(FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, FRAM1_ROUTE_REC_LEN, "Rte");
+  FRAM1Layout.addTable(FRAM1_PARK1_START, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN, "Pk1");
+  FRAM1Layout.addTable(FRAM1_PARK2_START, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN, "Pk2");
+  if (!FRAM1Layout.verify(FRAM1ControlBuf, "FRAM1", lcdString)) {
+    sendToLCD(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(1);
+  }
   return;
 }
 
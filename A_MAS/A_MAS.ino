@@ -6,6 +6,12 @@ const byte THIS_MODULE = ARDUINO_MAS;  // Not sure if/where I will use this - in
 // Include the following #define if we want to run the system with just the lower-level track.  Comment out to create records for both levels of track.
 #define SINGLE_LEVEL     // Comment this out for full double-level routes.  Use it for single-level route testing.
 
+// 10/19/26: The FRAM1 layout check is now FramLayout::verify(), which also works on an 8K FRAM1 with the double-level tables.
+// 10/19/26: At startup, confirm FRAM1 holds the Route and Park tables we were compiled for, and that no record is damaged.
+// 10/19/26: LCD2004.poll() is now also called in every loop that waits for a reply or a sensor, and during long delays.
+// 10/19/26: LCD text is now written by LCD2004.poll() each loop instead of inside send(), and flushed on fatal errors.
+// 10/19/26: When a mode starts, get the status of every sensor from A-SNS in one 'O' snapshot message, rather than one change at a time.
+// 10/19/26: Added speed calibration run, offered when Auto mode is started, which saves a mm/sec curve for the train in FRAM1.
 // 07/19/18: Added F() macros to all Serial.print commands with literal text strings, saving 1 byte/char of RAM.
 // 04/22/18: Updating new global const, message and LCD display classes.
 // 04/18/18: Changed line in RS485SendMessage back to original, as the bug was fixed by the vendor.
@@ -94,15 +100,35 @@ const byte THIS_MODULE = ARDUINO_MAS;  // Not sure if/where I will use this - in
 //      4  Checksum   Byte  0..255
 
 // A-SNS to A-MAS:  Sensor status update for a single sensor change
-// Rev: 08/31/17
+// Rev: 10/19/26
 // OFFSET  DESC       SIZE  CONTENTS
-//      0  Length     Byte  7
+//      0  Length     Byte  11
 //      1  To         Byte  1 (A_MAS)
 //      2  From       Byte  3 (A_SNS)
 //      3  Command    Char  'S' Sensor status update
 //      4  Sensor #   Byte  1..52 (Note that as of Sept 2017, our code ignores sensor 53 and we have disconnected it from the layout)
 //      5  Trip/Clr   Byte  [0|1] 0-Cleared, 1=Tripped
-//      6  Checksum   Byte  0..255
+//   6..9  Captured   ULong micros() on A-SNS when the change was seen, low byte first.  For speed calculations.
+//     10  Checksum   Byte  0..255
+
+// A-MAS to A-SNS:  Request for a snapshot of every sensor's status, sent when a mode starts.
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  5
+//      1  To         Byte  3 (A_SNS)
+//      2  From       Byte  1 (A_MAS)
+//      3  Command    Char  'O' Occupancy snapshot request
+//      4  Checksum   Byte  0..255
+
+// A-SNS to A-MAS:  Occupancy snapshot, the status of every sensor in one message
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  13
+//      1  To         Byte  1 (A_MAS)
+//      2  From       Byte  3 (A_SNS)
+//      3  Command    Char  'O' Occupancy snapshot
+//  4..11  Sensors    Byte  64 bits: 0=Cleared, 1=Tripped.  Sensor #1 is bit 0 of byte 4, sensor #9 is bit 0 of byte 5, etc.
+//     12  Checksum   Byte  0..255
 
 // A-MAS to A-SWT:  Command to set all turnouts to Last-known position
 // Rev: 08/31/17
@@ -222,6 +248,31 @@ const byte THIS_MODULE = ARDUINO_MAS;  // Not sure if/where I will use this - in
 //      4  Reply      Char  [F|S]
 //      5  Cksum      Byte  0..255
 
+// A-MAS to A-LEG: Set a train's speed for the next step of a speed calibration run.  Auto mode (calibration run) only.
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  7
+//      1  To         Byte  2 (A-LEG)
+//      2  From       Byte  1 (A_MAS)
+//      3  Msg Type   Char  'V' = Velocity step
+//      4  Train No.  Byte  [1..MAX_TRAINS]
+//      5  Speed      Byte  Legacy absolute speed 0..199.  Zero ends the run.
+//      6  Cksum      Byte  0..255
+
+// A-MAS to A-LEG: Fitted speed calibration curve for a train, at the end of a calibration run.  A-LEG saves it in its own FRAM1 control block.
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  10
+//      1  To         Byte  2 (A-LEG)
+//      2  From       Byte  1 (A_MAS)
+//      3  Msg Type   Char  'K' = Calibration curve
+//      4  Train No.  Byte  [1..MAX_TRAINS]
+//      5  Slope      Byte  2 bytes, low byte first: mm/sec per Legacy speed step, times 256
+//      6  Slope      Byte
+//      7  Intercept  Byte  2 bytes, low byte first, signed: mm/sec at Legacy speed zero
+//      8  Intercept  Byte
+//      9  Cksum      Byte  0..255
+
 // **************************************************************************************************************************
 
 // We will start in MODE_UNDEFINED, STATE_STOPPED.  User must press illuminated Start button to start a mode.
@@ -255,13 +306,17 @@ char occPrompt[9] = "        ";       // Stores a/n prompts sent to A-OCC, defin
 // Control buffer in each FRAM is first 128 bytes (address 0..127) reserved for any special purpose we want such as config info.
 #include "SPI.h"                                    // FRAM uses SPI communications
 #include "Hackscribble_Ferro.h"                     // FRAM library
+#include "FramLayout.h"       // Layout header and per-record CRCs of the FRAM1 tables, checked at startup
 const unsigned int FRAM_CONTROL_BUF_SIZE = 128;     // This defaults to 64 bytes in the library, but we modified it
 // FRAM1 stores the Route Reference, Park 1 Reference, and Park 2 Reference tables.
 // FRAM1 control block (first 128 bytes):
 // Address 0..2 (3 bytes)   = Version number month, date, year i.e. 07, 13, 16
 // Address 3..6 (4 bytes)   = Last known position of each turnout.  Bit 0 = Normal, 1 = Reverse.
 // Address 7..36 (30 bytes) = Last known train locations for train 1 thru 10: trainNum, blockNum, direction
+// Address 37..76 (40 bytes) = Speed calibration curve for train 1 thru 8: 'Y' if calibrated, slope (2 bytes), intercept (2 bytes)
+// Address 77..124 (48 bytes) = FramLayout header: layout version, and start/records/length/CRC address of each table
 byte               FRAM1ControlBuf[FRAM_CONTROL_BUF_SIZE];
+const byte         FRAM1_CALIBRATION_OFFSET =  37;  // Offset into the FRAM1 control block of the speed calibration curves
 unsigned int       FRAM1BufSize             =   0;  // We will retrieve this via a function call, but it better be 128!
 unsigned long      FRAM1Bottom              =   0;  // Should be 128 (address 0..127)
 unsigned long      FRAM1Top                 =   0;  // Highest address we can write to...should be 8191 (addresses are 0..8191 = 8192 bytes total)
@@ -284,6 +339,7 @@ const byte         FRAM1_PARK2_REC_LEN      =  52;  // Was 43 until 12/3/17
 const byte         FRAM1_PARK2_RECS         =   4;
 const byte         FRAM1_RECS_PER_PARK2     =   6;  // Max number of block/turnout records in a single Park 2 route in the route table.
 Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);   // Create the FRAM1 object!
+FramLayout         FRAM1Layout(&FRAM1);           // Describes the FRAM1 tables so we can check their CRCs; see checkFRAM1Layout()
 // Use the following code if we need a second FRAM memory module:
 // FRAM2 control block (first 128 bytes) contains no data - we don't need a version number because we don't have any initial data to read.
 // FRAM2 stores the Delayed Action table.  Table is 12 bytes per record, perhaps 400 records => approx. 5K bytes.
@@ -568,6 +624,23 @@ struct trainProgressStruct {
 };
 trainProgressStruct trainProgress[MAX_TRAINS];  // Create trainProgress[0..MAX_TRAINS - 1]; thus, trainNum 1..MAX_TRAINS is always 1 more than the index.
 
+// SPEED CALIBRATION CURVE TABLE Rev: 10/19/26.
+// Filled in by a calibration run (see calibrateTrainSpeed()), which times a train through every siding of known blockLen on a loop at a
+// series of Legacy speed steps, and fits a straight line through the results: mm/sec = (slopeQ8 * legacySpeed / 256) + intercept.
+// Saved in the FRAM1 control block (following the last-known train locations) and sent to A-LEG, which keeps its own copy.
+// When a train is calibrated, its crawl/low/medium/high rates in the Train Reference table are replaced by rates from the curve.
+const byte CALIBRATE_STEPS               =     6;  // Number of Legacy speed steps in a calibration run
+const byte CALIBRATE_SPEED[CALIBRATE_STEPS] = { 20, 40, 60, 80, 100, 120 };  // Legacy speed setting for each step
+const byte CALIBRATE_SAMPLES_PER_STEP    =     3;  // Number of sidings to time at each speed step
+const unsigned long CALIBRATE_SETTLE_MS  = 10000;  // Ignore transits that started before the train has had this long to reach a new speed
+const unsigned long CALIBRATE_STEP_MS    = 300000; // Give up on a speed step (i.e. train stalled) if not enough samples after 5 minutes
+struct trainCalibrationStruct {
+  char calibrated;                // 'Y' if this train has been calibrated; anything else means use the hand-entered Train Reference rates
+  unsigned int slopeQ8;           // mm/sec per Legacy speed step, times 256
+  int intercept;                  // mm/sec at Legacy speed zero (may be negative)
+};
+trainCalibrationStruct trainCalibration[MAX_TRAINS];
+
 // LAST KNOWN TURNOUT POSITION TABLE.
 // Oonly four bytes = 32 bits.  0 = Normal, 1 = Reverse.
 byte lastKnownTurnout[4];
@@ -613,7 +686,7 @@ void setup() {
   //  initializeFRAM2();
 
   // We need some delay in order to give the slaves a chance to get ready to receive data.
-  delay(1000);
+  delayAndPollLCD(1000);
 
   // Send commands to A-SWT to set every turnout to the last-known state -- so we can be sure of the actual state of every
   // turnout, without changing the existing settings any more than necessary.
@@ -626,6 +699,7 @@ void setup() {
   // byte sensorStatus[] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
   // However, note that our loop checks, and if nothing else is going on (i.e. when starting and no mode), A-MAS will allow A-SNS
   // to dump all of the occupied sensors pretty quickly.
+  // 10/19/26: A-SNS no longer dumps the occupied sensors at startup.  We ask for an 'O' snapshot whenever a mode starts instead.
 
 }
 
@@ -637,6 +711,8 @@ void loop() {
 
   checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, release relays and just stop
 
+  LCD2004.poll();  // Trickle any new LCD text out to the display; never waits.
+
   // First time into loop() we are in MODE_UNDEFINED, STATE_STOPPED, firstTimeThrough = true.  Mode, Start, and Stop LEDs are all off.
   // modeCurrent can be MODE_UNDEFINED, MODE_MANUAL, MODE_REGISTER, MODE_AUTO, MODE_PARK, or MODE_POV
   // stateCurrent can be STATE_UNDEFINED, STATE_RUNNING, STATE_STOPPING, or STATE_STOPPED
@@ -686,6 +762,8 @@ void loop() {
 
     if (firstTimeThrough) {    
       // We will also have a "first time through" block in each of the five mode blocks, and that is where we will also clear the "first-time" flag.
+      // 10/19/26: Start every mode with the status of every sensor, in one message that A-LEG and A-OCC also see.
+      sensorSnapshotGet();
       // FUTURE ENHANCEMENT: Whenever we start a new mode, as a safety precaution, align all spur turnouts to the mainline.
       // Be sure to update the turnout status array and save to FRAM1 control block.
       // There are only a few of them on the current layout, and we only do it here...so maybe just hard-code, or use a small array.
@@ -854,6 +932,7 @@ void loop() {
           // block number for every possible train), A-OCC will send a record with *only* the "last record" field set to Y; i.e. no train data.
           while (RS485GetMessage(msgIncoming) == false) {
             checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, just stop
+            LCD2004.poll();  // Keep any new LCD text trickling out while we wait
           }   // Just sit here and loop while we wait for the next RS485 incoming reply
           if (RS485fromOCCtoMAS_RegisteredTrain()) {  // If A-OCC is sending train registration information selected by the operator.
             // Anything other than an incoming "registered train" record would be a bug, but so far we aren't checking for that.
@@ -913,8 +992,31 @@ void loop() {
 
       case MODE_AUTO:
 
+        // 10/19/26: When Auto mode is first started, give the operator the option of a speed calibration run instead.  This requires that
+        // exactly one train was registered, and that the turnouts were set (i.e. in Manual mode) so it can run continuously around a loop.
+        // Like Registration, the calibration run is "blocking" and stops Auto mode when it is complete.
+        if (firstTimeThrough && (stateCurrent == STATE_RUNNING) && RS485AskOCCtoPromptCalibrate()) {
+          byte tCalibrateTrain = TRAIN_ID_NULL;
+          byte tRegisteredTrains = 0;
+          for (byte i = 0; i < MAX_TRAINS; i++) {
+            if (trainProgress[i].count > 0) {
+              tCalibrateTrain = i + 1;
+              tRegisteredTrains++;
+            }
+          }
+          if (tRegisteredTrains == 1) {
+            calibrateTrainSpeed(tCalibrateTrain);
+          } else {
+            sprintf(lcdString, "%.20s", "Calibrate 1 train!");
+            LCD2004.send(lcdString);
+            Serial.println(lcdString);
+          }
+          stateCurrent = STATE_STOPPED;
+          digitalWrite(PIN_ROTARY_LED_STOP, HIGH);   // Turn off the Stop button LED since we stopped automatically in this case
+          sendRS485ModeBroadcast(modeCurrent, stateCurrent); // Tell everyone via RS485 about our new mode/state
+        }
         if (stateCurrent == STATE_STOPPING) {    // Here is where we put code to accomplish the stop.  
-          delay(3000);  // until we get some real code to do something
+          delayAndPollLCD(3000);  // until we get some real code to do something
           stateCurrent = STATE_STOPPED;  // For now, just pretend we've done what needs doing to bring to a controlled stop
           sendRS485ModeBroadcast(modeCurrent, stateCurrent); // Tell everyone via RS485 about our new mode/state
         }
@@ -931,7 +1033,7 @@ void loop() {
       case MODE_PARK:
 
         if (stateCurrent == STATE_STOPPING) {    // Here is where we put code to accomplish the stop.  
-          delay(3000);  // until we get some real code to do something
+          delayAndPollLCD(3000);  // until we get some real code to do something
           stateCurrent = STATE_STOPPED;  // For now, just pretend we've done what needs doing to bring to a controlled stop
           sendRS485ModeBroadcast(modeCurrent, stateCurrent); // Tell everyone via RS485 about our new mode/state
         }
@@ -1191,6 +1293,7 @@ void throwTurnoutIfRequested() {
     // There is NO legitimate reason why we would get ANY RS485 message from anyone except A-BTN at this point.
     msgIncoming[RS485_TO_OFFSET] = 0;   // Anything other than ARDUINO_BTN
     do {
+      LCD2004.poll();  // Keep any new LCD text trickling out while we wait
       RS485GetMessage(msgIncoming);  // Only returns with data if it has a complete new message
     } while (msgIncoming[RS485_TO_OFFSET] != ARDUINO_MAS);
     // We should NEVER get a message that isn't to A-MAS from A-BTN, but we'll check anyway...
@@ -1282,6 +1385,7 @@ bool sensorChanged(byte * tNum, byte * tStatus) {
     // Now do nothing but wait for a response from A-SNS...
     bool forUs = false;
     do {
+      LCD2004.poll();  // Keep any new LCD text trickling out while we wait
       if (RS485GetMessage(msgIncoming)) {
         if (msgIncoming[RS485_TO_OFFSET] == ARDUINO_MAS) {
           forUs = true;
@@ -1306,6 +1410,41 @@ bool sensorChanged(byte * tNum, byte * tStatus) {
   return false;   // No, we did not get a new sensor status array
 }
 
+void sensorSnapshotGet() {
+  // Rev: 10/19/26.  Ask A-SNS for the status of all sensors and replace sensorStatus[] with it.  A-LEG and A-OCC snoop the reply.
+  // A-SNS answers an 'O' request right away, even if it is waiting for us to ask for a sensor change, and it discards any changes
+  // it had queued since they are already part of the snapshot.
+  msgOutgoing[RS485_LEN_OFFSET] = 5;
+  msgOutgoing[RS485_TO_OFFSET] = ARDUINO_SNS;
+  msgOutgoing[RS485_FROM_OFFSET] = ARDUINO_MAS;
+  msgOutgoing[3] = 'O';  // Occupancy snapshot request message
+  msgOutgoing[4] = calcChecksumCRC8(msgOutgoing, 4);
+  RS485SendMessage(msgOutgoing);
+  // Now do nothing but wait for a response from A-SNS...
+  bool forUs = false;
+  do {
+    checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, just stop
+    LCD2004.poll();  // Keep any new LCD text trickling out while we wait
+    if (RS485GetMessage(msgIncoming)) {
+      if (msgIncoming[RS485_TO_OFFSET] == ARDUINO_MAS) {
+        forUs = true;
+      }
+    }
+  } while (!forUs);
+  if ((msgIncoming[RS485_FROM_OFFSET] != ARDUINO_SNS) || (msgIncoming[3] != 'O')) {
+    sprintf(lcdString, "Unexpected A-SNS msg");
+    LCD2004.send(lcdString);
+    Serial.print(lcdString);
+    endWithFlashingLED(6);
+  }
+  for (byte i = 0; i < sizeof(sensorStatus); i++) {   // 0..63 for sensors 1..64
+    sensorStatus[i] = bitRead(msgIncoming[4 + (i / 8)], (i % 8));
+    Serial.print(sensorStatus[i]);
+  }
+  Serial.println();
+  return;
+}
+
 void checkIfRequestToStartNewMode() {
   // Let's see if the operator wants to start a mode...we don't need to return anything to the calling main loop().
   // Only called when we are in STOPPED state.  We wont do anything but wait for operator to Start a new valid state (and check emergency stop.)
@@ -1405,6 +1544,112 @@ void FRAM1UpdateLastKnown(const byte t, const byte b, const char d) {
   return;
 }
 
+void calibrateTrainSpeed(const byte tTrainNum) {
+  // Rev: 10/19/26.  Speed calibration run for train tTrainNum, which must be the only registered train, on a loop of track that it can circle
+  // continuously.  For each speed in CALIBRATE_SPEED[], have A-LEG set the train to that speed, then time the train from the entry sensor to
+  // the exit sensor of each block that has a known blockLen.  Since only one train is moving, every sensor trip belongs to it, and we don't
+  // need to know which direction it is moving: the transit time is the time between the two end sensors of a block being tripped.
+  // When done, stop the train, fit a straight line through the average speed at each step, save it to FRAM1, and send it to A-LEG.
+  // Be sure to check for the Halt pin, since we stay in this function until the run is complete.
+  sprintf(lcdString, "Calibrate train %2i", tTrainNum);
+  LCD2004.send(lcdString);
+  Serial.println(lcdString);
+  unsigned long sensorTripMS[TOTAL_SENSORS];   // millis() that each sensor was last tripped, or 0 if not during this speed step
+  long tSumX = 0;      // Sums of Legacy speed (X) and mm/sec (Y) for the least-squares fit
+  long tSumY = 0;
+  long tSumXY = 0;
+  long tSumXX = 0;
+  byte tPoints = 0;
+  for (byte tStep = 0; tStep < CALIBRATE_STEPS; tStep++) {
+    RS485TellLEGCalibrationSpeed(tTrainNum, CALIBRATE_SPEED[tStep]);
+    unsigned long tStepStartMS = millis();
+    for (byte i = 0; i < TOTAL_SENSORS; i++) {
+      sensorTripMS[i] = 0;
+    }
+    byte tSamples = 0;
+    unsigned long tSumRate = 0;
+    while ((tSamples < CALIBRATE_SAMPLES_PER_STEP) && ((millis() - tStepStartMS) < CALIBRATE_STEP_MS)) {
+      checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, just stop
+      LCD2004.poll();  // Keep any new LCD text trickling out while we wait
+      if (sensorChanged(&sensorUpdate.sensorNum, &sensorUpdate.changeType)) {
+        sensorStatus[sensorUpdate.sensorNum - 1] = sensorUpdate.changeType;
+        if (sensorUpdate.changeType == 1) {   // Only trips are timed; when a sensor clears depends on the train's length
+          unsigned long tNowMS = millis();
+          byte tBlock = sensorBlock[sensorUpdate.sensorNum - 1].whichBlock;
+          byte tOtherSensor = blockReservation[tBlock - 1].eEntrywExitSensor;
+          if (tOtherSensor == sensorUpdate.sensorNum) {
+            tOtherSensor = blockReservation[tBlock - 1].wEntryeExitSensor;
+          }
+          // If the other end of this block was tripped after the train settled at this speed, the train just ran the length of the block.
+          if ((blockReservation[tBlock - 1].blockLen > 0) && (sensorTripMS[tOtherSensor - 1] > (tStepStartMS + CALIBRATE_SETTLE_MS))) {
+            unsigned long tTransitMS = tNowMS - sensorTripMS[tOtherSensor - 1];
+            unsigned long tRate = ((unsigned long)blockReservation[tBlock - 1].blockLen * 1000) / tTransitMS;   // mm/sec
+            sprintf(lcdString, "Spd %3i Blk %2i %4lu", CALIBRATE_SPEED[tStep], tBlock, tRate);
+            LCD2004.send(lcdString);
+            Serial.println(lcdString);
+            tSumRate = tSumRate + tRate;
+            tSamples++;
+          }
+          sensorTripMS[sensorUpdate.sensorNum - 1] = tNowMS;
+        }
+      }
+    }
+    if (tSamples > 0) {   // Use the average rate at this step as one point on the curve
+      long tRate = tSumRate / tSamples;
+      tSumX = tSumX + CALIBRATE_SPEED[tStep];
+      tSumY = tSumY + tRate;
+      tSumXY = tSumXY + (CALIBRATE_SPEED[tStep] * tRate);
+      tSumXX = tSumXX + ((long)CALIBRATE_SPEED[tStep] * CALIBRATE_SPEED[tStep]);
+      tPoints++;
+    }
+  }
+  RS485TellLEGCalibrationSpeed(tTrainNum, 0);   // Stop the train
+  // Least-squares fit: slope = (n * SumXY - SumX * SumY) / (n * SumXX - SumX * SumX), intercept = (SumY - slope * SumX) / n.
+  // The slope is kept as a fixed-point value times 256.  Scale the quotient and remainder separately so the numerator can't overflow a long.
+  long tDenominator = (tPoints * tSumXX) - (tSumX * tSumX);
+  if ((tPoints < 2) || (tDenominator == 0)) {
+    sprintf(lcdString, "%.20s", "Calibration failed.");
+    LCD2004.send(lcdString);
+    Serial.println(lcdString);
+    return;
+  }
+  long tNumerator = (tPoints * tSumXY) - (tSumX * tSumY);
+  long tSlopeQ8 = ((tNumerator / tDenominator) * 256) + (((tNumerator % tDenominator) * 256) / tDenominator);
+  if (tSlopeQ8 <= 0) {   // Faster Legacy speed can't mean a slower train
+    sprintf(lcdString, "%.20s", "Calibration failed.");
+    LCD2004.send(lcdString);
+    Serial.println(lcdString);
+    return;
+  }
+  trainCalibration[tTrainNum - 1].calibrated = 'Y';
+  trainCalibration[tTrainNum - 1].slopeQ8 = tSlopeQ8;
+  trainCalibration[tTrainNum - 1].intercept = ((tSumY * 256) - (tSlopeQ8 * tSumX)) / (tPoints * 256L);
+  sprintf(lcdString, "Slope %5u Int %4i", trainCalibration[tTrainNum - 1].slopeQ8, trainCalibration[tTrainNum - 1].intercept);
+  LCD2004.send(lcdString);
+  Serial.println(lcdString);
+  updateFRAM1ControlBlock();              // Save the new curve in FRAM1
+  trainCalibrationApply(tTrainNum);       // And use it from now on
+  RS485TellLEGCalibrationCurve(tTrainNum);
+  return;
+}
+
+void trainCalibrationApply(const byte tTrainNum) {
+  // Rev: 10/19/26.  If train tTrainNum has been calibrated, replace its hand-entered mm/sec rates in the Train Reference table with rates from the curve.
+  if (trainCalibration[tTrainNum - 1].calibrated != 'Y') return;
+  trainReference[tTrainNum - 1].crawlRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].crawlSpeed);
+  trainReference[tTrainNum - 1].lowRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].lowSpeed);
+  trainReference[tTrainNum - 1].mediumRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].mediumSpeed);
+  trainReference[tTrainNum - 1].highRate = trainCalibrationRate(tTrainNum, trainReference[tTrainNum - 1].highSpeed);
+  return;
+}
+
+unsigned int trainCalibrationRate(const byte tTrainNum, const byte tLegacySpeed) {
+  // Rev: 10/19/26.  Returns mm/sec at Legacy speed tLegacySpeed, per train tTrainNum's calibration curve.  Never less than zero.
+  long tRate = (((long)trainCalibration[tTrainNum - 1].slopeQ8 * tLegacySpeed) >> 8) + trainCalibration[tTrainNum - 1].intercept;
+  if (tRate < 0) tRate = 0;
+  return tRate;
+}
+
 // **************************************************************
 // ********************** RS485 FUNCTIONS ***********************
 // **************************************************************
@@ -1465,7 +1710,9 @@ bool RS485AskOCCtoPromptForSmoke() {
   msgOutgoing[13] = calcChecksumCRC8(msgOutgoing, 13); 
   RS485SendMessage(msgOutgoing);  
   // Now wait until A-OCC sends us a reply of 0 or 1 (No or Yes per the above two smoke prompts)
-  while (RS485GetMessage(msgIncoming) == false) {  }   // Wait for the expected RS485 incoming reply
+  while (RS485GetMessage(msgIncoming) == false) {   // Wait for the expected RS485 incoming reply
+    LCD2004.poll();  // Keep any new LCD text trickling out while we wait
+  }
   if (!RS485fromOCCtoMAS_Reply()) {  // If *not* A-OCC is replying to a question sent by A-MAS such as Smoke Y/N, etc.
     sprintf(lcdString, "%.20s", "Smoke fatal error!");
     LCD2004.send(lcdString);
@@ -1516,7 +1763,9 @@ bool RS485AskOCCtoPromptStartupSpeed() {
   msgOutgoing[13] = calcChecksumCRC8(msgOutgoing, 13); 
   RS485SendMessage(msgOutgoing);  
   // Now wait until A-OCC sends us a reply of 0 or 1 (Fast or SLow per the above two startup prompts)
-  while (RS485GetMessage(msgIncoming) == false) {  }   // Wait for the expected RS485 incoming reply
+  while (RS485GetMessage(msgIncoming) == false) {   // Wait for the expected RS485 incoming reply
+    LCD2004.poll();  // Keep any new LCD text trickling out while we wait
+  }
   if (!RS485fromOCCtoMAS_Reply()) {  // If *not* A-OCC is replying to a question sent by A-MAS such as Smoke Y/N, etc.
     sprintf(lcdString, "%.20s", "Startup fatal error!");
     LCD2004.send(lcdString);
@@ -1569,7 +1818,9 @@ bool RS485AskOCCtoPromptAnnouncements() {
   msgOutgoing[13] = calcChecksumCRC8(msgOutgoing, 13); 
   RS485SendMessage(msgOutgoing);  
   // Now wait until A-OCC sends us a reply of 0 or 1 (Use the PA Audio announcement system, or not.)
-  while (RS485GetMessage(msgIncoming) == false) {  }   // Wait for the expected RS485 incoming reply
+  while (RS485GetMessage(msgIncoming) == false) {   // Wait for the expected RS485 incoming reply
+    LCD2004.poll();  // Keep any new LCD text trickling out while we wait
+  }
   if (!RS485fromOCCtoMAS_Reply()) {  // If *not* A-OCC is replying to a question sent by A-MAS such as Smoke Y/N, etc.
     sprintf(lcdString, "%.20s", "Startup fatal error!");
     LCD2004.send(lcdString);
@@ -1585,6 +1836,67 @@ bool RS485AskOCCtoPromptAnnouncements() {
   }
 }
 
+bool RS485AskOCCtoPromptCalibrate() {
+  // Rev: 10/19/26.  Ask operator, via A-OCC, if this Auto mode session should be a speed calibration run.  Returns true if so.
+  Serial.println(F("Sending RS485 to A-OCC to prompt for Auto or Calibrate..."));
+  msgOutgoing[RS485_LEN_OFFSET] = 14;   // Byte 0 is length of message
+  msgOutgoing[RS485_TO_OFFSET] = ARDUINO_OCC;  // Byte 1 is always A-OCC.
+  msgOutgoing[RS485_FROM_OFFSET] = ARDUINO_MAS;  // Byte 2 is always A-MAS.
+  msgOutgoing[3] = 'Q';   // Byte 3 = Q for Query
+  sprintf(occPrompt,"AUTO RUN");  // First of two prompts
+  memcpy(msgOutgoing + 4, occPrompt, 8);
+  msgOutgoing[12] = 'N';   // Last record?
+  msgOutgoing[13] = calcChecksumCRC8(msgOutgoing, 13); 
+  RS485SendMessage(msgOutgoing);  
+  delay(50);   // Brief delay so we don't fill A-OCC incoming serial buffer too quickly
+  sprintf(occPrompt,"CALIBRAT");  // Second of two prompts
+  memcpy(msgOutgoing + 4, occPrompt, 8);
+  msgOutgoing[12] = 'Y';   // Last record?
+  msgOutgoing[13] = calcChecksumCRC8(msgOutgoing, 13); 
+  RS485SendMessage(msgOutgoing);  
+  // Now wait until A-OCC sends us a reply of 0 or 1 (Auto run or Calibrate per the above two prompts)
+  while (RS485GetMessage(msgIncoming) == false) {
+    checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, just stop
+    LCD2004.poll();  // Keep any new LCD text trickling out while we wait
+  }
+  if (!RS485fromOCCtoMAS_Reply()) {  // If *not* A-OCC is replying to a question sent by A-MAS
+    sprintf(lcdString, "%.20s", "Calibrate fatal err!");
+    LCD2004.send(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(3);
+  }
+  return (msgIncoming[4] != 0);   // 0 means regular Auto mode, 1 means calibration run
+}
+
+void RS485TellLEGCalibrationSpeed(const byte tTrainNum, const byte tLegacySpeed) {
+  // Rev: 10/19/26.  Tell A-LEG to set train tTrainNum to Legacy speed tLegacySpeed, for the next step of a calibration run.
+  msgOutgoing[RS485_LEN_OFFSET] = 7;   // Byte 0 is length of message
+  msgOutgoing[RS485_TO_OFFSET] = ARDUINO_LEG;  // Byte 1 is "to"
+  msgOutgoing[RS485_FROM_OFFSET] = ARDUINO_MAS;  // Byte 2 is "from"
+  msgOutgoing[3] = 'V';   // Byte 3 = V for Velocity step
+  msgOutgoing[4] = tTrainNum;
+  msgOutgoing[5] = tLegacySpeed;
+  msgOutgoing[6] = calcChecksumCRC8(msgOutgoing, 6); 
+  RS485SendMessage(msgOutgoing);
+  return;
+}
+
+void RS485TellLEGCalibrationCurve(const byte tTrainNum) {
+  // Rev: 10/19/26.  Send A-LEG the newly-fitted calibration curve for train tTrainNum, to save in its own FRAM1.
+  msgOutgoing[RS485_LEN_OFFSET] = 10;   // Byte 0 is length of message
+  msgOutgoing[RS485_TO_OFFSET] = ARDUINO_LEG;  // Byte 1 is "to"
+  msgOutgoing[RS485_FROM_OFFSET] = ARDUINO_MAS;  // Byte 2 is "from"
+  msgOutgoing[3] = 'K';   // Byte 3 = K for calibration curve
+  msgOutgoing[4] = tTrainNum;
+  msgOutgoing[5] = lowByte(trainCalibration[tTrainNum - 1].slopeQ8);
+  msgOutgoing[6] = highByte(trainCalibration[tTrainNum - 1].slopeQ8);
+  msgOutgoing[7] = lowByte(trainCalibration[tTrainNum - 1].intercept);
+  msgOutgoing[8] = highByte(trainCalibration[tTrainNum - 1].intercept);
+  msgOutgoing[9] = calcChecksumCRC8(msgOutgoing, 9); 
+  RS485SendMessage(msgOutgoing);
+  return;
+}
+
 // 9/30/17: THIS FUNCTION SHOULD PROBABLY PASS NOTHING AND RETURN A 5-BYTE STRUCT (Train, Block, Dir, Entry, Exit)
 void RS485fromOCCtoMAS_ExtractData(byte * t, byte * b, char * d, byte * n, byte * x) {
   // Returns train number, block number, direction, entry sensor, and exit sensor, using data in msgIncoming.
@@ -1936,6 +2248,8 @@ void initializeFRAM1AndGetControlBlock() {
     }
   }
 
+  checkFRAM1Layout();  // Fatal error if the tables are not what we expect, or any record is damaged
+
   // A-MAS will also retrieve last-known-turnout and last-known-train positions from control block, but nobody else needs this.
   // We need to put turnouts in a known starting state, so get last known orientation of each turnout from previous operating session
   for (byte i = 0; i < 4; i++) {
@@ -1950,6 +2264,12 @@ void initializeFRAM1AndGetControlBlock() {
     lastTrainLoc[i].whichDirection = FRAM1ControlBuf[j + 2];  // E|W
   }
 
+  // Now get the speed calibration curve of each train, if any, and apply it to the Train Reference table.
+  memcpy(&trainCalibration, FRAM1ControlBuf + FRAM1_CALIBRATION_OFFSET, sizeof(trainCalibration));
+  for (byte i = 0; i < MAX_TRAINS; i++) {
+    trainCalibrationApply(i + 1);
+  }
+
   Serial.println(F("Here are the last-known train numbers, blocks, and directions retrieved from control block:"));
   for (byte i = 0; i < MAX_TRAINS; i++) {
     Serial.print(lastTrainLoc[i].trainNum); Serial.print(F(", "));
@@ -1959,15 +2279,34 @@ void initializeFRAM1AndGetControlBlock() {
   return;
 }
 
+void checkFRAM1Layout() {
+  // Rev: 10/19/26.  Called by initializeFRAM1AndGetControlBlock() once the control block has been read.
+  // Populate_FRAM_Route_Reference stamps FRAM1 with a description of the Route, Park 1 and Park 2 tables and CRCs of their
+  // records.  FRAM1Layout.verify() checks that description matches our FRAM1_ constants (if not, FRAM1 was populated for a
+  // different layout, or before 10/19/26, and must be populated again), then reads every record and checks the CRCs, which takes
+  // a few tens of milliseconds.  If anything is wrong, lcdString says what.
+  FRAM1Layout.addTable(FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, FRAM1_ROUTE_REC_LEN, "Rte");
+  FRAM1Layout.addTable(FRAM1_PARK1_START, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN, "Pk1");
+  FRAM1Layout.addTable(FRAM1_PARK2_START, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN, "Pk2");
+  if (!FRAM1Layout.verify(FRAM1ControlBuf, "FRAM1", lcdString)) {
+    LCD2004.send(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(1);
+  }
+  return;
+}
+
 void updateFRAM1ControlBlock() {
   // 10/19/16: This is really an A-MAS-only function.
   // Try to call this function whenever a train location or turnout orientation changes.
-  // We must populate/update lastKnownTurnout[] and lastTrainLoc[] *before* calling this routine.
+  // We must populate/update lastKnownTurnout[], lastTrainLoc[], and trainCalibration[] *before* calling this routine.
   // FRAM1ControlBuf will already be populated to preserve the revision date (first 3 bytes.)
   // First insert current turnout positions into control block
   memcpy(FRAM1ControlBuf + 3, &lastKnownTurnout, sizeof(lastKnownTurnout));
   // Now insert last known train positions into control block
   memcpy(FRAM1ControlBuf + 7, &lastTrainLoc, sizeof(lastTrainLoc));
+  // Now insert speed calibration curves
+  memcpy(FRAM1ControlBuf + FRAM1_CALIBRATION_OFFSET, &trainCalibration, sizeof(trainCalibration));
   // Now write the FRAM1 control buffer
   FRAM1.writeControlBlock(FRAM1ControlBuf);
   return;
@@ -2039,6 +2378,7 @@ void endWithFlashingLED(int numFlashes) {
   // Rev 10/05/16: Version for Arduinos WITHOUT relays that should be released.
 
   
+  LCD2004.flush();  // Make sure the error message is actually on the LCD before we stop.
   requestEmergencyStop();
   while (true) {
     for (int i = 1; i <= numFlashes; i++) {
@@ -2088,6 +2428,7 @@ void checkIfHaltPinPulledLow() {
       sprintf(lcdString, "%.20s", "HALT pin low!  End.");
       LCD2004.send(lcdString);
       Serial.println(lcdString);
+      LCD2004.flush();  // Make sure the message is actually on the LCD before we stop.
       while (true) { }  // For a real halt, just loop forever.
     } else {
       sprintf(lcdString,"False HALT detected.");
@@ -2097,3 +2438,12 @@ void checkIfHaltPinPulledLow() {
   }
   return;
 }
+
+void delayAndPollLCD(const unsigned long tDelayMS) {
+  // Rev: 10/19/26.  Like delay(), but keeps any new LCD text trickling out, since loop() isn't calling LCD2004.poll() meanwhile.
+  unsigned long tStartMS = millis();
+  while ((millis() - tStartMS) < tDelayMS) {
+    LCD2004.poll();
+  }
+  return;
+}
@@ -32,6 +32,15 @@ char APPVERSION[21] = "A-OCC Rev. 07/19/18";
 // A-MAS has told A-LEG to depart...  But that would result in possibly unnecessary delays that A-MAS would need to impose, even when
 // A-OCC might not make an announcement for that train, for whatever reason...
 
+// 10/19/26: The P.A. sequencer gives up on an announcement if a phrase never finishes, rather than waiting forever.
+// 10/19/26: The rotary push button ISR keeps a debounced pressed/released state, so a press whose first bounce is already
+//           HIGH when the ISR reads the pin is no longer dropped.
+// 10/19/26: The FRAM1 layout check is now FramLayout::verify(), which also works on an 8K FRAM1 with the double-level tables.
+// 10/19/26: At startup, confirm FRAM1 holds the Route and Park tables we were compiled for, and that no record is damaged.
+// 10/19/26: Added a non-blocking P.A. sequencer: 'P' announcements from A-MAS are queued and played phrase by phrase on the WAV Trigger.
+// 10/19/26: Rotary encoder now decoded by a quadrature transition table in the ISR, with turns and pushes queued as events.
+// 10/19/26: Control panel LEDs are now rendered into an in-RAM LEDFrame[], and only changed ports are written to the Centipedes.
+// 10/19/26: Snoop the 'O' occupancy snapshot from A-SNS when a mode starts, and set every white sensor LED from it.
 // 07/19/18: Added F() macros to all Serial.print commands with literal text strings, saving 1 byte/char of RAM.
 // 09/16/17: Changed variable suffixes from Length to Len, No/Number to Num, Record to Rec, etc.
 // 02/26/17: Added mode and state changed = false at top of get RS485 message main loop
@@ -84,15 +93,26 @@ char APPVERSION[21] = "A-OCC Rev. 07/19/18";
 //      6  Cksum      Byte  0..255
 
 // A-SNS to A-MAS:  Sensor status update for a single sensor change
-// Rev: 08/31/17
+// Rev: 10/19/26
 // OFFSET  DESC       SIZE  CONTENTS
-//      0  Length     Byte  7
+//      0  Length     Byte  11
 //      1  To         Byte  1 (A_MAS)
 //      2  From       Byte  3 (A_SNS)
 //      3  Command    Char  'S' Sensor status update
 //      4  Sensor #   Byte  1..53 (Note that as of Sept 2017, we have disconnected sensor 53 from the layout)
 //      5  Trip/Clr   Byte  [0|1] 0-Cleared, 1=Tripped
-//      6  Checksum   Byte  0..255
+//   6..9  Captured   ULong micros() on A-SNS when the change was seen, low byte first.  For speed calculations.
+//     10  Checksum   Byte  0..255
+
+// A-SNS to A-MAS:  Occupancy snapshot, the status of every sensor in one message (A-OCC snoops directly)
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  13
+//      1  To         Byte  1 (A_MAS)
+//      2  From       Byte  3 (A_SNS)
+//      3  Command    Char  'O' Occupancy snapshot
+//  4..11  Sensors    Byte  64 bits: 0=Cleared, 1=Tripped.  Sensor #1 is bit 0 of byte 4, sensor #9 is bit 0 of byte 5, etc.
+//     12  Checksum   Byte  0..255
 
 // A-MAS to A-OCC: Query for operator ANSWER QUESTION via alphanumeric display.  Registration mode only.
 // Rev: 09/20/17
@@ -161,6 +181,8 @@ char APPVERSION[21] = "A-OCC Rev. 07/19/18";
 //     10  Phrase 7   Byte  0 = Unused.
 //     11  Phrase 8   Byte  0 = Unused.
 //     12  Checksum   Byte  0..255
+// 10/19/26: A-OCC queues up to MAX_PA_ANNOUNCEMENTS_TO_BUF of these and plays them back to back, in order.  An announcement that
+// hasn't started within PA_STALE_MS of being received is dropped, since the train has probably moved on by then.
 
 // **************************************************************************************************************************
 
@@ -216,12 +238,14 @@ Centipede shiftRegister;          // create Centipede shift register object
 // Control buffer in each FRAM is first 128 bytes (address 0..127) reserved for any special purpose we want such as config info.
 #include <SPI.h>
 #include "Hackscribble_Ferro.h"
+#include "FramLayout.h"       // Layout header and per-record CRCs of the FRAM1 tables, checked at startup
 const unsigned int FRAM_CONTROL_BUF_SIZE = 128;  // This defaults to 64 bytes in the library, but we modified it
 // FRAM1 stores the Route Reference, Park 1 Reference, and Park 2 Reference tables.
 // FRAM1 control block (first 128 bytes):
 // Address 0..2 (3 bytes)   = Version number month, date, year i.e. 07, 13, 16
 // Address 3..6 (4 bytes)   = Last known position of each turnout.  Bit 0 = Normal, 1 = Reverse.
 // Address 7..36 (30 bytes) = Last known train locations for train 1 thru 10: trainNum, blockNum, direction
+// Address 77..124 (48 bytes) = FramLayout header: layout version, and start/records/length/CRC address of each table
 byte               FRAM1ControlBuf[FRAM_CONTROL_BUF_SIZE];
 unsigned int       FRAM1BufSize             =   0;  // We will retrieve this via a function call, but it better be 128!
 unsigned long      FRAM1Bottom              =   0;  // Should be 128 (address 0..127)
@@ -245,6 +269,7 @@ const byte         FRAM1_PARK2_REC_LEN      =  52;  // Was 43 until 12/3/17
 const byte         FRAM1_PARK2_RECS         =   4;
 const byte         FRAM1_RECS_PER_PARK2     =   6;  // Max number of block/turnout records in a single Park 2 route in the route table.
 Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);   // Create the FRAM1 object!
+FramLayout         FRAM1Layout(&FRAM1);           // Describes the FRAM1 tables so we can check their CRCs; see checkFRAM1Layout()
 // FRAM2 control block (first 128 bytes) contains no data - we don't need a version number because we don't have any initial data to read.
 // FRAM2 stores the Delayed Action table.  Table is 12 bytes per record, perhaps 400 records => approx. 5K bytes.
 // byte               FRAM2ControlBuf[FRAM_CONTROL_BUF_SIZE];
@@ -269,18 +294,68 @@ char alphaString[9] = "        ";  // Global array to hold strings sent to alpha
 // Here is a cross reference of the Mega interrupt number to pin numbers.  This is handled automatically via the digitalPinToInterrupt() function:
 //   Mega2560:    int.0  int.1  int.2  int.3  int.4  int.5
 //   Digital Pin:     2      3     21     20     19     18
-#define DIR_CCW 0x10    // decimal 16
-#define DIR_CW 0x20     // decimal 32
-// This global full-step state table emits a code at 00 only:
-const unsigned char ttable[7][4] = {
-  {0x0, 0x2, 0x4,  0x0}, {0x3, 0x0, 0x1, 0x10},
-  {0x3, 0x2, 0x0,  0x0}, {0x3, 0x2, 0x1,  0x0},
-  {0x6, 0x0, 0x4,  0x0}, {0x6, 0x5, 0x0, 0x20},
-  {0x6, 0x5, 0x4,  0x0},
+// Rev: 10/19/26.  ISR_rotary_turn() reads both encoder pins as a 2-bit state (PIN_ROTARY_2 << 1 | PIN_ROTARY_1) and looks up
+// ROTARY_QUAD_TABLE[(old state << 2) | new state] to get +1, -1, or 0 (no change, or an illegal double-bit jump from bounce.)
+// Quarter-steps are summed until the encoder is back at rest (both pins HIGH, which is the detent), and then one detent is
+// emitted in whichever direction got at least two net quarter-steps.  So bounce cancels itself out, and a detent is never
+// counted twice.  11 -> 10 -> 00 -> 01 -> 11 is clockwise.
+const signed char ROTARY_QUAD_TABLE[16] = {
+   0, +1, -1,  0,          // From 00
+  -1,  0,  0, +1,          // From 01
+  +1,  0,  0, -1,          // From 10
+   0, -1, +1,  0           // From 11
+};
+const byte ROTARY_REST_STATE           =     3;  // Both encoder pins HIGH at a detent
+const unsigned long ROTARY_PUSH_QUIET_US = 20000;  // Button must have been quiet this long before an edge changes its state
+volatile byte rotaryQuadState          =     3;  // Last 2-bit pin state seen by ISR_rotary_turn()
+volatile signed char rotaryQuarterSteps =     0;  // Net quarter-steps since the encoder was last at rest
+volatile unsigned long rotaryPushEdgeMicros = 0;  // micros() of the last edge on PIN_ROTARY_PUSH
+volatile bool rotaryPushPressed         = false;  // Debounced state of the push button, maintained by ISR_rotary_push()
+
+// *** ROTARY ENCODER EVENT QUEUE...
+// Rev: 10/19/26.  The ISRs are the only producer and getRotaryResponse() is the only consumer, so this is a single-producer,
+// single-consumer ring.  Unlike our other circular buffers there is no COUNT, because both sides would have to write it.
+// Only the ISRs write HEAD and only the loop writes TAIL, and a byte write is atomic on the Mega, so no interrupts need to be
+// disabled.  Empty when HEAD == TAIL; full when HEAD is one behind TAIL, in which case further events are dropped.
+// Size must be a power of 2.  16 events is far more than anyone can turn while we are writing to the LCD or Centipedes.
+const byte ROTARY_EVENT_CW             =     1;  // One detent clockwise
+const byte ROTARY_EVENT_CCW            =     2;  // One detent counter-clockwise
+const byte ROTARY_EVENT_PUSH           =     3;  // Button pressed
+const byte MAX_ROTARY_EVENTS_TO_BUF    =    16;
+volatile byte rotaryEventBuf[MAX_ROTARY_EVENTS_TO_BUF];
+volatile byte rotaryEventBufHead       =     0;  // Written only by the ISRs
+volatile byte rotaryEventBufTail       =     0;  // Written only by rotaryEventBufDequeue()
+
+// *** P.A. ANNOUNCEMENTS: Rev: 10/19/26.  Robertsonics WAV Trigger on Serial3, and PIN_WAV_TRIGGER is LOW while a track plays.
+// 'P' messages from A-MAS are queued in paAnnouncementBuf[] (our usual head/tail/count circular buffer.)
+// paSequencerProcess() is called every time through loop() and never waits: it sends one "play track" command, then watches
+// PIN_WAV_TRIGGER for the falling edge (track started) and the rising edge (track finished) before sending the next phrase.
+// If the WAV Trigger never reports that a track started (i.e. missing file) we give up on that phrase after PA_START_TIMEOUT_MS.
+// If it never reports that a track finished (a missed edge, or the pin stuck LOW) we give up on the whole announcement after
+// PA_PLAYING_TIMEOUT_MS, so the sequencer can't be wedged for the rest of the session.
+#define WAV_TRIGGER_SERIAL Serial3      // WAV Trigger serial RX is wired to Mega TX3
+const unsigned long WAV_TRIGGER_BAUD     = 57600;  // WAV Trigger default baud rate
+const byte MAX_PA_ANNOUNCEMENTS_TO_BUF   =     4;  // Announcements waiting to play; if full, the oldest is dropped
+const byte PA_PHRASES_PER_ANNOUNCEMENT   =     8;  // Bytes 4..11 of the 'P' message
+const unsigned long PA_STALE_MS          = 30000;  // Drop an announcement that couldn't start within this long of arriving
+const unsigned long PA_START_TIMEOUT_MS  =   500;  // Give up on a phrase if PIN_WAV_TRIGGER doesn't go LOW within this long
+const unsigned long PA_PLAYING_TIMEOUT_MS = 20000; // Longest phrase we'd ever play; give up if PIN_WAV_TRIGGER isn't HIGH by then
+const byte PA_IDLE                       =     0;  // Nothing playing
+const byte PA_WAIT_START                 =     1;  // Play command sent, waiting for PIN_WAV_TRIGGER to go LOW
+const byte PA_PLAYING                    =     2;  // Phrase playing, waiting for PIN_WAV_TRIGGER to go HIGH
+struct paAnnouncementStruct {
+  byte phrase[PA_PHRASES_PER_ANNOUNCEMENT];  // WAV Trigger track numbers; 0 = unused
+  unsigned long receivedMillis;              // When the 'P' message arrived, for PA_STALE_MS
 };
-volatile unsigned char rotaryNewState = 0;      // Value will be 0, 16, or 32 depending on how rotary being turned
-volatile unsigned char rotaryTurned   = false;  // Flag set by ISR so we know to process in loop()
-volatile unsigned char rotaryPushed   = false;  // Flag set by ISR so we know to process in loop()
+paAnnouncementStruct paAnnouncementBuf[MAX_PA_ANNOUNCEMENTS_TO_BUF];
+byte paAnnouncementBufHead  = 0;
+byte paAnnouncementBufTail  = 0;
+byte paAnnouncementBufCount = 0;
+paAnnouncementStruct paCurrent;         // The announcement being played now
+byte paPhraseNum            = 0;        // Index into paCurrent.phrase[] of the phrase playing now
+byte paState                = PA_IDLE;
+unsigned long paStateMillis = 0;        // When paState last changed
+bool paPinWasLow            = false;    // Last PIN_WAV_TRIGGER reading == LOW, for edge detection
 
 // *** MISC CONSTANTS AND GLOBALS: needed by A-OCC:
 // true = any non-zero number
@@ -454,6 +529,14 @@ byte sensorLEDStatus[TOTAL_SENSORS] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
 // const byte LED_BLUE_SOLID = 3;            // RGB block LED lit blue solid
 // const byte LED_BLUE_BLINKING = 4;         // RGB block LED lit blue blinking
 
+// LED FRAME.  THE 16-BIT IMAGE OF EACH CENTIPEDE PORT THAT DRIVES THE CONTROL PANEL LEDS.
+// Rev: 10/19/26.
+// paintSensorLEDs() and paintBlockLEDs() render into LEDFrame[], and LEDFrameFlush() writes only the ports that differ from
+// LEDFrameWritten[], which is what the Centipedes were last sent.  Ports 0..3 (pins 0..63) are the red/blue block LEDs, and ports
+// 4..7 (pins 64..127) are the white sensor LEDs.  A bit of 1 is an LED that's off, same as the Centipede outputs.
+unsigned int LEDFrame[8]        = {65535,65535,65535,65535,65535,65535,65535,65535};
+unsigned int LEDFrameWritten[8] = {65535,65535,65535,65535,65535,65535,65535,65535};  // initializeShiftRegisterPins() sets all HIGH
+
 // WHITE LED PIN NUMBER FOR GIVEN SENSOR NUMBER.  Cross-reference array that gives us a Centipede pin number 0..52 for a corresponding
 // Rev: 11/04/16.
 // WHITE LED for a given sensor number 1..53.  Since we wired sensor #x to Centipede pin #x, we don't need an actual cross-reference table.
@@ -564,6 +647,7 @@ void setup() {
   Serial.begin(115200);                 // PC serial monitor window
   // Serial1 is for the Digole 20x4 LCD debug display, already set up
   Serial2.begin(115200);                // RS485  up to 115200
+  WAV_TRIGGER_SERIAL.begin(WAV_TRIGGER_BAUD);  // WAV Trigger P.A. announcements
   Wire.begin();                         // Start I2C for Centipede shift register
   shiftRegister.initialize();           // Set all registers to default
   initializeShiftRegisterPins();        // Set all chips on Centipede shift register to OUTPUT, high (i.e. turn off all LEDs)
@@ -628,6 +712,20 @@ void loop() {
       RS485UpdateModeState(&modeOld, &modeCurrent, &modeChanged, &stateOld, &stateCurrent, &stateChanged);
     }
 
+    // CHECK FOR OCCUPANCY SNAPSHOT FROM A-SNS...
+    // 10/19/26: A-MAS asks for one whenever a mode starts.  It isn't a sensor change, so it's fine in any mode, even Registration.
+    if (RS485fromSNStoMAS_SnapshotMessage()) {
+      for (byte i = 0; i < TOTAL_SENSORS; i++) {
+        sensorLEDStatus[i] = bitRead(RS485MsgIncoming[4 + (i / 8)], (i % 8));
+      }
+    }
+
+    // CHECK FOR P.A. ANNOUNCEMENT REQUEST FROM A-MAS...
+    // 10/19/26: Just queue it; paSequencerProcess(), below, plays it without holding up the loop.
+    if (RS485fromMAStoOCC_PAAnnouncement()) {
+      paAnnouncementBufEnqueue(RS485MsgIncoming + 4);
+    }
+
     // CHECK FOR SENSOR-CHANGE MESSAGE AND HANDLE FOR ALL MODES...
     // In Manual or P.O.V. mode, we'll just update the sensor and block LEDs on the control panel, easy.
     // In Register mode, we'll trigger a Halt because sensors should never change during registratino.
@@ -689,6 +787,7 @@ void loop() {
 
     if ((stateChanged) && (stateCurrent == STATE_STOPPED)) {  // Any special handling for when any mode has just been STOPPED
 
+      paAnnouncementBufClear();  // Don't start any more announcements; a phrase already playing will just finish.
       //  paintControlPanel(0); // Not needed here because will be done at end of loop()
 
     } 
@@ -1023,6 +1122,7 @@ void loop() {
 
 //  }  // end of "in any mode, and state is either RUNNING or STOPPING
 
+  paSequencerProcess();   // Start the next P.A. phrase if the last one finished.  Never waits.
   paintControlPanel(0);
     
 }  // end of main loop()
@@ -1293,31 +1393,50 @@ void initializeBlockReservationTable() {
   return;
 }
 
+bool LEDBlinkPhase() {
+  // Rev 10/19/26: Returns true if blinking LEDs should be lit at this moment.  Derived from millis() rather than a toggle, so every
+  // blinking LED (white, red, or blue) flips at the same moment, every LED_FLASH_MS, regardless of how often we paint.
+  return (((millis() / LED_FLASH_MS) % 2) == 0);
+}
+
+void LEDFrameSet(const byte tPin, const bool tOn) {
+  // Rev 10/19/26: Set one LED in the in-RAM LED frame.  Centipede pins are active LOW, so a ZERO bit is a lit LED.
+  bitWrite(LEDFrame[tPin >> 4], (tPin & 0x0F), (tOn ? 0 : 1));
+  return;
+}
+
+void LEDFrameFlush() {
+  // Rev 10/19/26: Write each 16-bit port of LEDFrame[] that differs from what we last wrote to the Centipedes, with a single
+  // portWrite() per port.  If nothing changed since the last paint, there is no I2C traffic at all; at most 8 port writes.
+  for (byte i = 0; i < 8; i++) {
+    if (LEDFrame[i] != LEDFrameWritten[i]) {
+      shiftRegister.portWrite(i, LEDFrame[i]);
+      LEDFrameWritten[i] = LEDFrame[i];
+    }
+  }
+  return;
+}
+
 void paintSensorLEDs() {
+  // Rev 10/19/26: Now renders into LEDFrame[] rather than writing each LED; LEDFrameFlush() sends only the ports that changed.
   // Rev 11/06/16: Based on the array of current sensor status, update every white sensor-status LED on the control panel.
   // NOTE: If currentMode is STOPPED, then we will turn off all white LEDs.
   // If blinking, blink at a rate of toggling every LED_FLASH_TIME milliseconds i.e. every 1/2 second or so.
-  // NOTE: We may want to sync the blink timing with paintBlockLEDs() so they flash at the same time.
+  // 10/19/26: Blink timing now comes from LEDBlinkPhase(), so it is in sync with paintBlockLEDs().
   // Note: Currently we are not using the "blinking" attrubute for the white occupancy LEDs.
 
   // At this point, we already have: sensorLEDStatus[0..(TOTAL_SENSORS - 1)] = 0 (off), 1 (on), or 2 (blinking)
   // So now just update the physical LEDs on the control panel, or darken if mode is stopped.
-  static unsigned long LEDFlashProcessed = millis();   // Delay between toggling flashing LEDs on control panel i.e. 1/2 second.
-  static bool LEDsOn = false;    // Toggle this variable to know when flashing LEDs should be on versus off.  (Flash feature not used yet)
-
-  if ((millis() - LEDFlashProcessed) > LED_FLASH_MS) {   // First decide if flashing LEDs should be on or off at this moment
-    LEDFlashProcessed = millis();   // Reset flash timer (about every 1/2 second)
-    LEDsOn = !LEDsOn;    // Invert flash toggle
-  }
+  bool LEDsOn = LEDBlinkPhase();   // Should flashing LEDs be on or off at this moment?  (Flash feature not used yet)
 
   // Write a ZERO to a bit to turn on the LED, write a ONE to a bit to turn the LED off.  Opposite of our sensorLEDStatus[] array.
 
   for (byte i = 0; i < TOTAL_SENSORS; i++) {    // For every sensor/"bit" of the Centipede shift register output
 
     if (stateCurrent == STATE_STOPPED) {   // Darken all white LEDs whenever no mode is running
-      shiftRegister.digitalWrite(64 + i, HIGH);   // turn off the LED
+      LEDFrameSet(64 + i, false);   // turn off the LED
     } else  if (modeCurrent == MODE_REGISTER) {  // Darken all white LEDs whenever we are in Register mode, any state
-      shiftRegister.digitalWrite(64 + i, HIGH);   // turn off the LED
+      LEDFrameSet(64 + i, false);   // turn off the LED
 
     // We (no longer as of 9/17) need special handling to resolve sensors #2 and #53, as there is only one LED that they share.
     // No longer applicable: If either one is tripped, then show the LED as lit.  Only if both are clear should the LED be off.
@@ -1325,25 +1444,25 @@ void paintSensorLEDs() {
     /*
     } else if ((i == 1) || (i == 52)) {     // Special handling if looking at sensor #2 or #53 (note: element 0 is sensor 1, etc.)
       if ((sensorLEDStatus[1] == 0) && (sensorLEDStatus[52] == 0)) {    // Both sensors #2 and #53 are clear
-        shiftRegister.digitalWrite(64 + 1, HIGH);        // turn off the LED
-        shiftRegister.digitalWrite(64 + 52, HIGH);        // turn off the LED
+        LEDFrameSet(64 + 1, false);        // turn off the LED
+        LEDFrameSet(64 + 52, false);        // turn off the LED
       } else {                              // At least one of the two is tripped, so illuminate the LED
-        shiftRegister.digitalWrite(64 + 1, LOW);        // turn on the LED
-        shiftRegister.digitalWrite(64 + 52, LOW);        // turn on the LED
+        LEDFrameSet(64 + 1, true);         // turn on the LED
+        LEDFrameSet(64 + 52, true);         // turn on the LED
       }
 
     // For all sensors except #2 and #53...
     */
     // Not STOPPED and not REGISTER means illuminate according to sensor status
     } else if (sensorLEDStatus[i] == 0) {   // LED should be off
-      shiftRegister.digitalWrite(64 + i, HIGH);        // turn off the LED
+      LEDFrameSet(64 + i, false);        // turn off the LED
     } else if (sensorLEDStatus[i] == 1) {   // LED should be on
-      shiftRegister.digitalWrite(64 + i, LOW);         // turn on the LED
+      LEDFrameSet(64 + i, true);          // turn on the LED
     } else {                                // Must be 2 = blinking.  Note that we are currently not using this feature; for future use if desired.
       if (LEDsOn) {
-        shiftRegister.digitalWrite(64 + i, LOW);       // turn on the LED until we have code to handle this
+        LEDFrameSet(64 + i, true);        // turn on the LED until we have code to handle this
       } else {
-        shiftRegister.digitalWrite(64 + i, HIGH);       // turn on the LED until we have code to handle this
+        LEDFrameSet(64 + i, false);       // turn on the LED until we have code to handle this
       }
     }
   }
@@ -1351,9 +1470,10 @@ void paintSensorLEDs() {
 }
 
 void paintBlockLEDs(const byte *tBlockLEDStatus) {
+  // Rev 10/19/26: Now renders into LEDFrame[] rather than writing each LED; LEDFrameFlush() sends only the ports that changed.
   // Rev 11/06/16: Based on the array of current block status LEDs, update every red/blue LED on the control panel.
   // If blinking, blink at a rate of toggling every LED_FLASH_TIME milliseconds i.e. every 1/2 second or so.
-  // NOTE: We may want to sync the blink timing with paintSensorLEDs() so they flash at the same time.
+  // 10/19/26: Blink timing now comes from LEDBlinkPhase(), so it is in sync with paintSensorLEDs().
   // tBlockLEDStatus[0..TOTAL_BLOCKS - 1] will be:
   //   LED_DARK = 0;                  // LED off
   //   LED_RED_SOLID = 1;             // RGB block LED lit red solid
@@ -1361,54 +1481,48 @@ void paintBlockLEDs(const byte *tBlockLEDStatus) {
   //   LED_BLUE_SOLID = 3;            // RGB block LED lit blue solid
   //   LED_BLUE_BLINKING = 4;         // RGB block LED lit blue blinking
 
-  static unsigned long LEDFlashProcessed = millis();   // Delay between toggling flashing LEDs on control panel i.e. 1/2 second.
-  static bool LEDsOn = false;        // Toggle this variable to know when flashing LEDs should be on versus off.
-
-  if ((millis() - LEDFlashProcessed) > LED_FLASH_MS) {   // First decide if flashing LEDs should be on or off at this moment
-    LEDFlashProcessed = millis();   // Reset flash timer (about every 1/2 second)
-    LEDsOn = !LEDsOn;    // Invert flash toggle
-  }
+  bool LEDsOn = LEDBlinkPhase();   // Should flashing LEDs be on or off at this moment?
 
   for (byte block = 0; block < TOTAL_BLOCKS; block++) {     // For block = 0..25, where block number would be 1..26
 
     if (stateCurrent == STATE_STOPPED) {   // Darken all red and blue LEDs
-      shiftRegister.digitalWrite(LEDBlueBlockPin[block], HIGH);  // Blue LED off
-      shiftRegister.digitalWrite(LEDRedBlockPin[block], HIGH);  // Red LED off
+      LEDFrameSet(LEDBlueBlockPin[block], false);  // Blue LED off
+      LEDFrameSet(LEDRedBlockPin[block], false);  // Red LED off
 
 //    } else if (modeCurrent == MODE_REGISTER) {
-//      shiftRegister.digitalWrite(LEDBlueBlockPin[block], HIGH);  // Blue LED off
-//      shiftRegister.digitalWrite(LEDRedBlockPin[block], HIGH);  // Red LED off
+//      LEDFrameSet(LEDBlueBlockPin[block], false);  // Blue LED off
+//      LEDFrameSet(LEDRedBlockPin[block], false);  // Red LED off
 
     } else if (tBlockLEDStatus[block] == LED_DARK) {
-      shiftRegister.digitalWrite(LEDBlueBlockPin[block], HIGH);  // Blue LED off
-      shiftRegister.digitalWrite(LEDRedBlockPin[block], HIGH);  // Red LED off
+      LEDFrameSet(LEDBlueBlockPin[block], false);  // Blue LED off
+      LEDFrameSet(LEDRedBlockPin[block], false);  // Red LED off
 
     } else if (tBlockLEDStatus[block] == LED_RED_SOLID) {
-      shiftRegister.digitalWrite(LEDBlueBlockPin[block], HIGH);  // Blue LED off
-      shiftRegister.digitalWrite(LEDRedBlockPin[block], LOW);  // Red LED on
+      LEDFrameSet(LEDBlueBlockPin[block], false);  // Blue LED off
+      LEDFrameSet(LEDRedBlockPin[block], true);   // Red LED on
 
     } else if (tBlockLEDStatus[block] == LED_BLUE_SOLID) {
-      shiftRegister.digitalWrite(LEDBlueBlockPin[block], LOW);  // Blue LED on
-      shiftRegister.digitalWrite(LEDRedBlockPin[block], HIGH);  // Red LED off
+      LEDFrameSet(LEDBlueBlockPin[block], true);   // Blue LED on
+      LEDFrameSet(LEDRedBlockPin[block], false);  // Red LED off
 
     } else if (tBlockLEDStatus[block] == LED_RED_BLINKING) {
-      shiftRegister.digitalWrite(LEDBlueBlockPin[block], HIGH);  // Blue LED off
+      LEDFrameSet(LEDBlueBlockPin[block], false);  // Blue LED off
 
       if (LEDsOn) {   // Flashing LEDs "on" at this moment
-        shiftRegister.digitalWrite(LEDRedBlockPin[block], LOW);  // Red LED on
+        LEDFrameSet(LEDRedBlockPin[block], true);   // Red LED on
 
       } else {  // Flashing LEDs "off" at this moment
-        shiftRegister.digitalWrite(LEDRedBlockPin[block], HIGH);  // Red LED off
+        LEDFrameSet(LEDRedBlockPin[block], false);  // Red LED off
       }
 
     } else if (tBlockLEDStatus[block] == LED_BLUE_BLINKING) {
-      shiftRegister.digitalWrite(LEDRedBlockPin[block], HIGH);  // Red LED off
+      LEDFrameSet(LEDRedBlockPin[block], false);  // Red LED off
 
       if (LEDsOn) {   // Flashing LEDs "on" at this moment
-        shiftRegister.digitalWrite(LEDBlueBlockPin[block], LOW);  // Blue LED on
+        LEDFrameSet(LEDBlueBlockPin[block], true);   // Blue LED on
 
       } else {  // Flashing LEDs "off" at this moment
-        shiftRegister.digitalWrite(LEDBlueBlockPin[block], HIGH);  // Blue LED off
+        LEDFrameSet(LEDBlueBlockPin[block], false);  // Blue LED off
       }
 
     }
@@ -1493,6 +1607,7 @@ void paintControlPanel(byte tItemNum) {
   }  // end of "if state is not STOPPED
 
   paintBlockLEDs(blockLEDStatus);  // Paint all of the red/blue LEDs.  If currentState is STOPPED, they will all be darkened.
+  LEDFrameFlush();                 // Now send whatever actually changed to the Centipedes.
   return;
 
 }
@@ -1536,6 +1651,18 @@ bool RS485fromSNStoMAS_SensorMessage() {
   return false;
 }
 
+bool RS485fromSNStoMAS_SnapshotMessage() {
+  // Rev: 10/19/26.  Occupancy snapshot from A-SNS to A-MAS, with the status of every sensor.
+  if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_MAS) {
+    if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_SNS) {
+      if (RS485MsgIncoming[3] == 'O') {  // It's an occupancy snapshot from A-SNS
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool RS485fromMAStoOCC_Question() {
   if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_OCC) {
     if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) {
@@ -1547,6 +1674,18 @@ bool RS485fromMAStoOCC_Question() {
   return false;
 }
 
+bool RS485fromMAStoOCC_PAAnnouncement() {
+  // Rev: 10/19/26.
+  if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_OCC) {
+    if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) {
+      if (RS485MsgIncoming[3] == 'P') {  // It's a P.A. announcement command from A-MAS
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool RS485fromMAStoOCC_Registration() {
   if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_OCC) {
     if (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) {
@@ -1558,6 +1697,119 @@ bool RS485fromMAStoOCC_Registration() {
   return false;
 }
 
+// ****************************************************************************
+// ***************** P.A. ANNOUNCEMENT FUNCTIONS Rev: 10/19/26 ****************
+// ****************************************************************************
+
+void paAnnouncementBufEnqueue(const byte tPhrase[]) {
+  // Rev: 10/19/26.  Add an announcement of PA_PHRASES_PER_ANNOUNCEMENT phrase numbers to the head of the buffer.
+  // Unlike our other buffers, overflow is not fatal: the P.A. is just for fun, so we drop the oldest announcement instead.
+  if (paAnnouncementBufCount == MAX_PA_ANNOUNCEMENTS_TO_BUF) {
+    Serial.println(F("PA buffer full, dropping oldest."));
+    paAnnouncementBufTail = (paAnnouncementBufTail + 1) % MAX_PA_ANNOUNCEMENTS_TO_BUF;
+    paAnnouncementBufCount--;
+  }
+  memcpy(paAnnouncementBuf[paAnnouncementBufHead].phrase, tPhrase, PA_PHRASES_PER_ANNOUNCEMENT);
+  paAnnouncementBuf[paAnnouncementBufHead].receivedMillis = millis();
+  paAnnouncementBufHead = (paAnnouncementBufHead + 1) % MAX_PA_ANNOUNCEMENTS_TO_BUF;
+  paAnnouncementBufCount++;
+  return;
+}
+
+bool paAnnouncementBufDequeue(paAnnouncementStruct * tAnnouncement) {
+  // Rev: 10/19/26.  Retrieve the oldest announcement, if any.  Returns false if the buffer is empty.
+  if (paAnnouncementBufCount == 0) {
+    return false;
+  }
+  * tAnnouncement = paAnnouncementBuf[paAnnouncementBufTail];
+  paAnnouncementBufTail = (paAnnouncementBufTail + 1) % MAX_PA_ANNOUNCEMENTS_TO_BUF;
+  paAnnouncementBufCount--;
+  return true;
+}
+
+void paAnnouncementBufClear() {
+  // Rev: 10/19/26.  Discard any announcements that haven't started yet.
+  paAnnouncementBufHead = 0;
+  paAnnouncementBufTail = 0;
+  paAnnouncementBufCount = 0;
+  return;
+}
+
+void wavTriggerPlayTrack(const byte tTrack) {
+  // Rev: 10/19/26.  Send a WAV Trigger "track control, play solo" command: SOM1 SOM2 LEN CMD CODE TRK_LO TRK_HI EOM.
+  // Eight bytes at 57600 baud fit in the hardware serial buffer, so this never waits.
+  byte cmd[8] = {0xF0, 0xAA, 0x08, 0x03, 0x00, tTrack, 0x00, 0x55};
+  WAV_TRIGGER_SERIAL.write(cmd, 8);
+  return;
+}
+
+bool paStartNextPhrase() {
+  // Rev: 10/19/26.  Starting at paPhraseNum, send the next non-zero phrase in paCurrent.  Returns false if there are none left.
+  while (paPhraseNum < PA_PHRASES_PER_ANNOUNCEMENT) {
+    if (paCurrent.phrase[paPhraseNum] != 0) {
+      wavTriggerPlayTrack(paCurrent.phrase[paPhraseNum]);
+      return true;
+    }
+    paPhraseNum++;
+  }
+  return false;
+}
+
+void paSequencerProcess() {
+  // Rev: 10/19/26.  Called every pass through loop(), and from any other loop that might run for a while (i.e. rotary prompts.)
+  // Advances the P.A. sequencer by at most one step and returns immediately; nothing here ever waits on audio.
+  // PA_IDLE:       If an announcement is queued and not stale, start its first phrase.
+  // PA_WAIT_START: Wait for a falling edge on PIN_WAV_TRIGGER, or give up on this phrase after PA_START_TIMEOUT_MS.
+  // PA_PLAYING:    Wait for a rising edge on PIN_WAV_TRIGGER, then start the next phrase, or go idle if that was the last one.
+  //                If no rising edge comes within PA_PLAYING_TIMEOUT_MS, drop the rest of the announcement and go idle.
+  bool pinIsLow = (digitalRead(PIN_WAV_TRIGGER) == LOW);
+  bool startedEdge = ((!paPinWasLow) && pinIsLow);
+  bool finishedEdge = (paPinWasLow && (!pinIsLow));
+  paPinWasLow = pinIsLow;
+
+  bool phraseDone = false;   // True if the current phrase has finished (or failed) and we should move to the next one
+  if (paState == PA_IDLE) {
+    while (paAnnouncementBufDequeue(&paCurrent)) {
+      if ((millis() - paCurrent.receivedMillis) > PA_STALE_MS) {
+        Serial.println(F("PA announcement stale, dropped."));
+        continue;
+      }
+      paPhraseNum = 0;
+      if (paStartNextPhrase()) {
+        paState = PA_WAIT_START;
+        paStateMillis = millis();
+        break;
+      }
+    }
+  } else if (paState == PA_WAIT_START) {
+    if (startedEdge) {
+      paState = PA_PLAYING;
+      paStateMillis = millis();
+    } else if ((millis() - paStateMillis) > PA_START_TIMEOUT_MS) {
+      Serial.println(F("PA phrase never started."));
+      phraseDone = true;
+    }
+  } else if (paState == PA_PLAYING) {
+    if (finishedEdge) {
+      phraseDone = true;
+    } else if ((millis() - paStateMillis) > PA_PLAYING_TIMEOUT_MS) {
+      Serial.println(F("PA phrase never finished, announcement dropped."));
+      paState = PA_IDLE;   // Next pass will pick up the next queued announcement, if any
+    }
+  }
+
+  if (phraseDone) {
+    paPhraseNum++;
+    if (paStartNextPhrase()) {
+      paState = PA_WAIT_START;
+      paStateMillis = millis();
+    } else {
+      paState = PA_IDLE;   // Next pass will pick up the next queued announcement, if any
+    }
+  }
+  return;
+}
+
 // ****************************************************************************
 // ****************** TRAIN PROGRESS FUNCTIONS Rev: 09/28/17 ******************
 // ****************************************************************************
@@ -1772,35 +2024,73 @@ void sendToAlpha(const char nextLine[])  {
 // ******************** ROTARY ENCODER FUNCTIONS **************************
 // ************************************************************************
 
+void rotaryEventBufEnqueue(const byte tEvent) {
+  // Rev: 10/19/26.  Called ONLY from the rotary ISRs.  If the queue is full, the event is dropped rather than overwriting.
+  byte nextHead = (rotaryEventBufHead + 1) & (MAX_ROTARY_EVENTS_TO_BUF - 1);
+  if (nextHead != rotaryEventBufTail) {
+    rotaryEventBuf[rotaryEventBufHead] = tEvent;
+    rotaryEventBufHead = nextHead;   // Publish only after the event itself is stored
+  }
+  return;
+}
+
+bool rotaryEventBufDequeue(byte * tEvent) {
+  // Rev: 10/19/26.  Called ONLY from loop() code.  Returns false if there are no rotary events waiting.
+  if (rotaryEventBufTail == rotaryEventBufHead) {
+    return false;
+  }
+  * tEvent = rotaryEventBuf[rotaryEventBufTail];
+  rotaryEventBufTail = (rotaryEventBufTail + 1) & (MAX_ROTARY_EVENTS_TO_BUF - 1);
+  return true;
+}
+
 void ISR_rotary_push() {
-  // Rev: 10/26/16.  Set rotaryPushed = true, after waiting for bounce to settle.
-  // We can eliminate delay if we implement hardware debounce, but it only takes 5 milliseconds, and we are only
-  // delayed when the operator presses the button, so this is nothing.  Just keep software debounce.
-  delayMicroseconds(5000);   // 1000 microseconds is not quite enough to totally eliminate bounce.
-  if (digitalRead(PIN_ROTARY_PUSH) == LOW) {
-    rotaryPushed = true;
+  // Rev: 10/19/26.  Now triggered on CHANGE, and debounced without delaying inside the ISR.  The first edge that follows at
+  // least ROTARY_PUSH_QUIET_US with no edges at all flips the debounced state in rotaryPushPressed, and going from released to
+  // pressed queues a press.  We don't look at the pin, because by the time the ISR runs a bounce may already have taken it
+  // back HIGH, and the press would be lost.  The bounces that follow, on press or release, arrive within a few ms of another
+  // edge and so are ignored.
+  // Rev: 10/26/16.  Called when the rotary encoder button is pressed.
+  unsigned long now = micros();
+  if ((now - rotaryPushEdgeMicros) > ROTARY_PUSH_QUIET_US) {
+    rotaryPushPressed = !rotaryPushPressed;
+    if (rotaryPushPressed) {
+      rotaryEventBufEnqueue(ROTARY_EVENT_PUSH);
+    }
   }
+  rotaryPushEdgeMicros = now;
   return;
 }  
 
 void ISR_rotary_turn() {
-  // Rev: 10/26/16. Called when rotary encoder turned either direction, returns rotaryTurned and rotaryNewState globals.
-  static unsigned char state = 0;
-  unsigned char pinState = (digitalRead(PIN_ROTARY_2) << 1) | digitalRead(PIN_ROTARY_1);
-  state = ttable[state & 0xf][pinState];
-  unsigned char stateReturn = (state & 0x30);
-  if ((stateReturn == DIR_CCW) || (stateReturn == DIR_CW)) {
-    rotaryTurned = true;
-    rotaryNewState = stateReturn;
+  // Rev: 10/19/26.  Decode via ROTARY_QUAD_TABLE[] and queue one ROTARY_EVENT_CW or _CCW per detent.
+  // Rev: 10/26/16. Called when rotary encoder turned either direction.
+  byte pinState = (digitalRead(PIN_ROTARY_2) << 1) | digitalRead(PIN_ROTARY_1);
+  rotaryQuarterSteps = rotaryQuarterSteps + ROTARY_QUAD_TABLE[(rotaryQuadState << 2) | pinState];
+  rotaryQuadState = pinState;
+  if (pinState == ROTARY_REST_STATE) {   // Back at a detent, so decide if we moved one
+    if (rotaryQuarterSteps >= 2) {
+      rotaryEventBufEnqueue(ROTARY_EVENT_CW);
+    } else if (rotaryQuarterSteps <= -2) {
+      rotaryEventBufEnqueue(ROTARY_EVENT_CCW);
+    }
+    rotaryQuarterSteps = 0;
   }
   return;
 }
 
 void ISR_rotary_enable() {
+  // Rev: 10/19/26.  Resynchronize the decoder with the pins and empty the event queue before attaching, so a prompt never
+  // starts with stale clicks.  Push button interrupt is now CHANGE so ISR_rotary_push() can see release bounces too.
   // Rev: 02/04/17.  Call this to ENABLE interrupts by the rotary encoder.
+  rotaryQuadState = (digitalRead(PIN_ROTARY_2) << 1) | digitalRead(PIN_ROTARY_1);
+  rotaryQuarterSteps = 0;
+  rotaryPushEdgeMicros = micros();
+  rotaryPushPressed = (digitalRead(PIN_ROTARY_PUSH) == LOW);   // So a button still held from the last prompt isn't a press
+  rotaryEventBufTail = rotaryEventBufHead;   // Safe, since the ISRs aren't attached yet
   attachInterrupt(digitalPinToInterrupt(PIN_ROTARY_1), ISR_rotary_turn, CHANGE);  // Interrupt 0 is Mega pin 2
   attachInterrupt(digitalPinToInterrupt(PIN_ROTARY_2), ISR_rotary_turn, CHANGE);  // Interrupt 1 is Mega pin 3
-  attachInterrupt(digitalPinToInterrupt(PIN_ROTARY_PUSH), ISR_rotary_push, FALLING); // Interrupt 4 is Mega pin 19
+  attachInterrupt(digitalPinToInterrupt(PIN_ROTARY_PUSH), ISR_rotary_push, CHANGE); // Interrupt 4 is Mega pin 19
   return;
 }
 
@@ -1845,32 +2135,41 @@ byte getRotaryResponse(byte tStart) {
         endWithFlashingLED(1);
   }
   char s[9];  // Holds a complete prompt string to be sent to the A/N display
-  rotaryPushed = false;  // Reset this value
-  rotaryTurned = false;
   // Display the first prompt
   memcpy(s, rotaryPrompt[responseNum].promptText, 9);
   sendToAlpha(s);
 
+  // 10/19/26: Turns and pushes now arrive as events in rotaryEventBuf[].  We apply every queued turn before repainting the
+  // display once, so no clicks are lost or doubled no matter how long sendToAlpha() or anything else takes.
+  bool rotaryPushed = false;
   while (rotaryPushed == false) {   // Keep updating the prompt when rotary turned, until it is pressed
-    if (rotaryTurned == true) {      // Set to true by an interrupt when turned either direction
-      if (rotaryNewState == DIR_CCW) {  // Rotary was turned counter-clockwise
+    paSequencerProcess();   // Keep any P.A. announcement going while we wait for the operator
+    byte rotaryEvent;
+    bool rotaryTurned = false;
+    while ((rotaryPushed == false) && rotaryEventBufDequeue(&rotaryEvent)) {
+      if (rotaryEvent == ROTARY_EVENT_CCW) {  // Rotary was turned counter-clockwise
         if (responseNum > 0) {
           responseNum = responseNum - 1;     // Just decriment it if we won't make it less than zero
         } else {
           responseNum = numRotaryPrompts - 1;   // It's zero, so set to highest prompt (modulo subtraction)
         }
-      } else if (rotaryNewState == DIR_CW) {   // Rotary was turned clockwise, so display the next higher prompt (modulo number-of-prompts)
+        rotaryTurned = true;
+      } else if (rotaryEvent == ROTARY_EVENT_CW) {   // Rotary was turned clockwise, so display the next higher prompt (modulo number-of-prompts)
         responseNum = ((responseNum + 1) % numRotaryPrompts);   // Add 1, modulo total number of prompts
+        rotaryTurned = true;
+      } else if (rotaryEvent == ROTARY_EVENT_PUSH) {   // Operator selected whatever is showing now
+        rotaryPushed = true;
       } else {    // Error - this should never happen
         sprintf(lcdString, "%.20s", "Rotary DIR bad!");
         sendToLCD(lcdString);
         Serial.println(lcdString);
         endWithFlashingLED(1);
       }
+    }
+    if (rotaryTurned) {
       // Operator turned the dial and we've updated responseNum, so display it now
       memcpy(s, rotaryPrompt[responseNum].promptText, 8);
       sendToAlpha(s);
-      rotaryTurned = false;  // Reset this
     }
   }  // When we fall out of this loop, the operator has pressed the rotary, and thus selected prompt responseNum
   // Since we're done using the rotary encoder, disable interrupts so we won't be bothered if operator plays with it...
@@ -2084,10 +2383,29 @@ void initializeFRAM1AndGetControlBlock() {
     }
   }
 
+  checkFRAM1Layout();  // Fatal error if the tables are not what we expect, or any record is damaged
+
   // A-MAS will also retrieve last-known-turnout and last-known-train positions from control block, but nobody else needs this.
   return;
 }
 
+void checkFRAM1Layout() {
+  // Rev: 10/19/26.  Called by initializeFRAM1AndGetControlBlock() once the control block has been read.
+  // Populate_FRAM_Route_Reference stamps FRAM1 with a description of the Route, Park 1 and Park 2 tables and CRCs of their
+  // records.  FRAM1Layout.verify() checks that description matches our FRAM1_ constants (if not, FRAM1 was populated for a
+  // different layout, or before 10/19/26, and must be populated again), then reads every record and checks the CRCs, which takes
+  // a few tens of milliseconds.  If anything is wrong, lcdString says what.
+  FRAM1Layout.addTable(FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, FRAM1_ROUTE_REC_LEN, "Rte");
+  FRAM1Layout.addTable(FRAM1_PARK1_START, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN, "Pk1");
+  FRAM1Layout.addTable(FRAM1_PARK2_START, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN, "Pk2");
+  if (!FRAM1Layout.verify(FRAM1ControlBuf, "FRAM1", lcdString)) {
+    sendToLCD(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(1);
+  }
+  return;
+}
+
 void initializeLCDDisplay() {
   // Rev 09/26/17 by RDP
   LCDDisplay.begin();                     // Required to initialize LCD
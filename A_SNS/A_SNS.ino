@@ -31,6 +31,20 @@ char APPVERSION[21] = "A-SNS Rev. 07/19/18";
 // when it is ready to do so.  This applies to all other slave Arduinos as well as this one.
 // We will also write messages to the LCD screen whenever we see a change in occupancy status.
 
+// 10/19/26: A full sensor change buffer is fatal again while RUNNING or STOPPING; only at other times is the oldest dropped.
+// 10/19/26: A full sensor change buffer is no longer fatal.  While A-MAS isn't reading changes (i.e. STOPPED, which we learn by
+//           snooping its 'M' broadcasts), a sensor already in the buffer has its entry updated rather than a new one added, and
+//           if the buffer does fill, the oldest change is dropped.
+// 10/19/26: Sensors that are already occupied when we start are no longer sent one at a time.  Instead, when a mode starts,
+//           A-MAS asks for an 'O' snapshot of all 64 sensor bits, which everyone interested can snoop in a single message.
+// 10/19/26: Added a per-sensor software glitch filter so the multi-second hardware time-delay relays can be bypassed.  A raw
+//           change must hold for SENSOR_TRIP_HOLD_MS[] (trips) or SENSOR_CLEAR_HOLD_MS[] (clears) before it is reported.
+// 10/19/26: Moved the glitch filter into the SensorFilter library, so recorded sensor readings can be replayed through it on a PC.
+// 10/19/26: Sensor changes are now queued in sensorChangeBuf as they are seen, with a micros() timestamp, and sent to A-MAS
+//           from the queue without blocking, so scanning continues while we wait for A-MAS.  No change is lost, even a sensor
+//           that flips and flips back, and they are sent in the order seen.  The timestamp is now part of the 'S' message.
+// 10/19/26: Added SENSOR_INTERRUPTS mode.  The MCP23017s interrupt on any sensor change, and we only read the ports that changed,
+//           using INTCAP so a short glitch is still latched.  When nothing is changing, loop() does no I2C traffic at all.
 // 07/19/18: Added F() macros to all Serial.print commands with literal text strings, saving 1 byte/char of RAM.
 // 09/16/17: Changed variable suffixes from No and Number to Num, Length to Len, Record to Rec, etc.
 // 08/29/17: Cleaning up code, updated RS485 message protocol comments.  Changed sensor update array to structure.
@@ -54,6 +68,17 @@ char APPVERSION[21] = "A-SNS Rev. 07/19/18";
 // *** RS485 MESSAGE PROTOCOLS used by A-SNS.  Byte numbers represent offsets, so they start at zero. ***
 // Because there are so many message types, we will document the protocols here and just use integers for offsets in the code.
 
+// A-MAS BROADCAST: Mode change.  A-SNS snoops it only to know whether A-MAS is reading sensor changes (RUNNING or STOPPING.)
+// Rev: 08/31/17
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  7
+//      1  To         Byte  99 (ALL)
+//      2  From       Byte  1 (A_MAS)
+//      3  Msg Type   Char  'M' means this is a Mode/State update command
+//      4  Mode       Byte  1..5 [Manual | Register | Auto | Park | POV]
+//      5  State      Byte  1..3 [Running | Stopping | Stopped]
+//      6  Cksum      Byte  0..255
+
 // A-MAS to A-SNS:  Permission for A_SNS to send a sensor change record.
 // Rev: 08/31/17
 // OFFSET  DESC       SIZE  CONTENTS
@@ -64,15 +89,35 @@ char APPVERSION[21] = "A-SNS Rev. 07/19/18";
 //      4  Checksum   Byte  0..255
 
 // A-SNS to A-MAS:  Sensor status update for a single sensor change
-// Rev: 08/31/17
+// Rev: 10/19/26
 // OFFSET  DESC       SIZE  CONTENTS
-//      0  Length     Byte  7
+//      0  Length     Byte  11
 //      1  To         Byte  1 (A_MAS)
 //      2  From       Byte  3 (A_SNS)
 //      3  Command    Char  'S' Sensor status update
 //      4  Sensor #   Byte  1..52 (Note that as of Sept 2017, our code ignores sensor 53 and we have disconnected it from the layout)
 //      5  Trip/Clr   Byte  [0|1] 0-Cleared, 1=Tripped
-//      6  Checksum   Byte  0..255
+//   6..9  Captured   ULong micros() on A-SNS when the change was seen, low byte first.  For speed calculations.
+//     10  Checksum   Byte  0..255
+
+// A-MAS to A-SNS:  Request for a snapshot of every sensor's status, sent when a mode starts.
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  5
+//      1  To         Byte  3 (A_SNS)
+//      2  From       Byte  1 (A_MAS)
+//      3  Command    Char  'O' Occupancy snapshot request
+//      4  Checksum   Byte  0..255
+
+// A-SNS to A-MAS:  Occupancy snapshot, the status of every sensor in one message
+// Rev: 10/19/26
+// OFFSET  DESC       SIZE  CONTENTS
+//      0  Length     Byte  13
+//      1  To         Byte  1 (A_MAS)
+//      2  From       Byte  3 (A_SNS)
+//      3  Command    Char  'O' Occupancy snapshot
+//  4..11  Sensors    Byte  64 bits: 0=Cleared, 1=Tripped.  Sensor #1 is bit 0 of byte 4, sensor #9 is bit 0 of byte 5, etc.
+//     12  Checksum   Byte  0..255
 
 // **************************************************************************************************************************
 
@@ -109,16 +154,54 @@ DigoleSerialDisp LCDDisplay(&Serial1, 115200); //UART TX on arduino to RX on mod
 #include "Centipede.h"
 Centipede shiftRegister;          // create Centipede shift register object
 
-// *** SENSOR STATE TABLE: Arrays contain 4 elements (unsigned ints) of 16 bits each = 64 bits = 1 Centipede
-unsigned int sensorOldState[] = {65535,65535,65535,65535};
-unsigned int sensorNewState[] = {65535,65535,65535,65535};
-
-// *** SENSOR STATUS UPDATE TABLE: Store the sensor number and change type for an individual sensor change, to pass to functions etc.
+// *** SENSOR GLITCH FILTER:
+// 10/19/26: Brief gaps between cars used to be hidden by hardware time-delay relays set to several seconds, which delayed every
+// trip *and* clear.  Now a raw change is reported only after it has held steady for the sensor's hold time: short for trips, so
+// an arriving train is seen within milliseconds, and long for clears, so a gap between cars doesn't clear the block.
+// The filter itself is the SensorFilter library (see SensorFilter.h), which also keeps the state of all 64 sensors (4 elements of
+// 16 bits = 1 Centipede) that we have reported.  The time we send to A-MAS is when the raw reading first changed, not when the
+// filter accepted the change.
+// Sensor number = table index + 1.  Sensors 53..64 are not connected.
+const byte SENSOR_TRIP_HOLD_MS[64] = {
+  10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,     // Sensors  1..16
+  10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,     // Sensors 17..32
+  10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,     // Sensors 33..48
+  10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10};    // Sensors 49..64
+const unsigned int SENSOR_CLEAR_HOLD_MS[64] = {
+  2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000,     // Sensors  1..16
+  2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000,     // Sensors 17..32
+  2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000,     // Sensors 33..48
+  2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000};    // Sensors 49..64
+#include "SensorFilter.h"          // Per-sensor trip/clear glitch filter
+SensorFilter sensorFilter(SENSOR_TRIP_HOLD_MS, SENSOR_CLEAR_HOLD_MS);   // Filters and holds the state of all 64 sensors
+
+// *** SENSOR INTERRUPTS: Include the following #define to have the MCP23017s tell us when a sensor changes, rather than polling.
+// Requires INTA/INTB of all four chips on the sensor Centipede wired to PIN_SNS_INT.  The chips are set to mirror INTA/INTB and
+// use open-drain outputs, so the lines can simply be tied together; the Mega's internal pullup holds the line HIGH.
+// Comment it out to go back to reading all four ports every time through loop().
+#define SENSOR_INTERRUPTS
+volatile bool sensorIntPending = false;   // Set by sensorISR() when the MCP23017 interrupt line falls
+bool sensorFirstScan           = true;    // Read all ports the first time through loop() to pick up sensors already occupied
+
+// *** SENSOR CHANGE BUFFER: Store the sensor number, change type, and time seen for each individual sensor change.
+// 10/19/26: Was a single sensorUpdate record that was sent (blocking) as soon as the change was seen.  Now a circular buffer, using
+// the same head/tail/count logic as our other circular buffers, so changes pile up here while we wait for A-MAS to ask for them.
+// A-MAS only reads changes while RUNNING or STOPPING, and takes an 'O' snapshot (which empties the buffer) when a mode starts.  So
+// at any other time, only the latest change for each sensor matters, and sensorChangeBufEnqueue() keeps at most one per sensor;
+// trains moved by hand while STOPPED can't fill it.  Size it for all 64 sensors.
+const byte MAX_SENSOR_CHANGES_TO_BUF = 64;
+byte sensorChangeBufHead  = 0;   // Next array element to be written.
+byte sensorChangeBufTail  = 0;   // Next array element to be removed.
+byte sensorChangeBufCount = 0;   // Num active elements in buffer.  Max is MAX_SENSOR_CHANGES_TO_BUF.
 struct sensorUpdateStruct {
-  byte sensorNum;
-  byte changeType;
+  byte sensorNum;                // 1..52
+  byte changeType;               // 0 = Cleared, 1 = Tripped
+  unsigned long captureMicros;   // micros() when the change was read from the Centipede
 };
-sensorUpdateStruct sensorUpdate = {0, 0};
+sensorUpdateStruct sensorChangeBuf[MAX_SENSOR_CHANGES_TO_BUF];
+sensorUpdateStruct sensorUpdate = {0, 0, 0};   // Holds a single record to be sent
+bool sensorAwaitingRequest = false;   // True while PIN_REQ_TX_A_SNS_OUT is LOW and we're waiting for A-MAS to ask for the change
+byte stateCurrent = STATE_UNDEFINED;  // A-MAS's state, snooped from its 'M' mode broadcasts.  Only RUNNING and STOPPING read changes.
 
 // *** MISC CONSTANTS AND GLOBALS: needed by A-SNS:
 // true = any non-zero number
@@ -143,6 +226,9 @@ void setup() {
   Wire.begin();                         // Start I2C for Centipede shift register
   shiftRegister.initialize();           // Set all registers to default
   initializeShiftRegisterPins();        // Set all Centipede shift register pins to INPUT for monitoring sensor trips
+#ifdef SENSOR_INTERRUPTS
+  initializeSensorInterrupts();         // Have the sensor Centipede pull PIN_SNS_INT low whenever a sensor changes
+#endif
   initializePinIO();                    // Initialize all of the I/O pins and turn all LEDs on control panel off
   initializeLCDDisplay();               // Initialize the Digole 20 x 04 LCD display
   sprintf(lcdString, APPVERSION);       // Display the application version number on the LCD display
@@ -160,14 +246,57 @@ void loop() {
   checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, just stop
 
   // We will not receive an RS485 query from A_MAS without us making a request to send, so we need to monitor for RS485
-  // messages frequently, but toss them out unless we know we are waiting for one for us - which would not be here.
+  // messages frequently, but toss them out unless we know we are waiting for one for us.
   // So dump however many messages might be in the incoming buffer before moving on...
   
-  do { } while (RS485GetMessage(RS485MsgIncoming));  // Clear out incoming RS485 messages from serial input buffer
+  // 10/19/26: The only message that is for us is A-MAS asking for the sensor change we told it we had, so send it now.
+  while (RS485GetMessage(RS485MsgIncoming)) {  // Clear out incoming RS485 messages from serial input buffer
+    // 10/19/26: Note A-MAS's state whenever it broadcasts a mode change, so we know whether it is reading sensor changes.
+    if ((RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_ALL) && (RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) &&
+        (RS485MsgIncoming[3] == 'M')) {
+      stateCurrent = RS485MsgIncoming[RS485_ALL_MAS_STATE_OFFSET];
+      continue;
+    }
+    if (RS485MsgIncoming[RS485_TO_OFFSET] == ARDUINO_SNS) {
+      // A-MAS may also ask for a snapshot of every sensor at any time (i.e. when a mode starts), whether or not we asked.
+      if ((RS485MsgIncoming[RS485_FROM_OFFSET] == ARDUINO_MAS) && (RS485MsgIncoming[3] == 'O')) {
+        RS485fromSNStoMAS_SendSnapshot();
+        continue;
+      }
+      // Just for fun, let's confirm that it's from A_MAS, that we have the appropriate "request" command we are expecting,
+      // and that we actually asked to send something...
+      if ((RS485MsgIncoming[RS485_FROM_OFFSET] != ARDUINO_MAS) || (RS485MsgIncoming[3] != 'S') || (!sensorAwaitingRequest)) {
+        sprintf(lcdString, "Unexpected message!");
+        sendToLCD(lcdString);
+        Serial.print(lcdString);
+        endWithFlashingLED(6);
+      }
+      sensorChangeBufDequeue(&sensorUpdate);
+      RS485fromSNStoMAS_SendSensorUpdate(sensorUpdate);   // Send this sensor change record to A-MAS
+      sensorAwaitingRequest = false;
+      sensorTimeUpdatedMS = millis();    // Refresh the timer
+      if (sensorUpdate.changeType == 0) {
+        sprintf(lcdString, "Sensor %2d cleared.", sensorUpdate.sensorNum);
+      } else {
+        sprintf(lcdString, "Sensor %2d tripped.", sensorUpdate.sensorNum);
+      }
+      sendToLCD(lcdString);            // Don't display a message on the LCD until after the change has been sent to A-MAS
+      Serial.println(lcdString);
+    }
+  }
+
+  // If we have a change waiting to be sent, and aren't already waiting for A-MAS to ask for one, pull the digital line LOW to tell
+  // A-MAS we have a sensor change to report, please query us...
+  // We need a slight delay in the event that we have a flurry of sensor changes to transmit to A-MAS, to give the
+  // other modules a chance to keep up.  No delay overflowed A-OCC input RS485 buffer when we started a mode.
+  // Note that we impose a delay ONLY if we just already sent an update, normally there will be no delay.
+  if ((!sensorAwaitingRequest) && (sensorChangeBufCount > 0) && ((millis() - sensorTimeUpdatedMS) >= SENSOR_DELAY_MS)) {
+    digitalWrite (PIN_REQ_TX_A_SNS_OUT, LOW);
+    sensorAwaitingRequest = true;
+  }
 
   // Read the status of the Centipede shift register and determine if there have been any new changes...
-  // unsigned int sensorOldState[] = {65535,65535,65535,65535};  // Bit = 1 means sensor NOT tripped, so default all unoccupied.
-  // unsigned int sensorNewState[] = {65535,65535,65535,65535};  // A bit changes to zero when it is occupied.
+  // Centipede bit = 1 means sensor NOT tripped, so sensorFilter starts with all unoccupied.  A bit changes to zero when it is occupied.
   // First time into loop, we will see bits set for all occupied sensors - probably several.
   // Use: shiftRegister.portRead([0...7]) - Reads 16-bit value from one port (chip)
 
@@ -189,54 +318,49 @@ void loop() {
   // Thus, a buffer to store state changes and then to be doled out to RS485 every 100ms would be fine, but totally unnecessary
   // in terms of the risk of missing any state changes.
   // Nevertheless, it would be good programming practice, and thus eliminate the following "blocking" code.
-
-  // Need to keep track of "before" and "after" values.
-  bool stateChange = false;
-  for (byte pinBank = 0; pinBank < 4; pinBank++) {  // This is for ONE Centipede shift register board, with four 16-bit chips.
-    sensorNewState[pinBank] = shiftRegister.portRead(pinBank);  // Populate with 4 16-bit values
-    if (sensorOldState[pinBank] != sensorNewState[pinBank]) {
-      stateChange = true;
-      // Figure which sensor...
-      // Centipede input 0 = sensor #1.
-      // changedBits uses Exclusive OR (^) to find changed bits in the current long int.
-      // Note that if a Centipede bit is 1, it means the sensor is NOT tripped,
-      // and if the Centipede bit is 0, it means the sensor has been tripped i.e. grounded.
-      unsigned int changedBits = (sensorOldState[pinBank] ^ sensorNewState[pinBank]);
-      for (byte pinBit = 0; pinBit < 16; pinBit++) {   // For each bit in this 16-bit integer (of 4)
-        if ((bitRead(changedBits, pinBit)) == 1) {     // Found a bit that has changed, one way or the other - set or cleared
-          byte sensorNum = ((pinBank * 16) + pinBit + 1);
-          // The following is a bit counter-intuitive because Centipede bit will be opposite of how we set sensorUpdate[] bit.
-          // We only do a test here (rather than do it in a single clever statement) so we can display English on the LCD.
-          if (bitRead(sensorNewState[pinBank], pinBit) == 1) {   // Bit changed to 1 means it is clear (not grounded)
-            sensorUpdate.changeType = 0;  // Cleared
-            sprintf(lcdString, "Sensor %2d cleared.", sensorNum);
-            chirp();  // Audible signal when sensor is cleared - single chirp
-          } else {   // Bit changed to 0 means it was tripped (i.e. grounded)
-            sensorUpdate.changeType = 1;  // Tripped
-            sprintf(lcdString, "Sensor %2d tripped.", sensorNum);
-            doubleChirp();  // Audible signal when sensor is tripped - double chirp
-          }
-          sensorUpdate.sensorNum = sensorNum;
-          // We need a slight delay in the event that we have a flurry of sensor changes to transmit to A-MAS, to give the
-          // other modules a chance to keep up.  No delay overflowed A-OCC input RS485 buffer when we started a mode.
-          // Note that we impose a delay ONLY if we just already sent an update, normally there will be no delay.
-          while ((millis() - sensorTimeUpdatedMS) < SENSOR_DELAY_MS) { }   // Wait a moment
-          sensorTimeUpdatedMS = millis();    // Refresh the timer
-          RS485fromSNStoMAS_SendSensorUpdate(sensorUpdate.sensorNum, sensorUpdate.changeType);  // Send this sensor change record to A-MAS
-          sendToLCD(lcdString);            // Don't display a message on the LCD until after the change has been sent to A-MAS
-          Serial.println(lcdString);
-        }
+  // 10/19/26: Done.  Changes now go into sensorChangeBuf and are sent above, one per request from A-MAS.
+
+  // 10/19/26: Get the new state of each port that may have changed, and queue every sensor change in it.
+  // In SENSOR_INTERRUPTS mode, a port with a pending interrupt is handled twice: first with the INTCAP value (its state at the
+  // moment of the first change, even if it has since changed back) and then with its current state.
+  // The first reading just becomes our state, without queueing any changes; A-MAS will get it with an 'O' snapshot.
+  if (sensorFirstScan) {
+    sensorFirstScan = false;
+    for (byte pinBank = 0; pinBank < 4; pinBank++) {   // Reading GPIO also clears any interrupt already pending
+      sensorFilter.begin(pinBank, shiftRegister.portRead(pinBank));
+    }
+#ifdef SENSOR_INTERRUPTS
+  } else if (sensorIntPending || (digitalRead(PIN_SNS_INT) == LOW)) {   // Line is held LOW until the change is read
+    sensorIntPending = false;
+    for (byte pinBank = 0; pinBank < 4; pinBank++) {
+      if (shiftRegister.portIntFlagRead(pinBank) != 0) {   // This port has a change pending
+        sensorFilter.processPortImage(pinBank, shiftRegister.portCaptureRead(pinBank), micros());  // Clears the interrupt
+        sensorFilter.processPortImage(pinBank, shiftRegister.portRead(pinBank), micros());
       }
     }
   }
-
-  // If there has been a change in sensor status, we will reset our old sensor states to reflect what was sent...
-  // We do this independent of the above "check every sensor" loop because there could have been multiple sensor changes in that
-  // loop, and we don't want to reset the states until all changes have been transmitted to A-MAS.
-  if (stateChange) {
-    // Now set "old" Centipede shift register value to the latest value, so only new changes will be seen...
-    for (byte pinBank = 0; pinBank < 4; pinBank++) {
-      sensorOldState[pinBank] = sensorNewState[pinBank];
+#else
+  } else {
+    for (byte pinBank = 0; pinBank < 4; pinBank++) {  // This is for ONE Centipede shift register board, with four 16-bit chips.
+      sensorFilter.processPortImage(pinBank, shiftRegister.portRead(pinBank), micros());  // Populate with 4 16-bit values
+    }
+  }
+#endif
+
+  // Any sensor whose raw reading has held long enough is now a real change.  This needs no I2C, so even in SENSOR_INTERRUPTS
+  // mode a clear is reported on time while the layout is otherwise quiet.
+  if (sensorFilter.isPending()) {
+    unsigned long nowMicros = micros();
+    byte sensorNum;
+    byte changeType;
+    unsigned long captureMicros;
+    while (sensorFilter.nextChange(nowMicros, &sensorNum, &changeType, &captureMicros)) {
+      sensorChangeBufEnqueue(sensorNum, changeType, captureMicros);
+      if (changeType == 0) {
+        chirp();        // Audible signal when sensor is cleared - single chirp
+      } else {
+        doubleChirp();  // Audible signal when sensor is tripped - double chirp
+      }
     }
   }
 
@@ -279,40 +403,119 @@ void initializeShiftRegisterPins() {
   return;
 }
 
-void RS485fromSNStoMAS_SendSensorUpdate(const byte tSensorNum, const byte tChangeType) {
-  // Rev: 09/30/17.
-  // Pull digital pin LOW to tell A-MAS we have a sensor change to report, please query us...
-  digitalWrite (PIN_REQ_TX_A_SNS_OUT, LOW);
-  // Wait for an RS485 command from A-MAS requesting sensor status.  Remember that it's possible that we may
-  // receive some RS485 messages that are irrelevant first, so ignore all RS485 messages until we see one to A-SNS.
-  // Also check if the Halt line has been pulled low, in case something crashed and message will never arrive.
-  RS485MsgIncoming[RS485_TO_OFFSET] = ARDUINO_NUL;   // Anything other than ARDUINO_SNS
-  do {
-    checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, just stop
-    RS485GetMessage(RS485MsgIncoming);
-  } while (RS485MsgIncoming[RS485_TO_OFFSET] != ARDUINO_SNS);
-  // Now we have an RS485 message to A-SNS.  Just for fun, let's confirm that it's from A_MAS, and that we
-  // have the appropriate "request" command we are expecting...
-  if ((RS485MsgIncoming[RS485_FROM_OFFSET] != ARDUINO_MAS) || (RS485MsgIncoming[3] != 'S')) {
-    sprintf(lcdString, "Unexpected message!");
+void initializeSensorInterrupts() {
+  // Rev: 10/19/26.  Set the four sensor chips to interrupt on any change of any pin (compared to its previous value, not DEFVAL),
+  // with INTA/INTB mirrored, open-drain, active LOW, and attach sensorISR() to the Mega pin they are all wired to.
+  for (int i = 0; i < 4; i++) {          // Just the one sensor Centipede board, four chips
+    shiftRegister.portInterrupts(i, 0b1111111111111111, 0b0000000000000000, 0b0000000000000000);  // GPINTEN, DEFVAL, INTCON
+    shiftRegister.portIntPinConfig(i, 1, 0);  // Open drain, so polarity is ignored (active LOW)
+  }
+  pinMode(PIN_SNS_INT, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(PIN_SNS_INT), sensorISR, FALLING);
+  return;
+}
+
+void sensorISR() {
+  // Rev: 10/19/26.  Just flag it; the I2C reads are done in loop(), never in an ISR.
+  sensorIntPending = true;
+}
+
+void sensorChangeBufEnqueue(const byte tSensorNum, const byte tChangeType, const unsigned long tCaptureMicros) {
+  // Rev: 10/19/26.  Insert a record at the head of the sensor change buffer, then increment head and count.
+  // If A-MAS isn't reading changes, and this sensor already has a change waiting, just update that one: the 'O' snapshot at the
+  // start of the next mode will replace the whole buffer anyway.
+  // If the buffer is already full while A-MAS is reading changes (RUNNING or STOPPING), a transition would be lost and A-MAS's
+  // idea of where the trains are would be wrong, so that's fatal.  At any other time drop the oldest change to make room; not
+  // fatal, since A-MAS's next snapshot puts it right.
+  bool masIsReading = ((stateCurrent == STATE_RUNNING) || (stateCurrent == STATE_STOPPING));
+  if (!masIsReading) {
+    for (byte i = 0; i < sensorChangeBufCount; i++) {
+      byte bufIndex = (sensorChangeBufTail + i) % MAX_SENSOR_CHANGES_TO_BUF;
+      if (sensorChangeBuf[bufIndex].sensorNum == tSensorNum) {
+        sensorChangeBuf[bufIndex].changeType = tChangeType;
+        sensorChangeBuf[bufIndex].captureMicros = tCaptureMicros;
+        return;
+      }
+    }
+  }
+  if ((sensorChangeBufCount == MAX_SENSOR_CHANGES_TO_BUF) && masIsReading) {
+    sprintf(lcdString, "%.20s", "Sensor buf overflow!");
     sendToLCD(lcdString);
-    Serial.print(lcdString);
+    Serial.println(lcdString);
     endWithFlashingLED(6);
   }
+  if (sensorChangeBufCount == MAX_SENSOR_CHANGES_TO_BUF) {
+    sensorChangeBufTail = (sensorChangeBufTail + 1) % MAX_SENSOR_CHANGES_TO_BUF;
+    sensorChangeBufCount--;
+    sprintf(lcdString, "%.20s", "Sensor buf full.");
+    sendToLCD(lcdString);
+    Serial.println(lcdString);
+  }
+  sensorChangeBuf[sensorChangeBufHead].sensorNum = tSensorNum;
+  sensorChangeBuf[sensorChangeBufHead].changeType = tChangeType;
+  sensorChangeBuf[sensorChangeBufHead].captureMicros = tCaptureMicros;
+  sensorChangeBufHead = (sensorChangeBufHead + 1) % MAX_SENSOR_CHANGES_TO_BUF;
+  sensorChangeBufCount++;
+  return;
+}
+
+bool sensorChangeBufDequeue(sensorUpdateStruct * tSensorUpdate) {
+  // Rev: 10/19/26.  Retrieve the oldest record, if any, from the sensor change buffer.
+  // Returns 'false' if buffer is empty, and the passed parameter remains undefined.  Not fatal.
+  if (sensorChangeBufCount > 0) {
+    * tSensorUpdate = sensorChangeBuf[sensorChangeBufTail];
+    sensorChangeBufTail = (sensorChangeBufTail + 1) % MAX_SENSOR_CHANGES_TO_BUF;
+    sensorChangeBufCount--;
+    return true;
+  } else {
+    return false;  // Sensor change buffer is empty
+  }
+}
+
+void RS485fromSNStoMAS_SendSensorUpdate(const sensorUpdateStruct tSensorUpdate) {
+  // Rev: 10/19/26.  No longer pulls the request line and waits for A-MAS; loop() does that, and calls us once A-MAS has asked.
   // Release the REQ_TX_A_SNS "I have a message for you, A-MAS" digital line back to HIGH state...
   digitalWrite (PIN_REQ_TX_A_SNS_OUT, HIGH);
-  // Format and send the new status: Length, To, From, 'S', sensor number (byte), 0 if cleared or 1 if tripped, CRC
-  RS485MsgOutgoing[RS485_LEN_OFFSET] = 7;  // Byte 0.  Length is 7 bytes.
+  // Format and send the new status: Length, To, From, 'S', sensor number (byte), 0 if cleared or 1 if tripped, micros(), CRC
+  RS485MsgOutgoing[RS485_LEN_OFFSET] = 11;  // Byte 0.  Length is 11 bytes.
   RS485MsgOutgoing[RS485_TO_OFFSET] = ARDUINO_MAS;  // Byte 1.
   RS485MsgOutgoing[RS485_FROM_OFFSET] = ARDUINO_SNS;  // Byte 2.
   RS485MsgOutgoing[3] = 'S';   // 'S' for Sensor message.
-  RS485MsgOutgoing[4] = tSensorNum;  // Sensor number 1..52
-  RS485MsgOutgoing[5] = tChangeType;  // 0 if cleared, 1 if tripped
-  RS485MsgOutgoing[6] = calcChecksumCRC8(RS485MsgOutgoing, 6);  // CRC checksum
+  RS485MsgOutgoing[4] = tSensorUpdate.sensorNum;  // Sensor number 1..52
+  RS485MsgOutgoing[5] = tSensorUpdate.changeType;  // 0 if cleared, 1 if tripped
+  memcpy(RS485MsgOutgoing + 6, &tSensorUpdate.captureMicros, 4);  // Bytes 6..9.  When we saw the change, low byte first
+  RS485MsgOutgoing[10] = calcChecksumCRC8(RS485MsgOutgoing, 10);  // CRC checksum
   RS485SendMessage(RS485MsgOutgoing);
   return;
 }
 
+void RS485fromSNStoMAS_SendSnapshot() {
+  // Rev: 10/19/26.  A-MAS has asked for the status of every sensor.  Send our filtered state of all 64 sensors in one message.
+  // Any changes still waiting in the sensor change buffer are already reflected in the snapshot, so throw them away, and if we
+  // had asked A-MAS to request one of them, withdraw the request.
+  digitalWrite (PIN_REQ_TX_A_SNS_OUT, HIGH);
+  sensorAwaitingRequest = false;
+  sensorChangeBufHead  = 0;
+  sensorChangeBufTail  = 0;
+  sensorChangeBufCount = 0;
+  RS485MsgOutgoing[RS485_LEN_OFFSET] = 13;  // Byte 0.  Length is 13 bytes.
+  RS485MsgOutgoing[RS485_TO_OFFSET] = ARDUINO_MAS;  // Byte 1.
+  RS485MsgOutgoing[RS485_FROM_OFFSET] = ARDUINO_SNS;  // Byte 2.
+  RS485MsgOutgoing[3] = 'O';   // 'O' for Occupancy snapshot.
+  for (byte pinBank = 0; pinBank < 4; pinBank++) {   // Centipede bit 0 means tripped, but we send 1 = tripped
+    unsigned int occupied = ~sensorFilter.getState(pinBank);
+    RS485MsgOutgoing[4 + (pinBank * 2)] = lowByte(occupied);
+    RS485MsgOutgoing[5 + (pinBank * 2)] = highByte(occupied);
+  }
+  RS485MsgOutgoing[12] = calcChecksumCRC8(RS485MsgOutgoing, 12);  // CRC checksum
+  RS485SendMessage(RS485MsgOutgoing);
+  sensorTimeUpdatedMS = millis();    // Give everyone a moment to digest it before the next sensor change
+  sprintf(lcdString, "%.20s", "Sent snapshot.");
+  sendToLCD(lcdString);
+  Serial.println(lcdString);
+  return;
+}
+
 // ***************************************************************************
 // *** HERE ARE FUNCTIONS USED BY VIRTUALLY ALL ARDUINOS *** REV: 09-12-16 ***
 // ***************************************************************************
@@ -11,6 +11,17 @@ const byte THIS_MODULE = ARDUINO_SWT;  // Not sure if/where I will use this - in
 // This is an "INPUT-ONLY" module that does not provide data to any other Arduino.
 
 // IMPORTANT: LARGE AMOUNTS OF THIS CODE ARE IDENTIAL IN A-LED, SO ALWAYS UPDATE A-LED WHEN WE MAKE CHANGES TO THIS CODE.
+// 10/19/26: A real HALT now flushes the LCD before looping forever, so "HALT pin low!" is actually displayed.
+// 10/19/26: The FRAM1 layout check is now FramLayout::verify(), which also works on an 8K FRAM1 with the double-level tables.
+// 10/19/26: Relays for all turnouts in a pulse are set in the Centipede shadow and sent with one flush(), one I2C write per chip.
+// 10/19/26: At startup, confirm FRAM1 holds the Route and Park tables we were compiled for, and that no record is damaged.
+// 10/19/26: routeCacheInit() reads each FRAM1 route table as one stream instead of one SPI transaction per record.
+// 10/19/26: LCD text is now written by LCD2004.poll() each loop instead of inside send(), and flushed on fatal errors.
+// 10/19/26: A-SWT now keeps a shadow of each turnout's position (persisted in FRAM1 control block bytes 3..6) and drops
+//           commands that would not move a turnout.  A newer command for a turnout that is still in the buffer replaces it.
+// 10/19/26: Turnouts are now thrown up to TURNOUTS_PER_PULSE at a time, rather than strictly one at a time.
+// 10/19/26: Route, Park 1 and Park 2 tables are now decoded once at boot into touches/reverse bit masks, so a route command
+//           no longer needs an FRAM1 read and an atoi() per element; see routeCacheInit().
 // 07/19/18: Added F() macros to all Serial.print commands with literal text strings, saving 1 byte/char of RAM.
 // 04/22/18: Updating new global const, message and LCD display classes.
 // 09/16/17: Changed variable suffixes from Length to Len, No/Number to Num, Record to Rec, etc.
@@ -101,12 +112,14 @@ Centipede shiftRegister;                 // Instantiate Centipede shift register
 // Control buffer in each FRAM is first 128 bytes (address 0..127) reserved for any special purpose we want such as config info.
 #include <SPI.h>                                    // FRAM uses SPI communications
 #include "Hackscribble_Ferro.h"                     // FRAM library
+#include "FramLayout.h"       // Layout header and per-record CRCs of the FRAM1 tables, checked at startup
 const unsigned int FRAM_CONTROL_BUF_SIZE = 128;     // This defaults to 64 bytes in the library, but we modified it
 // FRAM1 stores the Route Reference, Park 1 Reference, and Park 2 Reference tables.
 // FRAM1 control block (first 128 bytes):
 // Address 0..2 (3 bytes)   = Version number month, date, year i.e. 07, 13, 16
-// Address 3..6 (4 bytes)   = Last known position of each turnout.  Bit 0 = Normal, 1 = Reverse.
+// Address 3..6 (4 bytes)   = Last known position of each turnout.  Bit 0 = Normal, 1 = Reverse.  A-SWT keeps its copy current in turnoutShadow.
 // Address 7..36 (30 bytes) = Last known train locations for train 1 thru 10: trainNum, blockNum, direction
+// Address 77..124 (48 bytes) = FramLayout header: layout version, and start/records/length/CRC address of each table
 byte               FRAM1ControlBuf[FRAM_CONTROL_BUF_SIZE];
 unsigned int       FRAM1BufSize             =   0;  // We will retrieve this via a function call, but it better be 128!
 unsigned long      FRAM1Bottom              =   0;  // Should be 128 (address 0..127)
@@ -130,6 +143,7 @@ const byte         FRAM1_PARK2_REC_LEN      =  52;  // Was 43 until 12/3/17
 const byte         FRAM1_PARK2_RECS         =   4;
 const byte         FRAM1_RECS_PER_PARK2     =   6;  // Max number of block/turnout records in a single Park 2 route in the route table.
 Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);   // Create the FRAM1 object!
+FramLayout         FRAM1Layout(&FRAM1);           // Describes the FRAM1 tables so we can check their CRCs; see checkFRAM1Layout()
 // Use the following code if we need a second FRAM memory module:
 // FRAM2 control block (first 128 bytes) contains no data - we don't need a version number because we don't have any initial data to read.
 // FRAM2 stores the Delayed Action table.  Table is 12 bytes per record, perhaps 400 records => approx. 5K bytes.
@@ -154,6 +168,10 @@ Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);   // Create the FRAM1 object!
 const byte MAX_TURNOUTS_TO_BUF            =  80;  // How many turnout commands might pile up before they can be executed?
 const unsigned long TURNOUT_ACTIVATION_MS = 110;  // How many milliseconds to hold turnout solenoids before releasing.
 const byte TOTAL_TURNOUTS                 =  32;  // Used to dimension our turnout_no/relay_no cross reference table.  30 connected, but 32 relays.
+// 10/19/26: TURNOUTS_PER_PULSE is how many solenoids we will energize at the same time, each for TURNOUT_ACTIVATION_MS.  Set it
+// according to how much current the turnout power supply can deliver; 1 gives the original one-at-a-time behavior.
+// An 8-turnout route takes about 8 / TURNOUTS_PER_PULSE pulses, and 'L' (32 turnouts) about 32 / TURNOUTS_PER_PULSE pulses.
+const byte TURNOUTS_PER_PULSE             =   4;  // Max number of turnout solenoids energized in a single pulse.
 /*
 #include <avr/wdt.h>     // Required to call wdt_reset() for watchdog timer for turnout solenoids  MOVED TO SWT FNS VARS CONST
 */
@@ -207,6 +225,18 @@ struct park2Reference {                 // Each record 52 bytes long, total of j
 };
 park2Reference park2Element;  // Use this to hold individual elements when retrieved
 
+// *** ROUTE TURNOUT CACHE...
+// 10/19/26: A-SWT only cares about the turnouts in each route, so at boot we decode every Route, Park 1, and Park 2 record into
+// a pair of 32-bit masks, bit 0 = turnout #1.  "Touches" has a 1 for every turnout in the route, "Reverse" has a 1 for every
+// turnout in the route that must be set Reverse.  8 bytes x (32 or 70) + 19 + 4 routes, so a route command becomes a table lookup.
+struct routeCacheStruct {
+  unsigned long touches;                // Bit = 1 if this route sets the turnout
+  unsigned long reverse;                // Bit = 1 if this route sets the turnout Reverse (only meaningful where touches is 1)
+};
+routeCacheStruct routeCache[FRAM1_ROUTE_RECS];
+routeCacheStruct park1Cache[FRAM1_PARK1_RECS];
+routeCacheStruct park2Cache[FRAM1_PARK2_RECS];
+
 // *** TURNOUT COMMAND BUFFER...
 // 09/19/17: Re-wrote per new circular buffer logic.
 // Create a circular buffer to store incoming RS485 "set turnout" commands from A-MAS.
@@ -222,7 +252,12 @@ turnoutCmdBufStruct turnoutCmdBuf[MAX_TURNOUTS_TO_BUF];
 char turnoutDirSingle;         // Globals to hold a single command/number pair.  'N' or 'R'
 byte turnoutNumSingle;         // 1..32
 
-bool turnoutClosed  = false;  // Keeps track if relay coil is currently energized, so we know to check if it should be released
+// 10/19/26: turnoutShadow holds the position we last threw each turnout to; bit 0 = turnout #1, 0 = Normal, 1 = Reverse.
+// It's loaded from our FRAM1 control block at boot and written back after every pulse, so it survives a restart.
+// turnoutCmdBufEnqueue() compares new commands against it (and against anything still in the buffer) to drop no-op commands.
+unsigned long turnoutShadow = 0;
+
+bool turnoutClosed  = false;  // Keeps track if any relay coil is currently energized, so we know to check if it should be released
 unsigned long turnoutActivationTime = millis();  // Keeps track of *when* a turnout coil was energized
 
 // *** TURNOUT CROSS REFERENCE...
@@ -259,6 +294,7 @@ void setup() {
   sprintf(lcdString, "FRAM1 Rev. %02i/%02i/%02i", FRAM1GotVersion[0], FRAM1GotVersion[1], FRAM1GotVersion[2]);  // FRAM1 version no. on LCD display
   LCD2004.send(lcdString);
   Serial.println(lcdString);
+  routeCacheInit();                     // Decode Route, Park 1, and Park 2 tables from FRAM1 into turnout bit masks
   wdtSetup();                           // Set up the watchdog timer to prevent solenoids from burning out
   
 }
@@ -271,6 +307,8 @@ void loop() {
 
   checkIfHaltPinPulledLow();  // If someone has pulled the Halt pin low, release relays and just stop
 
+  LCD2004.poll();  // Trickle any new LCD text out to the display; never waits.
+
   // See if we have an incoming RS485 message...
 //  if (Message.RS485GetMessage(msgIncoming)) {   // If returns true, then we got a complete RS485 message (may or may not be for us)
   if (Message.receive(msgIncoming)) {   // If returns true, then we got a complete RS485 message (may or may not be for us)
@@ -302,36 +340,15 @@ void loop() {
         sprintf(lcdString, "Route: %2i", msgIncoming[4]);
         LCD2004.send(lcdString);
         Serial.println(lcdString);
-        // Retrieve route number "routeNum" from Route Reference table (FRAM1) and create a new record in the
+        // Look up route number "routeNum" in the decoded Route cache and create a new record in the
         // turnout command buffer for each turnout in the route...
-        unsigned long FRAM1Address = FRAM1_ROUTE_START + ((routeNum - 1) * FRAM1_ROUTE_REC_LEN); // Rec # vs Route # offset by 1
-        byte b[FRAM1_ROUTE_REC_LEN];  // create a byte array to hold one Route Reference record
-        FRAM1.read(FRAM1Address, FRAM1_ROUTE_REC_LEN, b);  // (address, number_of_bytes_to_read, data
-        memcpy(&routeElement, b, FRAM1_ROUTE_REC_LEN);
-        for (byte j = 0; j < FRAM1_RECS_PER_ROUTE; j++) {   // There are up to FRAM1_RECS_PER_ROUTE turnout|block commands per route, look at each one
-          // If the first character is a 'T', then add this turnout to the command buffer.
-          // The first character could also be 'B' for Block; ignore those here.
-          if (routeElement.route[j][0] == 'T') {        // It's a 'T'urnout-type sub-record!
-            byte n = atoi(&routeElement.route[j][1]);   // Turnout number is stored as the 2nd and 3rd byte of the array record (followed by 'N' or 'R')
-            char d = routeElement.route[j][3];   // I.e. N or R
-            if ((d != 'R') && (d != 'N')) {   // Fatal error
-              sprintf(lcdString, "Bad route element!");
-              LCD2004.send(lcdString);
-              Serial.println(lcdString);
-              endWithFlashingLED(3);
-            }
-            sprintf(lcdString, "Route turnout %2i %c", n, d);
-            LCD2004.send(lcdString);
-            Serial.println(lcdString);
-            // Add this turnout command to the circular turnout command buffer...
-            turnoutCmdBufEnqueue(d, n);
-          } else if ((routeElement.route[j][0] != 'B') && (routeElement.route[j][0] != ' ')) {   // Not T, B, or blank = error
-            sprintf(lcdString, "%.20s", "Bad turnout rec!");
-            LCD2004.send(lcdString);
-            Serial.println(lcdString);
-            endWithFlashingLED(3);
-          }
+        if ((routeNum < 1) || (routeNum > FRAM1_ROUTE_RECS)) {   // Fatal error
+          sprintf(lcdString, "%.20s", "Bad route number!");
+          LCD2004.send(lcdString);
+          Serial.println(lcdString);
+          endWithFlashingLED(3);
         }
+        routeCacheEnqueue(routeCache[routeNum - 1]);   // Rec # vs Route # offset by 1
 
 //      } else if (msgIncoming[3] == '1') {    // 'Park 1' route command, so create a bunch of turnout commands...
       } else if (Message.getType(msgIncoming) == '1') {    // 'Park 1' route command, so create a bunch of turnout commands...
@@ -339,72 +356,26 @@ void loop() {
         sprintf(lcdString, "Park 1 route %2i", routeNum);
         LCD2004.send(lcdString);
         Serial.println(lcdString);
-        // Retrieve route number "routeNum" from Park 1 route Reference table (FRAM1) and create a new record in the
-        // turnout command buffer for every turnout in the route...
-        unsigned long FRAM1Address = FRAM1_PARK1_START + ((routeNum - 1) * FRAM1_PARK1_REC_LEN); // Rec # vs Route # offset by 1
-        byte b[FRAM1_PARK1_REC_LEN];  // create a byte array to hold one Route Reference record
-        FRAM1.read(FRAM1Address, FRAM1_PARK1_REC_LEN, b);  // (address, number_of_bytes_to_read, data
-        memcpy(&park1Element, b, FRAM1_PARK1_REC_LEN);
-        for (int j = 0; j < FRAM1_RECS_PER_PARK1; j++) {   // There are up to FRAM1_RECS_PER_PARK1 turnout|block commands per PARK1 route, look at each one
-          // If the first character is a 'T', then add this turnout to the command buffer.
-          // The first character could also be 'B' for Block; ignore those here.
-          if (park1Element.route[j][0] == 'T') {        // It's a 'T'urnout-type sub-record!
-            byte n = atoi(&park1Element.route[j][1]);   // Turnout number is stored as the 2nd and 3rd byte of the array record (followed by 'N' or 'R')
-            char d = park1Element.route[j][3];   // I.e. N or R
-            if ((d != 'R') && (d != 'N')) {   // Fatal error
-              sprintf(lcdString, "%.20s", "Bad Park 1 rec type!");
-              LCD2004.send(lcdString);
-              Serial.println(lcdString);
-              endWithFlashingLED(3);
-            }
-            sprintf(lcdString, "Park 1: %2i %c", n, d);
-            LCD2004.send(lcdString);
-            Serial.println(lcdString);
-            // Add this turnout command to the circular turnout command buffer...
-            turnoutCmdBufEnqueue(d, n);
-          } else if ((park1Element.route[j][0] != 'B') && (park1Element.route[j][0] != ' ')) {   // Not T, B, or blank = error
-            sprintf(lcdString, "ERR bad prk1 element");
-            LCD2004.send(lcdString);
-            Serial.println(lcdString);
-            endWithFlashingLED(3);
-          }
+        if ((routeNum < 1) || (routeNum > FRAM1_PARK1_RECS)) {   // Fatal error
+          sprintf(lcdString, "%.20s", "Bad Park 1 number!");
+          LCD2004.send(lcdString);
+          Serial.println(lcdString);
+          endWithFlashingLED(3);
         }
+        routeCacheEnqueue(park1Cache[routeNum - 1]);
 //      } else if (msgIncoming[3] == '2') {    // 'Park 2' route command, so create a bunch of turnout commands...
       } else if (Message.getType(msgIncoming) == '2') {    // 'Park 2' route command, so create a bunch of turnout commands...
         byte routeNum = msgIncoming[4];
         sprintf(lcdString, "Park 2 route %2i", routeNum);
         LCD2004.send(lcdString);
         Serial.println(lcdString);
-        // Retrieve route number "routeNum" from Park 2 route Reference table (FRAM1) and create a new record in the
-        // turnout command buffer for every turnout in the route...
-        unsigned long FRAM1Address = FRAM1_PARK2_START + ((routeNum - 1) * FRAM1_PARK2_REC_LEN); // Rec # vs Route # offset by 1
-        byte b[FRAM1_PARK2_REC_LEN];  // create a byte array to hold one Route Reference record
-        FRAM1.read(FRAM1Address, FRAM1_PARK2_REC_LEN, b);  // (address, number_of_bytes_to_read, data
-        memcpy(&park2Element, b, FRAM1_PARK2_REC_LEN);
-        for (int j = 0; j < FRAM1_RECS_PER_PARK2; j++) {   // There are up to FRAM1_RECS_PER_PARK2 turnout|block commands per PARK2 route, look at each one
-          // If the first character is a 'T', then add this turnout to the command buffer.
-          // The first character could also be 'B' for Block; ignore those here.
-          if (park2Element.route[j][0] == 'T') {        // It's a 'T'urnout-type sub-record!
-            byte n = atoi(&park2Element.route[j][1]);   // Turnout number is stored as the 2nd and 3rd byte of the array record (followed by 'N' or 'R')
-            char d = park2Element.route[j][3];   // I.e. N or R
-            if ((d != 'R') && (d != 'N')) {   // Fatal error
-              sprintf(lcdString, "Bad Park 2 rec type!");
-              LCD2004.send(lcdString);
-              Serial.println(lcdString);
-              endWithFlashingLED(3);
-            }
-            sprintf(lcdString, "Park 2: %2i %c", n, d);
-            LCD2004.send(lcdString);
-            Serial.println(lcdString);
-            // Add this turnout command to the circular turnout command buffer...
-            turnoutCmdBufEnqueue(d, n);
-          } else if ((park2Element.route[j][0] != 'B') && (park2Element.route[j][0] != ' ')) {   // Not T, B, or blank = error
-            sprintf(lcdString, "%.20s", "ERR bad park2 rec!");
-            LCD2004.send(lcdString);
-            Serial.println(lcdString);
-            endWithFlashingLED(3);
-          }
+        if ((routeNum < 1) || (routeNum > FRAM1_PARK2_RECS)) {   // Fatal error
+          sprintf(lcdString, "%.20s", "Bad Park 2 number!");
+          LCD2004.send(lcdString);
+          Serial.println(lcdString);
+          endWithFlashingLED(3);
         }
+        routeCacheEnqueue(park2Cache[routeNum - 1]);
 //      } else if (msgIncoming[3] == 'L') {    // Last-known-orientation command, so create a turnout command for each bit in next 4 bytes...
       } else if (Message.getType(msgIncoming) == 'L') {    // Last-known-orientation command, so create a turnout command for each bit in next 4 bytes...
         // i.e. 'L2395' = Set all 32 turnouts as indicated by bit pattern 2395.
@@ -445,9 +416,8 @@ void loop() {
       turnoutClosed = false;  // No longer energized, happy days.
     }
   } else {   // Only if relays are all open can we check for a new turnout command and potentially close a new relay
-    if (turnoutCmdBufProcess()) {    // Return of true means that we found a new turnout command in the buffer, and just energized a relay/solenoid...
-      turnoutClosed = true;
-      turnoutActivationTime = millis();
+    if (turnoutCmdBufProcess()) {    // Return of true means that we found new turnout command(s) in the buffer, and just energized relays/solenoids...
+      turnoutClosed = true;   // turnoutActivationTime was set when the first relay of the pulse was energized
     }
   }
 
@@ -494,6 +464,98 @@ void initializeShiftRegisterPins() {
   return;
 }
 
+void routeCacheInit() {
+  // Rev: 10/19/26.  Read every Route, Park 1, and Park 2 record from FRAM1 once, and decode the turnout elements of each into
+  // the touches/reverse bit masks in routeCache[], park1Cache[], and park2Cache[].  Block elements are ignored here.
+  // Any element that is not 'T', 'B', or blank, or a turnout that is not N or R or not 1..TOTAL_TURNOUTS, is a fatal error,
+  // same as when we used to decode each record on the fly -- only now we find out at boot rather than in the middle of a run.
+  // 10/19/26: Each table is now read as one FRAM1 stream (one opcode+address, then every record back to back.)  Nothing else
+  // may use SPI between beginRead() and endStream(), which is fine since we are only decoding into RAM.
+  FRAM1.beginRead(FRAM1_ROUTE_START, (unsigned long)FRAM1_ROUTE_RECS * FRAM1_ROUTE_REC_LEN);
+  for (byte i = 0; i < FRAM1_ROUTE_RECS; i++) {
+    byte b[FRAM1_ROUTE_REC_LEN];  // create a byte array to hold one Route Reference record
+    FRAM1.streamRead(FRAM1_ROUTE_REC_LEN, b);  // Next record from the stream
+    memcpy(&routeElement, b, FRAM1_ROUTE_REC_LEN);
+    if (!routeCacheDecode(routeElement.route, FRAM1_RECS_PER_ROUTE, &routeCache[i])) {
+      FRAM1.endStream();
+      sprintf(lcdString, "Bad route %2i element", i + 1);
+      LCD2004.send(lcdString);
+      Serial.println(lcdString);
+      endWithFlashingLED(3);
+    }
+  }
+  FRAM1.endStream();
+  FRAM1.beginRead(FRAM1_PARK1_START, (unsigned long)FRAM1_PARK1_RECS * FRAM1_PARK1_REC_LEN);
+  for (byte i = 0; i < FRAM1_PARK1_RECS; i++) {
+    byte b[FRAM1_PARK1_REC_LEN];
+    FRAM1.streamRead(FRAM1_PARK1_REC_LEN, b);
+    memcpy(&park1Element, b, FRAM1_PARK1_REC_LEN);
+    if (!routeCacheDecode(park1Element.route, FRAM1_RECS_PER_PARK1, &park1Cache[i])) {
+      FRAM1.endStream();
+      sprintf(lcdString, "Bad Park 1 %2i elemnt", i + 1);
+      LCD2004.send(lcdString);
+      Serial.println(lcdString);
+      endWithFlashingLED(3);
+    }
+  }
+  FRAM1.endStream();
+  FRAM1.beginRead(FRAM1_PARK2_START, (unsigned long)FRAM1_PARK2_RECS * FRAM1_PARK2_REC_LEN);
+  for (byte i = 0; i < FRAM1_PARK2_RECS; i++) {
+    byte b[FRAM1_PARK2_REC_LEN];
+    FRAM1.streamRead(FRAM1_PARK2_REC_LEN, b);
+    memcpy(&park2Element, b, FRAM1_PARK2_REC_LEN);
+    if (!routeCacheDecode(park2Element.route, FRAM1_RECS_PER_PARK2, &park2Cache[i])) {
+      FRAM1.endStream();
+      sprintf(lcdString, "Bad Park 2 %2i elemnt", i + 1);
+      LCD2004.send(lcdString);
+      Serial.println(lcdString);
+      endWithFlashingLED(3);
+    }
+  }
+  FRAM1.endStream();
+  return;
+}
+
+bool routeCacheDecode(const char tRoute[][5], const byte tRecsPer, routeCacheStruct * tCache) {
+  // Rev: 10/19/26.  Decode the tRecsPer 5-char block/turnout elements of one route (i.e. "T08R", "B03W") into bit masks.
+  // Turnout number is stored as the 2nd and 3rd chars of the element, followed by 'N' or 'R'.
+  // Returns false if any element is invalid; caller displays the fatal error.
+  tCache->touches = 0;
+  tCache->reverse = 0;
+  for (byte j = 0; j < tRecsPer; j++) {
+    if (tRoute[j][0] == 'T') {        // It's a 'T'urnout-type sub-record!
+      byte n = ((tRoute[j][1] - '0') * 10) + (tRoute[j][2] - '0');
+      char d = tRoute[j][3];   // I.e. N or R
+      if ((n < 1) || (n > TOTAL_TURNOUTS) || ((d != 'R') && (d != 'N'))) {
+        return false;
+      }
+      bitSet(tCache->touches, n - 1);
+      if (d == 'R') {
+        bitSet(tCache->reverse, n - 1);
+      } else {
+        bitClear(tCache->reverse, n - 1);   // In case a route lists the same turnout twice, last one wins, as before
+      }
+    } else if ((tRoute[j][0] != 'B') && (tRoute[j][0] != ' ')) {   // Not T, B, or blank = error
+      return false;
+    }
+  }
+  return true;
+}
+
+void routeCacheEnqueue(const routeCacheStruct tCache) {
+  // Rev: 10/19/26.  Add a turnout command to the turnout command buffer for every turnout touched by a decoded route.
+  for (byte i = 0; i < TOTAL_TURNOUTS; i++) {
+    if (bitRead(tCache.touches, i)) {
+      if (bitRead(tCache.reverse, i)) {
+        turnoutCmdBufEnqueue('R', i + 1);
+      } else {
+        turnoutCmdBufEnqueue('N', i + 1);
+      }
+    }
+  }
+  return;
+}
+
 bool turnoutCmdBufIsEmpty() {
   // Rev: 09/29/17
   return (turnoutCmdBufCount == 0);
@@ -506,9 +568,35 @@ bool turnoutCmdBufIsFull() {
 
 void turnoutCmdBufEnqueue(const char tTurnoutDir, const byte tTurnoutNum) {
 // 09/01/18: Change this to return true or false, if successful or not, and let someone else display the fatal error.
+  // Rev: 10/19/26.  Now drops commands that would not move the turnout, and supersedes a pending command for the same turnout.
   // Rev: 09/29/17.  Insert a record at the head of the turnout command buffer, then increment head and count.
   // If the buffer is already full, trigger a fatal error and terminate.
   // Although the two passed parameters are global, we are passing them for clarity.
+  // If there is already a command for this turnout in the buffer, we just change its direction in place -- or remove it, if
+  // the new direction is where the turnout already sits -- so each turnout appears in the buffer at most once.
+  // Otherwise, if the turnout is already in the requested position per turnoutShadow, there is nothing to do.
+  if ((tTurnoutNum < 1) || (tTurnoutNum > TOTAL_TURNOUTS) || ((tTurnoutDir != 'N') && (tTurnoutDir != 'R'))) {
+    sprintf(lcdString, "%.20s", "Bad turnout cmd!");
+    LCD2004.send(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(3);
+  }
+  char shadowDir = (bitRead(turnoutShadow, tTurnoutNum - 1) ? 'R' : 'N');
+  byte pendingIndex = turnoutCmdBufTail;
+  for (byte i = 0; i < turnoutCmdBufCount; i++) {
+    if (turnoutCmdBuf[pendingIndex].turnoutNum == tTurnoutNum) {   // Supersede the older pending command
+      if (tTurnoutDir == shadowDir) {
+        turnoutCmdBufRemove(pendingIndex);
+      } else {
+        turnoutCmdBuf[pendingIndex].turnoutDir = tTurnoutDir;
+      }
+      return;
+    }
+    pendingIndex = (pendingIndex + 1) % MAX_TURNOUTS_TO_BUF;
+  }
+  if (tTurnoutDir == shadowDir) {   // Already there, nothing to throw
+    return;
+  }
   if (!turnoutCmdBufIsFull()) {
     turnoutCmdBuf[turnoutCmdBufHead].turnoutDir = tTurnoutDir;  // Store the orientation Normal or Reverse
     turnoutCmdBuf[turnoutCmdBufHead].turnoutNum = tTurnoutNum;  // Store the turnout number 1..TOTAL_TURNOUTS
@@ -524,6 +612,21 @@ void turnoutCmdBufEnqueue(const char tTurnoutDir, const byte tTurnoutNum) {
   return;
 }
 
+void turnoutCmdBufRemove(const byte tIndex) {
+  // Rev: 10/19/26.  Remove the active record at array element tIndex, moving every newer record back one element to close the
+  // gap, then decrement head and count.  Order of the remaining records is preserved.
+  byte i = tIndex;
+  byte j = (i + 1) % MAX_TURNOUTS_TO_BUF;
+  while (j != turnoutCmdBufHead) {
+    turnoutCmdBuf[i] = turnoutCmdBuf[j];
+    i = j;
+    j = (j + 1) % MAX_TURNOUTS_TO_BUF;
+  }
+  turnoutCmdBufHead = i;
+  turnoutCmdBufCount--;
+  return;
+}
+
 bool turnoutCmdBufDequeue(char * tTurnoutDir, byte * tTurnoutNum) {
   // Rev: 09/29/17.  Retrieve a record, if any, from the turnout command buffer.
   // If the turnout command buffer is not empty, retrieves a record from the buffer, clears it, and puts the
@@ -544,12 +647,31 @@ bool turnoutCmdBufDequeue(char * tTurnoutDir, byte * tTurnoutNum) {
   }
 }
 
+bool turnoutCmdBufPeek(char * tTurnoutDir, byte * tTurnoutNum) {
+  // Rev: 10/19/26.  Same as turnoutCmdBufDequeue() except the record is left in the buffer.
+  // Returns 'false' if buffer is empty, and the passed parameters remain undefined.
+  if (!turnoutCmdBufIsEmpty()) {
+    * tTurnoutDir = turnoutCmdBuf[turnoutCmdBufTail].turnoutDir;
+    * tTurnoutNum = turnoutCmdBuf[turnoutCmdBufTail].turnoutNum;
+    return true;
+  } else {
+    return false;  // Turnout command buffer is empty
+  }
+}
+
 bool turnoutCmdBufProcess() {   // Special version for A-SWT, not the same as used by A-LED.
-  // Rev: 09/19/17.
-  // See if there is a record in the turnout command buffer, and if so, retrieve it and activate the relay/solenoid.
-  // Only closes relay; does not release.  Returns true if a relay was energized, false if no action taken.
-  if (turnoutCmdBufDequeue(&turnoutDirSingle, &turnoutNumSingle)) {   // Nothing previously activated, is there one to throw now?
-    // If function returned true, we have a new turnout to throw!
+  // Rev: 10/19/26.  Was one turnout per call; now up to TURNOUTS_PER_PULSE.
+  // See if there are records in the turnout command buffer, and if so, retrieve them and activate the relays/solenoids.
+  // Only closes relays; does not release.  Returns true if at least one relay was energized, false if no action taken.
+  // Commands are taken strictly in order, and we stop early if the next command is for a turnout already being thrown in this
+  // pulse, so we never energize both the Normal and Reverse coils of the same turnout at once, and the later command still wins.
+  unsigned long turnoutsThisPulse = 0;   // Bit = 1 for each turnout (bit 0 = turnout #1) energized in this pulse
+  byte turnoutsEnergized = 0;
+  while ((turnoutsEnergized < TURNOUTS_PER_PULSE) && (turnoutCmdBufPeek(&turnoutDirSingle, &turnoutNumSingle))) {
+    if (bitRead(turnoutsThisPulse, turnoutNumSingle - 1)) {   // Same turnout already in this pulse; leave it for the next one
+      break;
+    }
+    turnoutCmdBufDequeue(&turnoutDirSingle, &turnoutNumSingle);
     byte bitToWrite = 0;
     // Activate the turnout solenoid by turning on the relay coil connected to the Centipede shift register.
     // Use the cross-reference table I wrote for Relay Number vs Turnout N/R.
@@ -572,11 +694,25 @@ bool turnoutCmdBufProcess() {   // Special version for A-SWT, not the same as us
       Serial.println(lcdString);
       endWithFlashingLED(3);   // error!
     }
-    shiftRegister.digitalWrite(bitToWrite, LOW);  // turn on the relay
-    return true;    // So we will know that we need to turn it off
-  } else {   // We did not retrieve a new turnout throw command and thus did not activate a relay
-    return false;
+    shiftRegister.digitalWriteDeferred(bitToWrite, LOW);  // turn on the relay, when we flush() below
+    if (turnoutDirSingle == 'R') {
+      bitSet(turnoutShadow, turnoutNumSingle - 1);
+    } else {
+      bitClear(turnoutShadow, turnoutNumSingle - 1);
+    }
+    if (turnoutsEnergized == 0) {   // Time the pulse from the first coil, so no coil is held longer than TURNOUT_ACTIVATION_MS
+      turnoutActivationTime = millis();
+    }
+    bitSet(turnoutsThisPulse, turnoutNumSingle - 1);
+    turnoutsEnergized++;
+  }
+  if (turnoutsEnergized > 0) {
+    shiftRegister.flush();   // Energize this pulse's relays together, rather than a read and a write per relay
+    // Save the new turnout positions in case we are restarted
+    memcpy(FRAM1ControlBuf + 3, &turnoutShadow, sizeof(turnoutShadow));
+    FRAM1.writeControlBlock(FRAM1ControlBuf);
   }
+  return (turnoutsEnergized > 0);    // So we will know that we need to turn them off
 }
 
 void wdtSetup() {
@@ -662,7 +798,28 @@ void initializeFRAM1AndGetControlBlock() {
     }
   }
 
-  // A-MAS will also retrieve last-known-turnout and last-known-train positions from control block, but nobody else needs this.
+  checkFRAM1Layout();  // Fatal error if the tables are not what we expect, or any record is damaged
+
+  // A-MAS will also retrieve last-known-train positions from control block, but nobody else needs this.
+  // A-SWT keeps its own last-known-turnout positions, so it can skip commands for turnouts that are already set.
+  memcpy(&turnoutShadow, FRAM1ControlBuf + 3, sizeof(turnoutShadow));
+  return;
+}
+
+void checkFRAM1Layout() {
+  // Rev: 10/19/26.  Called by initializeFRAM1AndGetControlBlock() once the control block has been read.
+  // Populate_FRAM_Route_Reference stamps FRAM1 with a description of the Route, Park 1 and Park 2 tables and CRCs of their
+  // records.  FRAM1Layout.verify() checks that description matches our FRAM1_ constants (if not, FRAM1 was populated for a
+  // different layout, or before 10/19/26, and must be populated again), then reads every record and checks the CRCs, which takes
+  // a few tens of milliseconds.  If anything is wrong, lcdString says what.
+  FRAM1Layout.addTable(FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, FRAM1_ROUTE_REC_LEN, "Rte");
+  FRAM1Layout.addTable(FRAM1_PARK1_START, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN, "Pk1");
+  FRAM1Layout.addTable(FRAM1_PARK2_START, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN, "Pk2");
+  if (!FRAM1Layout.verify(FRAM1ControlBuf, "FRAM1", lcdString)) {
+    LCD2004.send(lcdString);
+    Serial.println(lcdString);
+    endWithFlashingLED(1);
+  }
   return;
 }
 
@@ -670,6 +827,7 @@ void endWithFlashingLED(int numFlashes) {
   // Rev 10/05/16: Version for Arduinos WITH relays that should be released (A-SWT turnouts, A-LEG accessories)
   initializeShiftRegisterPins();  // Release all relay coils that might be activating turnout solenoids
 
+  LCD2004.flush();  // Make sure the error message is actually on the LCD before we stop.
   requestEmergencyStop();
   while (true) {
     for (int i = 1; i <= numFlashes; i++) {
@@ -719,6 +877,7 @@ void checkIfHaltPinPulledLow() {
       sprintf(lcdString, "%.20s", "HALT pin low!  End.");
       LCD2004.send(lcdString);
       Serial.println(lcdString);
+      LCD2004.flush();  // Make sure the message is actually on the LCD before we stop.
       while (true) { }  // For a real halt, just loop forever.
     } else {
       sprintf(lcdString, "False HALT detected.");
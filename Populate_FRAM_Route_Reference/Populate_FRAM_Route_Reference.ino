@@ -16,6 +16,12 @@ byte FRAM2Version[3] = { 9, 16, 17 };  // Date will be placed in FRAM2 control b
 // Can be compiled to populate Route Reference, or Park 1 and Park 2 Reference.
 // Be sure to comment in or out, the COMPILE_ROUTE, COMPILE_PARK, and/or SINGLE_LEVEL define statements as appropriate.
 
+// 10/19/26: On an 8K FRAM, the double-level tables leave no room for a CRC per record, so FramLayout keeps one CRC-16 per
+//           table in the header instead.  Those are worked out from the tables themselves, so the header is stamped again
+//           once every table has been written.
+// 10/19/26: Also stamps the FRAM1 control block with a FramLayout header describing the three tables, and writes a CRC-8 of
+//           every record just past the Park 2 table, so the other modules can spot a stale or damaged FRAM1 at startup.
+//           The CRCs need one byte per record, 55 or 93 more bytes; double-level no longer fits on an 8K FRAM.
 // 12/03/17: Added Orig Town, Dest Town, Max Train Len, and Route Restrictions to Park 1 and Park 2 tables.  
 //           8K FRAM: Total used 8139 bytes of 8192 capacity.
 //           If we run out of FRAM in the future, due to a larger layout or even one more route, we can simply store the two
@@ -70,12 +76,14 @@ const byte PIN_FRAM2           = 12;  // FRAM2 used by A-LEG for Event Reference
 // Control buffer in each FRAM is first 128 bytes (address 0..127) reserved for any special purpose we want such as config info.
 #include <SPI.h>
 #include "Hackscribble_Ferro.h"
+#include "FramLayout.h"
 const unsigned int FRAM_CONTROL_BUF_SIZE = 128;  // This defaults to 64 bytes in the library, but we modified it
 // FRAM1 stores the Route Reference, Park 1 Reference, and Park 2 Reference tables.
 // FRAM1 control block (first 128 bytes):
 // Address 0..2 (3 bytes)   = Version number month, date, year i.e. 07, 13, 16
 // Address 3..6 (4 bytes)   = Last known position of each turnout.  Bit 0 = Normal, 1 = Reverse.
 // Address 7..36 (30 bytes) = Last known train locations for train 1 thru 10: trainNum, blockNum, direction
+// Address 77..124 (48 bytes) = FramLayout header: layout version, and start/records/length/CRC address of each table
 byte               FRAM1ControlBuf[FRAM_CONTROL_BUF_SIZE];
 unsigned int       FRAM1BufSize             =   0;  // We will retrieve this via a function call, but it better be 128!
 unsigned long      FRAM1Bottom              =   0;  // Should be 128 (address 0..127)
@@ -393,6 +401,12 @@ void setup() {
 //  Hackscribble_Ferro FRAM1(MB85RS2MT, PIN_FRAM1);   // Use digital pin 11 for FRAM #1 chip select
 //Hackscribble_Ferro   FRAM1(MB85RS2MT, PIN_FRAM1);   // Create the FRAM1 object!
 Hackscribble_Ferro   FRAM1(MB85RS2MT);   // Create the FRAM1 object!
+  // Describe the tables exactly as A-MAS, A-LED etc. will, so the header we write matches what they expect.  Table 0 = Route,
+  // 1 = Park 1, 2 = Park 2.  The record CRCs go right after the Park 2 table.
+  FramLayout FRAM1Layout(&FRAM1);
+  FRAM1Layout.addTable(FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, FRAM1_ROUTE_REC_LEN);
+  FRAM1Layout.addTable(FRAM1_PARK1_START, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN);
+  FRAM1Layout.addTable(FRAM1_PARK2_START, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN);
   
   int fStat = FRAM1.begin();
   if (fStat != 0)  // Any non-zero result is an error
@@ -462,6 +476,7 @@ Hackscribble_Ferro   FRAM1(MB85RS2MT);   // Create the FRAM1 object!
     {10, 1, 'E' }
   };
   memcpy(FRAM1ControlBuf + 7, &lastLocArray, sizeof(lastLocArray));    // Put the last-known-location table following the 3-byte version number, into the control block buffer
+  FRAM1Layout.setHeader(FRAM1ControlBuf);    // Bytes 77..124 describe the three tables and where their CRCs are
   Serial.println("Here are the contents of the control block after initializing with default data:");
   for (byte i = 0; i < 128; i++) {
     Serial.print(FRAM1ControlBuf[i]); Serial.print(" ");
@@ -509,6 +524,7 @@ Hackscribble_Ferro   FRAM1(MB85RS2MT);   // Create the FRAM1 object!
     byte b[FRAM1_ROUTE_REC_LEN];  // create a byte array to hold one Route Reference record
     memcpy(b, &routeArray[recordNo], FRAM1_ROUTE_REC_LEN);
     FRAM1.write(FRAMAddress, FRAM1_ROUTE_REC_LEN, b);  // (address, number_of_bytes_to_write, data    
+    FRAM1Layout.writeRecordCRC(0, recordNo, b);
   }
 
 #endif  // COMPILE_ROUTE
@@ -549,6 +565,7 @@ Hackscribble_Ferro   FRAM1(MB85RS2MT);   // Create the FRAM1 object!
     byte b[FRAM1_PARK1_REC_LEN];
     memcpy(b, &park1Array[recordNo], FRAM1_PARK1_REC_LEN);
     FRAM1.write(FRAMAddress, FRAM1_PARK1_REC_LEN, b);  // (address, number_of_bytes_to_write, data    
+    FRAM1Layout.writeRecordCRC(1, recordNo, b);
   }
 
   for (byte recordNo = 0; recordNo < FRAM1_PARK2_RECS; recordNo++) {
@@ -558,12 +575,39 @@ Hackscribble_Ferro   FRAM1(MB85RS2MT);   // Create the FRAM1 object!
     byte b[FRAM1_PARK2_REC_LEN];
     memcpy(b, &park2Array[recordNo], FRAM1_PARK2_REC_LEN);
     FRAM1.write(FRAMAddress, FRAM1_PARK2_REC_LEN, b);  // (address, number_of_bytes_to_write, data    
+    FRAM1Layout.writeRecordCRC(2, recordNo, b);
   }
 
 #endif   // COMPILE_PARK
 
   Serial.println("Done with writing the entire FRAM.");
 
+  // If FRAM1 only has room for a CRC per table (double-level on an 8K FRAM), setHeader() works them out from what's on FRAM1
+  // now, so stamp the header again.  Otherwise this writes the same header as before.
+  FRAM1.readControlBlock(FRAM1ControlBuf);
+  FRAM1Layout.setHeader(FRAM1ControlBuf);
+  FRAM1.writeControlBlock(FRAM1ControlBuf);
+
+  // Now run the same check the other modules will run at startup.  After just the COMPILE_ROUTE pass, every Park record will
+  // show as bad because its CRC hasn't been written yet; that's expected until the COMPILE_PARK pass has been run too.
+  FRAM1.readControlBlock(FRAM1ControlBuf);
+  Serial.print("FramLayout header check (should be 0): ");
+  Serial.println(FRAM1Layout.checkHeader(FRAM1ControlBuf));
+  framBadRecord badRec[10];
+  unsigned int badRecs = 0;
+  unsigned long scanStart = micros();
+  FRAM1Layout.scan(badRec, 10, &badRecs);
+  Serial.print("CRC scan took "); Serial.print(micros() - scanStart); Serial.print(" microseconds.  Bad records (should be 0): ");
+  Serial.println(badRecs);
+  for (byte i = 0; (i < badRecs) && (i < 10); i++) {
+    Serial.print("  Table "); Serial.print(badRec[i].table);
+    if (badRec[i].index == FRAM_LAYOUT_WHOLE_TABLE) {
+      Serial.println(", somewhere in the table");
+    } else {
+      Serial.print(", route "); Serial.println(badRec[i].index + 1);
+    }
+  }
+
   // Now display the entire table to the serial monitor, just for fun
   // NOTE: 7/13/16: With Serial.prints commented out, simply reading every element of all three tables into memory
   // took a grand total of 33 milliseconds -- .0033 seconds.  Wow!  That's a total of 93 records read from FRAM1.
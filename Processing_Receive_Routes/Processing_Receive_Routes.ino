@@ -3,8 +3,15 @@
 const byte FRAM1Version[3]    = {  8, 29, 19 };  // Date will be placed in FRAM1 control block as the first three bytes
       byte FRAM1GotVersion[3] = {  0,  0,  0 };  // This will hold the version retrieved from FRAM1, to confirm matches version above.
 
+// 10/19/26: The image for RECEIVE_IMAGE is built on the PC by RouteCompile (libraries/FramRoutes/extras/host) from a route
+//           file that it checks first, instead of being typed in as literal records.  See FramRoutes.h for the format.
+// 10/19/26: Added RECEIVE_IMAGE: take a whole FRAM1 image from FramSend (libraries/FramIngest/extras/host) as framed binary
+//           blocks, written straight into FRAM1, instead of parsing ASCII routes.  A full 256KB load takes seconds, not minutes,
+//           damaged blocks are simply sent again, and an interrupted load carries on where it stopped when FramSend is re-run.
+
 // not used #define PRINT_ROUTES  // Comment this out to receive routes
 //#define RECEIVE_ROUTES  // Comment this out to print routes
+//#define RECEIVE_IMAGE   // Receive a binary FRAM1 image from FramSend.  Takes priority over RECEIVE_ROUTES.
 
 //enum tType { LEFT, RIGHT }  // Left-hand or right-hand turnout TYPE (does not change, not related to current orientation Normal|Reverse
 //enum sType { OFF, CN, CR, DN, DR }  // Turnout route elements can be Converging|Diverging Normal|Reverse (OFF = unknown or n/a)
@@ -87,6 +94,9 @@ const          byte FRAM1_ROUTE_MAX_STEPS  =  40;  // The maximum number of step
 // Other than that, we use the standard library.  Specify the chip as MB85RS2MT (previously MB85RS64, and not MB85RS64V.)
 Hackscribble_Ferro FRAM1(MB85RS2MT, FRAM1_PIN);
 
+#include <FramLayout.h>   // FramIngest uses its CRC
+#include <FramIngest.h>
+
 
 // Create a "union" to swap between two individual bytes, and a 2-byte integer
 union {
@@ -163,7 +173,38 @@ void setup()
   //Serial.print("Memory top (should be 262143 for 256KB, or 8191 for 8KB): "); Serial.println(FRAM1Top);
   //Serial.println("Press Enter to initialize control block with all zeroes...");
 
-#ifdef RECEIVE_ROUTES
+#if defined(RECEIVE_IMAGE)
+
+  // Rev: 10/19/26.  See FramIngest.h for the protocol.  FramSend keeps offering the start frame until we answer, so it doesn't
+  // matter which of us starts first.  The LCD is only updated when poll() says a block was just written, because FramSend then
+  // waits for us; at any other time the 7ms of delays in sendToLCD() would overflow the serial buffer.
+  FramIngest FRAM1Ingest(&FRAM1, &Serial);
+  Serial.flush();
+  Serial.begin(FRAM_INGEST_BAUD);
+  sprintf(lcdString, "Image receive mode."); sendToLCD(lcdString);
+  while (Serial.available()) { Serial.read(); }
+  unsigned long startTime = millis();
+  while (true) {
+    framIngestState ingestState = FRAM1Ingest.poll();
+    if (ingestState == ingestBlockWritten) {
+      if ((FRAM1Ingest.getBlocksDone() % 64) == 1) {
+        sprintf(lcdString, "Block %4u of %4u", FRAM1Ingest.getBlocksDone(), FRAM1Ingest.getBlockCount());
+        sendToLCD(lcdString);
+      }
+    } else if (ingestState == ingestDone) {
+      sprintf(lcdString, "Image OK, %4u blks", FRAM1Ingest.getBlockCount());
+      sendToLCD(lcdString);
+      sprintf(lcdString, "Took %lu ms", millis() - startTime);
+      sendToLCD(lcdString);
+      while (true) { }
+    } else if (ingestState == ingestFailed) {
+      sprintf(lcdString, "Image error %i!", FRAM1Ingest.getError());
+      sendToLCD(lcdString);
+      while (true) { }
+    }
+  }
+
+#elif defined(RECEIVE_ROUTES)
 
   Serial.setTimeout(60000);  // Start this listening program first, then wait up to one minute for Processing program to begin transmitting.
   // First empty any junk in the incoming serial buffer...
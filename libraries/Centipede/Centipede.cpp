@@ -2,6 +2,9 @@
 // Controls MCP23017 16-bit digital I/O chips
 // This is the newer 8/28/12 version cleaned up by RDP on 10/14/17
 // This newer version supports interrupts by adding portInterrupts(), portCaptureRead(), and portIntPinConfig()
+// 10/19/26: Added portIntFlagRead() so we can tell which port(s) raised an interrupt without disturbing INTCAP.
+// 10/19/26: OLAT, IODIR and GPPU are shadowed in RAM and written from the shadow; see Centipede.h.
+// 10/19/26: portIntPinConfig() wrote drain to INTPOL and polarity to the unimplemented bit 0; now ODR and INTPOL.
 
 #if defined(ARDUINO) && ARDUINO >= 100
   #include "Arduino.h"
@@ -15,15 +18,32 @@ uint8_t CSDataArray[2] = {0};
 
 #define CSAddress 0b0100000
 
+// MCP23017 register addresses with IOCON.BANK = 0, which initialize() sets.  Each is the A half; B is the next address.
+#define CSRegIODIR 0x00
+#define CSRegGPPU  0x0C
+#define CSRegGPIO  0x12
+#define CSRegOLAT  0x14
+
 Centipede::Centipede()
 {
-  // no constructor tasks yet
+  // Shadows start out at the chip's power-on values, in case a sketch never calls initialize()
+  for (int j = 0; j < CSMaxPorts; j++) {
+    OLATShadow[j] = 0;
+    IODIRShadow[j] = 0xFFFF;
+    GPPUShadow[j] = 0;
+  }
+  OLATDirty = 0;
+  IODIRDirty = 0;
 }
 
 // Set device to default values
 void Centipede::initialize() {
 
-  for (int j = 0; j < 7; j++) {
+  for (int j = 0; j < CSMaxPorts; j++) {
+
+    OLATShadow[j] = 0;
+    IODIRShadow[j] = 0xFFFF;
+    GPPUShadow[j] = 0;
 
     CSDataArray[0] = 255;
     CSDataArray[1] = 255;
@@ -39,6 +59,19 @@ void Centipede::initialize() {
 
   }
 
+  OLATDirty = 0;
+  IODIRDirty = 0;
+
+}
+
+void Centipede::setBusClock(long hz) {
+
+#if defined(ARDUINO) && ARDUINO >= 10605
+  Wire.setClock(hz);
+#else
+  TWBR = ((F_CPU / hz) - 16) / 2;
+#endif
+
 }
 
 void Centipede::WriteRegisters(int port, int startregister, int quantity) {
@@ -96,25 +129,40 @@ void Centipede::WriteRegisterPin(int port, int regpin, int subregister, int leve
   
 }
 
+// Writes a whole 16-bit register pair from one of the shadows, in a single I2C transaction
+void Centipede::WriteShadow(int port, int startregister, uint16_t value) {
+
+  CSDataArray[0] = value;
+  CSDataArray[1] = value>>8;
+
+  WriteRegisters(port, startregister, 2);
+
+}
+
 void Centipede::pinMode(int pin, int mode) {
   
   int port = pin >> 4;
-  int subregister = (pin & 8) >> 3;
-
-  int regpin = pin - ((port << 1) + subregister)*8;
+  if ((port < 0) || (port >= CSMaxPorts)) return;
 
-  WriteRegisterPin(port, regpin, subregister, mode ^ 1);
+  pinModeDeferred(pin, mode);
+  WriteShadow(port, CSRegIODIR, IODIRShadow[port]);
+  IODIRDirty &= ~(1 << port);
   
 }
 
 void Centipede::pinPullup(int pin, int mode) {
   
   int port = pin >> 4;
-  int subregister = (pin & 8) >> 3;
+  if ((port < 0) || (port >= CSMaxPorts)) return;
 
-  int regpin = pin - ((port << 1) + subregister)*8;
+  if (mode == 0) {
+    GPPUShadow[port] &= ~(1 << (pin & 15));
+  }
+  else {
+    GPPUShadow[port] |= (1 << (pin & 15));
+  }
 
-  WriteRegisterPin(port, regpin, 0x0C + subregister, mode);
+  WriteShadow(port, CSRegGPPU, GPPUShadow[port]);
   
 }
 
@@ -122,20 +170,87 @@ void Centipede::pinPullup(int pin, int mode) {
 void Centipede::digitalWrite(int pin, int level) {
   
   int port = pin >> 4;
-  int subregister = (pin & 8) >> 3;
-
-  int regpin = pin - ((port << 1) + subregister)*8;
+  if ((port < 0) || (port >= CSMaxPorts)) return;
 
-  WriteRegisterPin(port, regpin, 0x12 + subregister, level);
+  digitalWriteDeferred(pin, level);
+  WriteShadow(port, CSRegOLAT, OLATShadow[port]);
+  OLATDirty &= ~(1 << port);
   
 }
 
+void Centipede::digitalWriteDeferred(int pin, int level) {
+
+  int port = pin >> 4;
+  if ((port < 0) || (port >= CSMaxPorts)) return;
+
+  if (level == 0) {
+    OLATShadow[port] &= ~(1 << (pin & 15));
+  }
+  else {
+    OLATShadow[port] |= (1 << (pin & 15));
+  }
+  OLATDirty |= (1 << port);
+
+}
+
+void Centipede::pinModeDeferred(int pin, int mode) {
+
+  int port = pin >> 4;
+  if ((port < 0) || (port >= CSMaxPorts)) return;
+
+  if ((mode ^ 1) == 0) {    // OUTPUT is 1 to Arduino but 0 to the chip
+    IODIRShadow[port] &= ~(1 << (pin & 15));
+  }
+  else {
+    IODIRShadow[port] |= (1 << (pin & 15));
+  }
+  IODIRDirty |= (1 << port);
+
+}
+
+void Centipede::flush() {
+
+  // Latches before direction, so a pin that becomes an output starts out at the level we asked for
+  for (int port = 0; port < CSMaxPorts; port++) {
+    if (OLATDirty & (1 << port)) {
+      WriteShadow(port, CSRegOLAT, OLATShadow[port]);
+    }
+  }
+  OLATDirty = 0;
+
+  for (int port = 0; port < CSMaxPorts; port++) {
+    if (IODIRDirty & (1 << port)) {
+      WriteShadow(port, CSRegIODIR, IODIRShadow[port]);
+    }
+  }
+  IODIRDirty = 0;
+
+}
+
+void Centipede::portWriteMasked(int port, int mask, int value) {
+
+  if ((port < 0) || (port >= CSMaxPorts)) return;
+
+  OLATShadow[port] = (OLATShadow[port] & ~mask) | (value & mask);
+  WriteShadow(port, CSRegOLAT, OLATShadow[port]);
+  OLATDirty &= ~(1 << port);
+
+}
+
+int Centipede::portLatch(int port) {
+
+  if ((port < 0) || (port >= CSMaxPorts)) return 0;
+
+  return OLATShadow[port];
+
+}
+
 int Centipede::digitalRead(int pin) {
 
   int port = pin >> 4;
   int subregister = (pin & 8) >> 3;
 
-  ReadRegisters(port, 0x12 + subregister, 1);
+  ReadRegisters(port, CSRegGPIO + subregister, 1);
 
   int returnval = (CSDataArray[0] >> (pin - ((port << 1) + subregister)*8)) & 1;
 
@@ -145,19 +260,23 @@ int Centipede::digitalRead(int pin) {
 
 void Centipede::portMode(int port, int value) {
   
-  CSDataArray[0] = value;
-  CSDataArray[1] = value>>8;
-  
-  WriteRegisters(port, 0x00, 2);
+  if ((port < 0) || (port >= CSMaxPorts)) return;
+
+  IODIRShadow[port] = value;
+  IODIRDirty &= ~(1 << port);
+
+  WriteShadow(port, CSRegIODIR, IODIRShadow[port]);
   
 }
 
 void Centipede::portWrite(int port, int value) {
   
-  CSDataArray[0] = value;
-  CSDataArray[1] = value>>8;
-  
-  WriteRegisters(port, 0x12, 2);
+  if ((port < 0) || (port >= CSMaxPorts)) return;
+
+  OLATShadow[port] = value;
+  OLATDirty &= ~(1 << port);
+
+  WriteShadow(port, CSRegOLAT, OLATShadow[port]);
   
 }
 
@@ -194,27 +313,41 @@ int Centipede::portCaptureRead(int port) {
 
 }
 
+int Centipede::portIntFlagRead(int port) {
+
+  // INTF: a bit is set for each pin that caused the pending interrupt.  Reading it does not clear the interrupt.
+  ReadRegisters(port, 0x0E, 2);
+
+  int receivedval = CSDataArray[0];
+  receivedval |= CSDataArray[1] << 8;
+
+  return receivedval;
+
+}
+
 void Centipede::portIntPinConfig(int port, int drain, int polarity) {
 
-  WriteRegisterPin(port, 1, 0x0A, drain);
-  WriteRegisterPin(port, 1, 0x0B, drain);
-  WriteRegisterPin(port, 0, 0x0A, polarity);
-  WriteRegisterPin(port, 0, 0x0B, polarity);
+  // IOCON bit 2 is ODR (1 = open drain, which overrides INTPOL) and bit 1 is INTPOL (1 = active HIGH).  Bit 0 is unimplemented.
+  WriteRegisterPin(port, 2, 0x0A, drain);
+  WriteRegisterPin(port, 2, 0x0B, drain);
+  WriteRegisterPin(port, 1, 0x0A, polarity);
+  WriteRegisterPin(port, 1, 0x0B, polarity);
 
 }
 
 void Centipede::portPullup(int port, int value) {
   
-  CSDataArray[0] = value;
-  CSDataArray[1] = value>>8;
-  
-  WriteRegisters(port, 0x0C, 2);
+  if ((port < 0) || (port >= CSMaxPorts)) return;
+
+  GPPUShadow[port] = value;
+
+  WriteShadow(port, CSRegGPPU, GPPUShadow[port]);
   
 }
 
 int Centipede::portRead(int port) {
 
-  ReadRegisters(port, 0x12, 2);
+  ReadRegisters(port, CSRegGPIO, 2);
 
   int receivedval = CSDataArray[0];
   receivedval |= CSDataArray[1] << 8;
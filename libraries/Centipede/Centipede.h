@@ -2,6 +2,13 @@
 // Controls MCP23017 16-bit digital I/O chips
 // This is the newer 8/28/12 version cleaned up by RDP on 10/14/17
 // This newer version supports interrupts by adding portInterrupts(), portCaptureRead(), and portIntPinConfig()
+// 10/19/26: Added portIntFlagRead() so we can tell which port(s) raised an interrupt without disturbing INTCAP.
+// 10/19/26: Output latch (OLAT), direction (IODIR) and pullup (GPPU) registers of all 8 chips are now shadowed in RAM, so
+//           digitalWrite(), pinMode() and pinPullup() are a single I2C write instead of a read followed by a write.
+//           Added digitalWriteDeferred()/pinModeDeferred() + flush() and portWriteMasked() to change many pins at once, and
+//           setBusClock() to run the I2C bus at CSFastI2C (400kHz) instead of the Wire default of 100kHz.
+//           initialize() now resets all 8 chips; it used to stop at 7.
+// 10/19/26: portIntPinConfig() now sets IOCON.ODR (drain) and IOCON.INTPOL (polarity); it used to set INTPOL and bit 0.
 
 #ifndef Centipede_h
 #define Centipede_h
@@ -12,6 +19,9 @@
 #include "WProgram.h"
 #endif
 
+#define CSMaxPorts 8        // Two Centipede boards of four chips each, I2C addresses 0x20..0x27
+#define CSFastI2C 400000L   // The MCP23017 is good to 1.7MHz, but 400kHz is the fastest the Mega's TWI runs reliably
+
 extern uint8_t CSDataArray[2];
 
 class Centipede
@@ -28,12 +38,33 @@ class Centipede
     int portRead(int port);
     void portInterrupts(int port, int gpintval, int defval, int intconval);
     int portCaptureRead(int port);
+    int portIntFlagRead(int port);
     void portIntPinConfig(int port, int drain, int polarity);
+    // drain 1 = INT pins open drain (active LOW, polarity ignored); 0 = push-pull, polarity 1 = active HIGH, 0 = active LOW.
     void initialize();
+
+    // Batched updates.  The Deferred functions only change the shadow copy and mark that chip as changed; nothing goes out on
+    // the bus until flush(), which writes each changed chip's OLAT and then its IODIR in one transaction apiece, however many
+    // of its pins were touched.  Any immediate write to a chip (digitalWrite(), portWrite(), etc.) also sends that chip's
+    // pending deferred changes, since it writes the whole 16-bit register from the shadow.
+    void digitalWriteDeferred(int pin, int level);
+    void pinModeDeferred(int pin, int mode);
+    void flush();
+    void portWriteMasked(int port, int mask, int value);  // Sets the outputs selected by mask to value, leaves the rest alone
+    int portLatch(int port);  // What we last told this chip to output, from the shadow; no I2C traffic
+    void setBusClock(long hz);  // Call after Wire.begin().  Wire.begin() puts the bus back to 100kHz.
+
   //private:
     void WriteRegisters(int port, int startregister, int quantity);
     void ReadRegisters(int port, int startregister, int quantity);
     void WriteRegisterPin(int port, int regpin, int subregister, int level);
+    void WriteShadow(int port, int startregister, uint16_t value);
+
+    uint16_t OLATShadow[CSMaxPorts];   // Last value written (or to be written by flush()) to each chip's output latches
+    uint16_t IODIRShadow[CSMaxPorts];  // Same for the direction registers; 1 = INPUT as on the chip
+    uint16_t GPPUShadow[CSMaxPorts];   // Same for the pullup registers
+    uint8_t OLATDirty;                 // Bit n set = chip n has deferred OLAT changes not yet sent by flush()
+    uint8_t IODIRDirty;                // Same for IODIR
 };
 
 #endif
@@ -0,0 +1,22 @@
+// Rev: 10/19/26
+// Host (Linux) stand-in for the little of Arduino.h that Centipede uses, so it can be built with g++ against the Wire mock in
+// this folder.  See Wire.h.  Never used by the Arduino IDE, which ignores everything under a library's extras folder.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT  0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#endif
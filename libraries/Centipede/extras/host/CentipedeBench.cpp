@@ -0,0 +1,147 @@
+// Rev: 10/19/26
+// CentipedeBench: how many I2C transactions our Centipede usage puts on the bus, measured against the Wire mock on a PC.
+// Build and run from the top of the repo:
+//   g++ -O2 -DARDUINO=10800 -I libraries/Centipede/extras/host -I libraries/Centipede -o CentipedeBench
+//       libraries/Centipede/extras/host/CentipedeBench.cpp libraries/Centipede/Centipede.cpp
+//       libraries/Centipede/extras/host/Wire.cpp
+//   ./CentipedeBench
+// "Read-modify-write" is what digitalWrite() and pinMode() did before 10/19/26: read the register, change one bit, write it
+// back.  WriteRegisterPin() still works that way, so calling it directly reproduces the old cost.
+// After every test the chips' registers are compared with Centipede's shadows, and the program fails if any differ.
+// It also checks that A-SNS's interrupt setup leaves IOCON with MIRROR and ODR set, so the four chips' INT pins can share a wire.
+
+#include "Wire.h"
+#include "Centipede.h"
+
+const byte CHIPS             =  8;  // Two Centipede boards, as on A-SWT, A-LEG and A-OCC
+const byte ROUTE_TURNOUTS    = 12;  // A typical route
+const byte TURNOUTS_PER_PULSE = 4;  // Same as A-SWT
+
+// Relay bits for the route's turnouts, from A-SWT's turnoutCrossRef[]: 1N 2R 3N 4R 5N 6R 17N 18R 19N 20R 21N 22R
+const byte ROUTE_RELAYS[ROUTE_TURNOUTS] = {15, 1, 13, 3, 11, 5, 79, 65, 77, 67, 75, 69};
+
+Centipede shiftRegister;
+
+void releaseAll() {
+  // Same as initializeShiftRegisterPins() in A-SWT
+  for (int i = 0; i < CHIPS; i++) {
+    shiftRegister.portWrite(i, 0b1111111111111111);
+    shiftRegister.portMode(i, 0b0000000000000000);
+  }
+}
+
+bool shadowsMatch(const char t_label[]) {
+  for (byte c = 0; c < CHIPS; c++) {
+    if ((Wire.chipRegister16(c, 0x14) != shiftRegister.OLATShadow[c]) ||
+        (Wire.chipRegister16(c, 0x00) != shiftRegister.IODIRShadow[c]) ||
+        (Wire.chipRegister16(c, 0x0C) != shiftRegister.GPPUShadow[c])) {
+      printf("%s: chip %i registers differ from the shadows!\n", t_label, c);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool throwRoute(const byte t_method) {
+  // 0 = read-modify-write per relay, 1 = digitalWrite() per relay, 2 = digitalWriteDeferred() and one flush() per pulse.
+  // Relays are released between pulses, as A-SWT does, but release isn't counted since it's the same every way.
+  const char * label[3] = {"Route, read-modify-write per relay", "Route, digitalWrite() per relay",
+                           "Route, deferred + flush() per pulse"};
+  wireMockStats total;
+  memset(&total, 0, sizeof(total));
+  for (byte first = 0; first < ROUTE_TURNOUTS; first = first + TURNOUTS_PER_PULSE) {
+    Wire.resetStats();
+    for (byte i = first; i < first + TURNOUTS_PER_PULSE; i++) {
+      int pin = ROUTE_RELAYS[i];
+      if (t_method == 0) {
+        shiftRegister.WriteRegisterPin(pin >> 4, pin & 7, 0x12 + ((pin & 8) >> 3), LOW);
+        shiftRegister.OLATShadow[pin >> 4] &= ~(1 << (pin & 15));  // So the check below still works
+      } else if (t_method == 1) {
+        shiftRegister.digitalWrite(pin, LOW);
+      } else {
+        shiftRegister.digitalWriteDeferred(pin, LOW);
+      }
+    }
+    if (t_method == 2) shiftRegister.flush();
+    if (!shadowsMatch(label[t_method])) return false;
+    wireMockStats s = Wire.getStats();
+    total.transactions = total.transactions + s.transactions;
+    total.writes = total.writes + s.writes;
+    total.reads = total.reads + s.reads;
+    total.busBytes = total.busBytes + s.busBytes;
+    total.microseconds = total.microseconds + s.microseconds;
+    releaseAll();
+  }
+  printf("%-44s %6lu trans (%5lu wr %5lu rd) %7lu bytes %10.1f us\n", label[t_method], total.transactions, total.writes,
+         total.reads, total.busBytes, total.microseconds);
+  return true;
+}
+
+int main() {
+  Wire.begin();
+  shiftRegister.initialize();
+  releaseAll();
+  if (!shadowsMatch("Startup")) return 1;
+
+  printf("--- 100kHz ---\n");
+  for (byte m = 0; m < 3; m++) {
+    if (!throwRoute(m)) return 1;
+  }
+
+  // Every output of both boards set one pin at a time, as a sketch walking a bit array would.
+  Wire.resetStats();
+  for (int pin = 0; pin < CHIPS * 16; pin++) {
+    shiftRegister.WriteRegisterPin(pin >> 4, pin & 7, 0x12 + ((pin & 8) >> 3), pin & 1);
+    shiftRegister.OLATShadow[pin >> 4] = (shiftRegister.OLATShadow[pin >> 4] & ~(1 << (pin & 15))) | ((pin & 1) << (pin & 15));
+  }
+  Wire.printStats("128 outputs, read-modify-write per pin");
+  if (!shadowsMatch("128 outputs, read-modify-write")) return 1;
+  releaseAll();
+  Wire.resetStats();
+  for (int pin = 0; pin < CHIPS * 16; pin++) {
+    shiftRegister.digitalWrite(pin, pin & 1);
+  }
+  Wire.printStats("128 outputs, digitalWrite() per pin");
+  if (!shadowsMatch("128 outputs, digitalWrite()")) return 1;
+  releaseAll();
+  Wire.resetStats();
+  for (int pin = 0; pin < CHIPS * 16; pin++) {
+    shiftRegister.digitalWriteDeferred(pin, pin & 1);
+  }
+  shiftRegister.flush();
+  Wire.printStats("128 outputs, deferred + one flush()");
+  if (!shadowsMatch("128 outputs, deferred")) return 1;
+  releaseAll();
+  Wire.resetStats();
+  for (int c = 0; c < CHIPS; c++) {
+    shiftRegister.portWriteMasked(c, 0b0000000011110000, 0b0000000001010000);
+  }
+  Wire.printStats("4 pins on each chip, portWriteMasked()");
+  if (!shadowsMatch("portWriteMasked()")) return 1;
+  releaseAll();
+
+  printf("--- 400kHz (setBusClock(CSFastI2C)) ---\n");
+  shiftRegister.setBusClock(CSFastI2C);
+  for (byte m = 0; m < 3; m++) {
+    if (!throwRoute(m)) return 1;
+  }
+
+  // Same as initializeSensorInterrupts() in A-SNS: mirrored, open-drain INT pins.  Both IOCON addresses must read 0b01000100
+  // (MIRROR and ODR); on the real chip they are the same register.
+  for (int i = 0; i < 4; i++) {
+    shiftRegister.portInterrupts(i, 0b1111111111111111, 0b0000000000000000, 0b0000000000000000);
+    shiftRegister.portIntPinConfig(i, 1, 0);
+    if (Wire.chipRegister16(i, 0x0A) != 0x4444) {
+      printf("Sensor interrupts: chip %i IOCON is 0x%04X, expected 0x4444 (MIRROR and ODR)!\n", i, Wire.chipRegister16(i, 0x0A));
+      return 1;
+    }
+  }
+  shiftRegister.portIntPinConfig(0, 0, 1);
+  if (Wire.chipRegister16(0, 0x0A) != 0x4242) {
+    printf("Push-pull active HIGH: chip 0 IOCON is 0x%04X, expected 0x4242 (MIRROR and INTPOL)!\n", Wire.chipRegister16(0, 0x0A));
+    return 1;
+  }
+
+  printf("Chip registers matched the shadows after every test, and IOCON was right.\n");
+  return 0;
+}
@@ -0,0 +1,170 @@
+// Rev: 10/19/26
+// Host (Linux) mock of the Arduino Wire library with MCP23017 chips on the bus.  See Wire.h.
+
+#include "Wire.h"
+
+// MCP23017 register addresses with IOCON.BANK = 0; each is the A half, and B is the next address
+const byte MCP_IODIR  = 0x00;
+const byte MCP_INTF   = 0x0E;
+const byte MCP_INTCAP = 0x10;
+const byte MCP_GPIO   = 0x12;
+const byte MCP_OLAT   = 0x14;
+
+TwoWire Wire;
+
+TwoWire::TwoWire() {
+  // Rev: 10/19/26.  Chips start at their power-on values: all pins inputs, everything else 0.
+  memset(m_register, 0, sizeof(m_register));
+  for (byte c = 0; c < WIRE_MOCK_CHIPS; c++) {
+    m_register[c][MCP_IODIR] = 0xFF;
+    m_register[c][MCP_IODIR + 1] = 0xFF;
+    m_inputs[c] = 0xFFFF;   // Nothing pulling an input low
+  }
+  memset(m_pointer, 0, sizeof(m_pointer));
+  m_present = 0xFF;
+  m_txAddress = -1;
+  m_txLen = 0;
+  m_rxLen = 0;
+  m_rxPos = 0;
+  m_clockHz = 100000;
+  m_overheadMicros = 10.0;
+  resetStats();
+}
+
+void TwoWire::begin() {
+  // Rev: 10/19/26.
+  m_clockHz = 100000;
+  return;
+}
+
+void TwoWire::setClock(uint32_t t_hz) {
+  // Rev: 10/19/26.
+  m_clockHz = t_hz;
+  return;
+}
+
+void TwoWire::beginTransmission(int t_address) {
+  // Rev: 10/19/26.
+  m_txAddress = t_address;
+  m_txLen = 0;
+  return;
+}
+
+size_t TwoWire::write(uint8_t t_data) {
+  // Rev: 10/19/26.  Like the real library, bytes are only buffered here and go out on endTransmission().
+  if (m_txLen >= WIRE_MOCK_BUFFER_LEN) return 0;
+  m_txBuf[m_txLen++] = t_data;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission() {
+  // Rev: 10/19/26.  Returns 0 if the chip acknowledged, 2 if nobody answered the address, as the real library does.
+  m_charge(1 + m_txLen);
+  m_stats.writes++;
+  int chip = m_txAddress - WIRE_MOCK_BASE_ADDRESS;
+  m_txAddress = -1;
+  if ((chip < 0) || (chip >= WIRE_MOCK_CHIPS) || !(m_present & (1 << chip))) return 2;
+  if (m_txLen == 0) return 0;
+  m_pointer[chip] = m_txBuf[0] % WIRE_MOCK_REGISTERS;
+  for (byte i = 1; i < m_txLen; i++) {
+    byte reg = m_pointer[chip];
+    if ((reg == MCP_GPIO) || (reg == MCP_GPIO + 1)) {   // Writing GPIO writes the output latch
+      reg = reg + (MCP_OLAT - MCP_GPIO);
+    }
+    if ((reg < MCP_INTF) || (reg > MCP_INTCAP + 1)) {   // INTF and INTCAP are read-only
+      m_register[chip][reg] = m_txBuf[i];
+    }
+    m_pointer[chip] = (m_pointer[chip] + 1) % WIRE_MOCK_REGISTERS;
+  }
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(int t_address, int t_quantity) {
+  // Rev: 10/19/26.  Reads start at the register the last write pointed at, as on the real chip.
+  if (t_quantity > WIRE_MOCK_BUFFER_LEN) t_quantity = WIRE_MOCK_BUFFER_LEN;
+  m_rxLen = 0;
+  m_rxPos = 0;
+  int chip = t_address - WIRE_MOCK_BASE_ADDRESS;
+  if ((chip < 0) || (chip >= WIRE_MOCK_CHIPS) || !(m_present & (1 << chip))) {
+    m_charge(1);
+    m_stats.reads++;
+    return 0;
+  }
+  m_charge(1 + t_quantity);
+  m_stats.reads++;
+  for (int i = 0; i < t_quantity; i++) {
+    byte reg = m_pointer[chip];
+    byte value = m_register[chip][reg];
+    if ((reg == MCP_GPIO) || (reg == MCP_GPIO + 1)) {   // Outputs read back the latch, inputs read the pin
+      byte half = reg - MCP_GPIO;
+      byte dir = m_register[chip][MCP_IODIR + half];
+      byte pins = m_inputs[chip] >> (8 * half);
+      value = (m_register[chip][MCP_OLAT + half] & ~dir) | (pins & dir);
+    }
+    m_rxBuf[m_rxLen++] = value;
+    m_pointer[chip] = (m_pointer[chip] + 1) % WIRE_MOCK_REGISTERS;
+  }
+  return m_rxLen;
+}
+
+int TwoWire::available() {
+  // Rev: 10/19/26.
+  return m_rxLen - m_rxPos;
+}
+
+int TwoWire::read() {
+  // Rev: 10/19/26.
+  if (m_rxPos >= m_rxLen) return -1;
+  return m_rxBuf[m_rxPos++];
+}
+
+wireMockStats TwoWire::getStats() {
+  // Rev: 10/19/26.
+  return m_stats;
+}
+
+void TwoWire::resetStats() {
+  // Rev: 10/19/26.
+  memset(&m_stats, 0, sizeof(m_stats));
+  return;
+}
+
+void TwoWire::printStats(const char t_label[]) {
+  // Rev: 10/19/26.
+  printf("%-44s %6lu trans (%5lu wr %5lu rd) %7lu bytes %10.1f us\n", t_label, m_stats.transactions, m_stats.writes,
+         m_stats.reads, m_stats.busBytes, m_stats.microseconds);
+  return;
+}
+
+void TwoWire::setOverheadMicros(const double t_micros) {
+  // Rev: 10/19/26.
+  m_overheadMicros = t_micros;
+  return;
+}
+
+void TwoWire::setPresent(const byte t_chipMask) {
+  // Rev: 10/19/26.
+  m_present = t_chipMask;
+  return;
+}
+
+void TwoWire::setInputs(const byte t_chip, const uint16_t t_value) {
+  // Rev: 10/19/26.
+  if (t_chip < WIRE_MOCK_CHIPS) m_inputs[t_chip] = t_value;
+  return;
+}
+
+uint16_t TwoWire::chipRegister16(const byte t_chip, const byte t_register) {
+  // Rev: 10/19/26.
+  if ((t_chip >= WIRE_MOCK_CHIPS) || (t_register + 1 >= WIRE_MOCK_REGISTERS)) return 0;
+  return m_register[t_chip][t_register] | (m_register[t_chip][t_register + 1] << 8);
+}
+
+void TwoWire::m_charge(const unsigned int t_bytes) {
+  // Rev: 10/19/26.  One START..STOP carrying t_bytes bytes (address included): 9 clocks a byte, plus about one clock each for
+  // the start and stop conditions.
+  m_stats.transactions++;
+  m_stats.busBytes = m_stats.busBytes + t_bytes;
+  m_stats.microseconds = m_stats.microseconds + (((t_bytes * 9) + 2) * 1000000.0 / m_clockHz) + m_overheadMicros;
+  return;
+}
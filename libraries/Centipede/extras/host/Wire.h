@@ -0,0 +1,83 @@
+// Rev: 10/19/26
+// Host (Linux) mock of the Arduino Wire library with up to eight MCP23017 chips on the bus, so the unmodified Centipede library
+// can run on a PC and we can count what each Centipede call puts on the I2C bus.
+// Each chip keeps its 22 registers (IOCON.BANK = 0 addressing, register pointer auto-incrementing as on the real chip), so a
+// program can check that what reached the chips is what it meant to send.  GPIO reads return OLAT for output pins and the
+// value set by setInputs() for input pins.  Writing GPIO writes OLAT, as on the real chip.  Interrupt registers are just stored.
+// Every transaction is charged modelled time: 9 SCL clocks per byte (address byte included) plus start and stop, at whatever
+// setClock() last set (100kHz after begin(), as on the Mega), plus a per-transaction software overhead.  The overhead default is
+// a rough estimate for the Mega's Wire library; change it with setOverheadMicros() if we measure a better one.
+// To build a host program (ARDUINO must be defined or Centipede.cpp looks for WProgram.h):
+//   g++ -DARDUINO=10800 -I libraries/Centipede/extras/host -I libraries/Centipede myprog.cpp
+//       libraries/Centipede/Centipede.cpp libraries/Centipede/extras/host/Wire.cpp
+// See CentipedeBench.cpp for an example.
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+const byte WIRE_MOCK_BASE_ADDRESS = 0x20;  // MCP23017 with A2..A0 all low
+const byte WIRE_MOCK_CHIPS        =    8;  // 0x20..0x27, as many as can share one bus
+const byte WIRE_MOCK_REGISTERS    = 0x16;  // IODIRA..OLATB
+const byte WIRE_MOCK_BUFFER_LEN   =   32;  // Same limit as the AVR Wire library
+
+struct wireMockStats {
+  unsigned long transactions;  // Each endTransmission() and each requestFrom() is one START..STOP on the bus
+  unsigned long writes;        // endTransmission()s
+  unsigned long reads;         // requestFrom()s
+  unsigned long busBytes;      // Every byte on the bus, address bytes included
+  double        microseconds;  // Modelled time on the bus
+};
+
+class TwoWire
+{
+  public:
+
+    TwoWire();
+
+    // The parts of the real Wire library that Centipede uses
+    void begin();
+    void setClock(uint32_t t_hz);
+    void beginTransmission(int t_address);
+    size_t write(uint8_t t_data);
+    uint8_t endTransmission();
+    uint8_t requestFrom(int t_address, int t_quantity);
+    int available();
+    int read();
+
+    // Mock only
+    wireMockStats getStats();
+    void resetStats();
+    void printStats(const char t_label[]);
+    // Prints one line of counts and modelled time to stdout, after t_label.
+    void setOverheadMicros(const double t_micros);
+    void setPresent(const byte t_chipMask);
+    // Bit n set = a chip answers at WIRE_MOCK_BASE_ADDRESS + n.  Default is all eight.  Others NACK, as a missing board would.
+    void setInputs(const byte t_chip, const uint16_t t_value);
+    uint16_t chipRegister16(const byte t_chip, const byte t_register);
+    // Register t_register (A half) and the next one (B half) of chip t_chip as one 16-bit value, B in the high byte.
+
+  private:
+
+    void m_charge(const unsigned int t_bytes);
+
+    byte m_register[WIRE_MOCK_CHIPS][WIRE_MOCK_REGISTERS];
+    byte m_pointer[WIRE_MOCK_CHIPS];   // Each chip's register address pointer
+    uint16_t m_inputs[WIRE_MOCK_CHIPS];
+    byte m_present;
+    int m_txAddress;
+    byte m_txBuf[WIRE_MOCK_BUFFER_LEN];
+    byte m_txLen;
+    byte m_rxBuf[WIRE_MOCK_BUFFER_LEN];
+    byte m_rxLen;
+    byte m_rxPos;
+    uint32_t m_clockHz;
+    double m_overheadMicros;
+    wireMockStats m_stats;
+
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -1,8 +1,12 @@
-// Rev: 07/14/18
+// Rev: 10/19/26
 // Display_2004 handles display of messages from the modules to the 20-char, 4-line (2004) Digole LCD display.
 
+// 10/19/26: No more delay() anywhere except flush().  send() just updates m_lineWanted[]; poll() compares it to m_lineShown[]
+// and trickles changed characters out to the LCD a few at a time.  The 30ms boot wait and 100ms post-clear wait that used to
+// be delay()s in the constructor are now states that poll() steps through.  So writing to the LCD no longer stalls the caller,
+// which matters because Message_RS485 logs from inside its send and receive paths.
 // 09/01/18: WARNING WARNING WARNING: The following constructor uses delay(), AND IT MUST NOT!  Replace with a
-// microsecond timer, which does work on Arduino pre-setup().
+// microsecond timer, which does work on Arduino pre-setup().  (Fixed 10/19/26, see above.)
 
 // Also, I think I prefer method 2.
 // Also, why not make this a parent/child relationship?  Although it "uses" and LCD display, rather than being "a kind of" LCD display...???
@@ -16,6 +20,14 @@
 
 #include "Display_2004.h"
 
+const byte LCD_STATE_BOOT            =    0;  // Waiting LCD_BOOT_MS for the LCD to boot before we clear it
+const byte LCD_STATE_CLEARING        =    1;  // Sent clearScreen(), waiting LCD_CLEAR_MS before sending text
+const byte LCD_STATE_READY           =    2;  // Normal operation
+const unsigned long LCD_BOOT_MS      =   30;  // About 15ms required to allow LCD to boot before clearing screen
+const unsigned long LCD_CLEAR_MS     =  100;  // At 115200 baud, needs > 90ms after CLS before sending text.
+const byte LCD_CHARS_PER_POLL        =    8;  // Most characters written by one poll(); about 15 bytes on the wire with position
+const unsigned long LCD_POLL_US      = 2000;  // Least time between writes.  15 bytes take 1.3ms at 115200, so TX never backs up.
+
 //Display_2004::Display_2004(HardwareSerial * t_hdwrSerial, long unsigned int t_baud) {  // Constructor for methods 1 or 2
 Display_2004::Display_2004(DigoleSerialDisp * t_digoleLCD) {  // Constructor using Method 3
 
@@ -66,9 +78,16 @@ Display_2004::Display_2004(DigoleSerialDisp * t_digoleLCD) {  // Constructor usi
   m_myLCD->setLCDColRow(LCD_WIDTH, 4);  // Maps starting RAM address on LCD (if other than 1602)
   m_myLCD->disableCursor();             // We don't need to see a cursor on the LCD
   m_myLCD->backLightOn();
-  delay(30);                           // About 15ms required to allow LCD to boot before clearing screen
-  m_myLCD->clearScreen();               // FYI, won't execute as the *first* LCD command
-  delay(100);                          // At 115200 baud, needs > 90ms after CLS before sending text.  No delay needed at 9600 baud.
+  // 10/19/26: The clearScreen() and the delays around it are now handled by poll(), starting in LCD_STATE_BOOT.
+  for (byte row = 0; row < 4; row++) {
+    memset(m_lineWanted[row], ' ', LCD_WIDTH);
+    m_lineWanted[row][LCD_WIDTH] = '\0';
+    strcpy(m_lineShown[row], m_lineWanted[row]);  // Blank is what the LCD will show after clearScreen()
+  }
+  m_state = LCD_STATE_BOOT;
+  m_stateMillis = millis();
+  m_lastWriteMicros = micros();
+  m_scanPos = 0;
   return;
 
 
@@ -90,6 +109,7 @@ Display_2004::Display_2004(DigoleSerialDisp * t_digoleLCD) {  // Constructor usi
 
 void Display_2004::send(const char t_nextLine[]) {
   // Display a line of information on the bottom line of the 2004 LCD display on the control panel, and scroll the old lines up.
+  // Rev 10/19/26: No longer writes to the LCD; see poll().
   // Rev 10/20/17: Converted to OOP and rolled Digole class into this class.
   // INPUTS: nextLine[] is a char array, must be less than 20 chars plus null or system will trigger fatal error.
   // The char arrays that hold the data are 21 bytes long, to allow for a 20-byte text message plus null terminator.
@@ -102,35 +122,80 @@ void Display_2004::send(const char t_nextLine[]) {
   //   sprintf(lcdString, "I %3i T %6lu C %3c", a, t, c);  Will also crash if longer than 20 chars!
   //   LCD.send(lcdString);   i.e. "I...7.T...3149.C...R"
 
-  // These static strings hold the current LCD display text.
-  static char lineA[21] = "                    ";  // Only 20 spaces because the compiler will
-  static char lineB[21] = "                    ";  // add a null at end for total 21 bytes.
-  static char lineC[21] = "                    ";
-  static char lineD[21] = "                    ";
   // If the incoming char array (string) is longer than the 21-byte array (20 chars plus null), then we will
   // have stepped on memory and must declare a fatal programming error.
   if ((t_nextLine == (char *)NULL) || (strlen(t_nextLine) > LCD_WIDTH)) endWithFlashingLED(13);
-  // Scroll all lines up to make room for the new bottom line.
-  strcpy(lineA, lineB);
-  strcpy(lineB, lineC);
-  strcpy(lineC, lineD);
-  strncpy(lineD, t_nextLine, LCD_WIDTH);         // Copy the new bottom line into lineD, padded to 20 chars with nulls.
-  int newLineLen = strlen(lineD);    // Get the length of the new bottom line (to the first null char.)
+  char newLine[LCD_WIDTH + 1];
+  strncpy(newLine, t_nextLine, LCD_WIDTH);       // Copy the new bottom line, padded to 20 chars with nulls.
+  newLine[LCD_WIDTH] = '\0';
+  int newLineLen = strlen(newLine);    // Get the length of the new bottom line (to the first null char.)
   // Pad the new bottom line with trailing spaces as needed.
-  while (newLineLen < LCD_WIDTH) lineD[newLineLen++] = ' ';  // Last byte not touched; always remains "null."
-  // Update the display.  Updated 10/28/16 by TimMe to add delays to fix rare random chars on display.
-  m_myLCD->setPrintPos(0, 0);
-  m_myLCD->print(lineA);
-  delay(1);
-  m_myLCD->setPrintPos(0, 1);
-  m_myLCD->print(lineB);
-  delay(2);
-  m_myLCD->setPrintPos(0, 2);
-  m_myLCD->print(lineC);
-  delay(3);
-  m_myLCD->setPrintPos(0, 3);
-  m_myLCD->print(lineD);
-  delay(1);
+  while (newLineLen < LCD_WIDTH) newLine[newLineLen++] = ' ';  // Last byte not touched; always remains "null."
+  // 10/19/26: If it's the same as what's already on the bottom line, don't scroll; a repeated message would just push
+  // everything else off the screen.
+  if (strcmp(newLine, m_lineWanted[3]) == 0) return;
+  // Scroll all lines up to make room for the new bottom line.  Only our copy changes here; poll() updates the LCD itself.
+  strcpy(m_lineWanted[0], m_lineWanted[1]);
+  strcpy(m_lineWanted[1], m_lineWanted[2]);
+  strcpy(m_lineWanted[2], m_lineWanted[3]);
+  strcpy(m_lineWanted[3], newLine);
+  return;
+
+}
+
+void Display_2004::poll() {
+  // Rev 10/19/26: Move the LCD one small step closer to m_lineWanted[], without ever waiting.
+  if (m_state == LCD_STATE_BOOT) {
+    if ((millis() - m_stateMillis) < LCD_BOOT_MS) return;
+    m_myLCD->clearScreen();               // FYI, won't execute as the *first* LCD command
+    m_state = LCD_STATE_CLEARING;
+    m_stateMillis = millis();
+    return;
+  }
+  if (m_state == LCD_STATE_CLEARING) {
+    if ((millis() - m_stateMillis) < LCD_CLEAR_MS) return;
+    m_state = LCD_STATE_READY;
+  }
+  if ((micros() - m_lastWriteMicros) < LCD_POLL_US) return;
+  writeChunk();
+  return;
+}
+
+void Display_2004::flush() {
+  // Rev 10/19/26: Blocking; write everything that's pending.  Only called when we're about to halt, so delay() is fine here.
+  while (m_state != LCD_STATE_READY) {
+    poll();
+    delay(1);
+  }
+  while (writeChunk()) {
+    delay(2);
+  }
   return;
+}
 
+bool Display_2004::writeChunk() {
+  // Rev 10/19/26: Starting where we left off last time, find the first character that differs between m_lineWanted[] and
+  // m_lineShown[], and write up to LCD_CHARS_PER_POLL characters from there (not past the end of that line) with a single
+  // setPrintPos() and print().  Returns false if the screen is already up to date, in which case nothing is sent.
+  for (byte i = 0; i < (LCD_WIDTH * 4); i++) {
+    byte pos = (m_scanPos + i) % (LCD_WIDTH * 4);
+    byte row = pos / LCD_WIDTH;
+    byte col = pos % LCD_WIDTH;
+    if (m_lineWanted[row][col] != m_lineShown[row][col]) {
+      char chunk[LCD_CHARS_PER_POLL + 1];
+      byte len = 0;
+      while ((len < LCD_CHARS_PER_POLL) && ((col + len) < LCD_WIDTH)) {
+        chunk[len] = m_lineWanted[row][col + len];
+        m_lineShown[row][col + len] = chunk[len];
+        len++;
+      }
+      chunk[len] = '\0';
+      m_myLCD->setPrintPos(col, row);
+      m_myLCD->print(chunk);
+      m_lastWriteMicros = micros();
+      m_scanPos = (pos + len) % (LCD_WIDTH * 4);
+      return true;
+    }
+  }
+  return false;
 }
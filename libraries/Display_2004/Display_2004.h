@@ -1,4 +1,4 @@
-// Rev: 07/14/18
+// Rev: 10/19/26
 // Display_2004 handles display of messages from the modules to the 20-char, 4-line (2004) Digole LCD display.
 
 // It simplifies use of the LCD display by encapsulating all of the initialization and scrolling logic within the class.
@@ -27,6 +27,16 @@ class Display_2004
     // send() scrolls the bottom 3 (of 4) lines up one line, and inserts the passed text into the bottom line of the LCD.
     // nextLine[] is a 20-byte max character string with a null terminator.
     // Sample call: sprintf(lcdString, "Bad Park 2 rec type!"); LCD.send(lcdString);
+    // 10/19/26: send() only updates our copy of the screen and returns at once; nothing goes to the LCD until poll().
+    // A line identical to the current bottom line is dropped rather than scrolled, so repeated messages don't flush the screen.
+
+    void poll();
+    // 10/19/26: poll() must be called every time through loop().  It writes at most LCD_CHARS_PER_POLL changed characters to
+    // the LCD, and no more often than every LCD_POLL_US, so the serial TX buffer never fills and poll() never waits.
+
+    void flush();
+    // 10/19/26: flush() writes everything still pending, waiting as long as it takes.  Only for use by endWithFlashingLED(),
+    // so the fatal error message is actually on the screen before we stop.
 
   protected:
 
@@ -36,6 +46,15 @@ class Display_2004
     // DigoleSerialDisp is the name of the 20x04 LCD class in DigoleSerial.h/.cpp.
     // So this pointer is how the Display_2004 object will send text to the LCD display.
 
+    bool writeChunk();  // Write the next run of changed characters, if any.  Returns false if the LCD is already up to date.
+
+    char m_lineWanted[4][LCD_WIDTH + 1];  // What send() wants the screen to say, top line first.
+    char m_lineShown[4][LCD_WIDTH + 1];   // What we have actually written to the LCD so far.
+    byte m_state;                         // LCD_STATE_BOOT, LCD_STATE_CLEARING, or LCD_STATE_READY (see .cpp)
+    unsigned long m_stateMillis;          // When m_state last changed
+    unsigned long m_lastWriteMicros;      // When writeChunk() last sent anything
+    byte m_scanPos;                       // 0..79: where writeChunk() resumes looking for differences
+
 };
 
 extern void endWithFlashingLED(int t_numFlashes); // This function must be in the main .ino calling program
@@ -0,0 +1,308 @@
+// Rev: 10/19/26
+// FramIngest receives a whole FRAM image from a PC over Serial, as framed binary blocks, and writes it straight into the FRAM.
+// See FramIngest.h.
+
+#include "FramIngest.h"
+#include "FramLayout.h"   // For crc8(), so our frames use the same CRC as everything else
+
+// Standard CRC-32 (reflected polynomial 0xEDB88320) of every possible 4-bit value.  Two lookups per byte is plenty fast for one
+// pass over the image, and the table is 64 bytes instead of 1K.
+const uint32_t FRAM_CRC32_TABLE[16] PROGMEM = {
+  0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+  0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+// Where things go in the progress record that stands in for the control block while an image is loading
+const byte FRAM_INGEST_PROGRESS_TAG   = 'I';  // Byte 1; byte 0 is FRAM_INGEST_MARKER
+const byte FRAM_INGEST_PROGRESS_LEN   =   2;  // Bytes 2..5: image length
+const byte FRAM_INGEST_PROGRESS_ID    =   6;  // Bytes 6..9: image ID
+const byte FRAM_INGEST_PROGRESS_DONE  =  10;  // Bytes 10..11: blocks done
+
+FramIngest::FramIngest(Hackscribble_Ferro * t_FRAM, Stream * t_port) {
+  // Rev: 10/19/26.
+  m_FRAM = t_FRAM;
+  m_port = t_port;
+  m_frameLen = 0;
+  m_lastByteTime = 0;
+  m_started = false;
+  m_replyPending = false;
+  m_imageLen = 0;
+  m_imageID = 0;
+  m_blockCount = 0;
+  m_blocksDone = 0;
+  m_state = ingestWaiting;
+  m_error = ingestOK;
+}
+
+framIngestState FramIngest::poll() {
+  // Rev: 10/19/26.
+  if ((m_state == ingestDone) || (m_state == ingestFailed)) return m_state;
+  if (m_replyPending) {   // Last poll() wrote a block; now let the PC have the next one
+    m_replyPending = false;
+    m_reply('A', m_nextBlock());
+  }
+  if ((m_frameLen > 0) && ((millis() - m_lastByteTime) > FRAM_INGEST_BYTE_TIMEOUT_MS)) {   // PC stopped part way through a frame
+    m_frameLen = 0;
+    if (m_started) {
+      m_reply('N', m_nextBlock());
+    } else {
+      m_reply('R', 0);
+    }
+  }
+  while (m_port->available() > 0) {
+    byte b = m_port->read();
+    if ((m_frameLen == 0) && (b != FRAM_INGEST_SOF)) continue;   // Hunting for the start of a frame
+    m_frame[m_frameLen++] = b;
+    m_lastByteTime = millis();
+    if (m_frameLen < FRAM_INGEST_HEADER_LEN) continue;
+    unsigned int payloadLen = m_frame[4] | (m_frame[5] << 8);
+    if (payloadLen > FRAM_INGEST_BLOCK_LEN) {   // Can't be a real header; that SOF was just a data byte, so keep hunting
+      m_frameLen = 0;
+      continue;
+    }
+    if (m_frameLen == (FRAM_INGEST_HEADER_LEN + payloadLen + 1)) {
+      m_handleFrame();
+      m_frameLen = 0;
+      if (m_replyPending) return ingestBlockWritten;   // Leave the rest of the input for next time
+      if (m_state != ingestWaiting) return m_state;
+    }
+  }
+  return ingestWaiting;
+}
+
+unsigned int FramIngest::getBlocksDone() {
+  // Rev: 10/19/26.
+  return m_blocksDone;
+}
+
+unsigned int FramIngest::getBlockCount() {
+  // Rev: 10/19/26.
+  return m_blockCount;
+}
+
+framIngestError FramIngest::getError() {
+  // Rev: 10/19/26.
+  return m_error;
+}
+
+uint32_t FramIngest::crc32(uint32_t t_crc, const byte t_data[], const unsigned int t_len) {
+  // Rev: 10/19/26.
+  t_crc = ~t_crc;
+  for (unsigned int i = 0; i < t_len; i++) {
+    t_crc = t_crc ^ t_data[i];
+    t_crc = (t_crc >> 4) ^ pgm_read_dword(&FRAM_CRC32_TABLE[t_crc & 0x0F]);
+    t_crc = (t_crc >> 4) ^ pgm_read_dword(&FRAM_CRC32_TABLE[t_crc & 0x0F]);
+  }
+  return ~t_crc;
+}
+
+void FramIngest::m_handleFrame() {
+  // Rev: 10/19/26.  m_frame[] holds one whole frame, CRC and all.
+  unsigned int crcPos = m_frameLen - 1;
+  if (m_frame[crcPos] != FramLayout::crc8(0, m_frame + 1, crcPos - 1)) {
+    if (m_started) {
+      m_reply('N', m_nextBlock());
+    } else {
+      m_reply('R', 0);
+    }
+  } else if (m_frame[1] == 'S') {
+    m_handleStart();
+  } else if ((m_frame[1] == 'B') && m_started) {
+    m_handleBlock();
+  } else if (m_frame[1] == 'B') {   // Block, but we don't know what image it belongs to
+    m_reply('R', 0);
+  } else if (m_started) {
+    m_reply('N', m_nextBlock());
+  } else {
+    m_reply('R', 0);
+  }
+  return;
+}
+
+void FramIngest::m_handleStart() {
+  // Rev: 10/19/26.  If the control block already holds a progress record for this same image, carry on where it left off.
+  if ((m_frame[4] | (m_frame[5] << 8)) != FRAM_INGEST_START_LEN) {
+    m_reply('R', 0);
+    return;
+  }
+  const byte * payload = m_frame + FRAM_INGEST_HEADER_LEN;
+  m_imageLen = 0;
+  m_imageID = 0;
+  for (byte i = 0; i < 4; i++) {
+    m_imageLen = m_imageLen | ((unsigned long)payload[i] << (8 * i));
+    m_imageID = m_imageID | ((uint32_t)payload[4 + i] << (8 * i));
+  }
+  if ((m_imageLen < FRAM_INGEST_CONTROL_LEN) || (m_imageLen > (m_FRAM->getTopAddress() + 1))) {
+    m_fail(ingestImageTooBig);
+    return;
+  }
+  m_blockCount = (m_imageLen + FRAM_INGEST_BLOCK_LEN - 1) / FRAM_INGEST_BLOCK_LEN;
+  byte controlBuf[FRAM_INGEST_CONTROL_LEN];
+  m_FRAM->readControlBlock(controlBuf);
+  unsigned long savedLen = 0;
+  uint32_t savedID = 0;
+  for (byte i = 0; i < 4; i++) {
+    savedLen = savedLen | ((unsigned long)controlBuf[FRAM_INGEST_PROGRESS_LEN + i] << (8 * i));
+    savedID = savedID | ((uint32_t)controlBuf[FRAM_INGEST_PROGRESS_ID + i] << (8 * i));
+  }
+  unsigned int savedDone = controlBuf[FRAM_INGEST_PROGRESS_DONE] | (controlBuf[FRAM_INGEST_PROGRESS_DONE + 1] << 8);
+  if ((controlBuf[0] == FRAM_INGEST_MARKER) && (controlBuf[1] == FRAM_INGEST_PROGRESS_TAG) && (savedLen == m_imageLen) &&
+      (savedID == m_imageID) && (savedDone < m_blockCount)) {
+    m_blocksDone = savedDone;
+  } else {
+    m_blocksDone = 0;
+    m_writeProgress();
+  }
+  m_started = true;
+  m_reply('A', m_nextBlock());
+  return;
+}
+
+void FramIngest::m_handleBlock() {
+  // Rev: 10/19/26.  Anything but the block we asked for (e.g. a repeat of one whose 'A' the PC missed) is just answered with
+  // the block we want.  Block 0 is always last: store all but its control block part, check the whole image, and only then
+  // replace our progress record with the real control block.
+  unsigned int seq = m_frame[2] | (m_frame[3] << 8);
+  unsigned int payloadLen = m_frame[4] | (m_frame[5] << 8);
+  if ((seq != m_nextBlock()) || (payloadLen != m_blockLen(seq))) {
+    m_reply('A', m_nextBlock());
+    return;
+  }
+  byte * payload = m_frame + FRAM_INGEST_HEADER_LEN;
+  framIngestError result;
+  if (seq != 0) {
+    result = m_writeBlock((unsigned long)seq * FRAM_INGEST_BLOCK_LEN, payload, payloadLen);
+    if (result != ingestOK) {
+      m_fail(result);
+      return;
+    }
+    m_blocksDone++;
+    m_writeProgress();
+    m_replyPending = true;
+    return;
+  }
+  if (payloadLen > FRAM_INGEST_CONTROL_LEN) {
+    result = m_writeBlock(FRAM_INGEST_CONTROL_LEN, payload + FRAM_INGEST_CONTROL_LEN, payloadLen - FRAM_INGEST_CONTROL_LEN);
+    if (result != ingestOK) {
+      m_fail(result);
+      return;
+    }
+  }
+  result = m_checkImage();
+  if (result != ingestOK) {
+    m_fail(result);
+    return;
+  }
+  m_FRAM->writeControlBlock(payload);
+  m_blocksDone++;
+  m_state = ingestDone;
+  m_reply('D', m_blockCount);
+  return;
+}
+
+framIngestError FramIngest::m_writeBlock(const unsigned long t_address, byte t_data[], const unsigned int t_len) {
+  // Rev: 10/19/26.  One write stream for the whole block, then read it back and compare.
+  ferroResult result = m_FRAM->beginWrite(t_address, t_len);
+  unsigned int done = 0;
+  while ((result == ferroOK) && (done < t_len)) {
+    byte len = 128;
+    if ((t_len - done) < 128) len = t_len - done;
+    result = m_FRAM->streamWrite(len, t_data + done);
+    done = done + len;
+  }
+  m_FRAM->endStream();
+  if (result != ferroOK) return ingestFRAMError;
+
+  byte chunk[FRAM_INGEST_CHUNK];
+  bool same = true;
+  result = m_FRAM->beginRead(t_address, t_len);
+  done = 0;
+  while ((result == ferroOK) && (done < t_len)) {
+    byte len = FRAM_INGEST_CHUNK;
+    if ((t_len - done) < FRAM_INGEST_CHUNK) len = t_len - done;
+    result = m_FRAM->streamRead(len, chunk);
+    if (memcmp(chunk, t_data + done, len) != 0) same = false;
+    done = done + len;
+  }
+  m_FRAM->endStream();
+  if (result != ferroOK) return ingestFRAMError;
+  if (!same) return ingestVerifyFailed;
+  return ingestOK;
+}
+
+framIngestError FramIngest::m_checkImage() {
+  // Rev: 10/19/26.  CRC-32 of the image as it now stands in FRAM, except that the control block part comes from block 0 in
+  // m_frame[], since the FRAM's control block still holds our progress record.
+  uint32_t crc = crc32(0, m_frame + FRAM_INGEST_HEADER_LEN, FRAM_INGEST_CONTROL_LEN);
+  unsigned long bytesLeft = m_imageLen - FRAM_INGEST_CONTROL_LEN;
+  ferroResult result = ferroOK;
+  if (bytesLeft > 0) {
+    byte chunk[FRAM_INGEST_CHUNK];
+    result = m_FRAM->beginRead(FRAM_INGEST_CONTROL_LEN, bytesLeft);
+    while ((result == ferroOK) && (bytesLeft > 0)) {
+      byte len = FRAM_INGEST_CHUNK;
+      if (bytesLeft < FRAM_INGEST_CHUNK) len = bytesLeft;
+      result = m_FRAM->streamRead(len, chunk);
+      crc = crc32(crc, chunk, len);
+      bytesLeft = bytesLeft - len;
+    }
+    m_FRAM->endStream();
+  }
+  if (result != ferroOK) return ingestFRAMError;
+  if (crc != m_imageID) return ingestImageCRCFailed;
+  return ingestOK;
+}
+
+void FramIngest::m_writeProgress() {
+  // Rev: 10/19/26.  Replaces the whole control block with our progress record.
+  byte controlBuf[FRAM_INGEST_CONTROL_LEN];
+  memset(controlBuf, 0, sizeof(controlBuf));
+  controlBuf[0] = FRAM_INGEST_MARKER;
+  controlBuf[1] = FRAM_INGEST_PROGRESS_TAG;
+  for (byte i = 0; i < 4; i++) {
+    controlBuf[FRAM_INGEST_PROGRESS_LEN + i] = (m_imageLen >> (8 * i)) & 0xFF;
+    controlBuf[FRAM_INGEST_PROGRESS_ID + i] = (m_imageID >> (8 * i)) & 0xFF;
+  }
+  controlBuf[FRAM_INGEST_PROGRESS_DONE] = m_blocksDone & 0xFF;
+  controlBuf[FRAM_INGEST_PROGRESS_DONE + 1] = m_blocksDone >> 8;
+  m_FRAM->writeControlBlock(controlBuf);
+  return;
+}
+
+unsigned int FramIngest::m_nextBlock() {
+  // Rev: 10/19/26.  Blocks are stored in the order 1, 2, ... m_blockCount - 1, then 0.
+  if (m_blocksDone < (m_blockCount - 1)) return m_blocksDone + 1;
+  return 0;
+}
+
+unsigned int FramIngest::m_blockLen(const unsigned int t_block) {
+  // Rev: 10/19/26.  Every block is full length except perhaps the last.
+  unsigned long start = (unsigned long)t_block * FRAM_INGEST_BLOCK_LEN;
+  if ((m_imageLen - start) < FRAM_INGEST_BLOCK_LEN) return m_imageLen - start;
+  return FRAM_INGEST_BLOCK_LEN;
+}
+
+void FramIngest::m_reply(const byte t_code, const unsigned int t_seq) {
+  // Rev: 10/19/26.
+  byte reply[FRAM_INGEST_REPLY_LEN];
+  reply[0] = FRAM_INGEST_SOF;
+  reply[1] = t_code;
+  reply[2] = t_seq & 0xFF;
+  reply[3] = t_seq >> 8;
+  reply[4] = FramLayout::crc8(0, reply + 1, 3);
+  m_port->write(reply, FRAM_INGEST_REPLY_LEN);
+  return;
+}
+
+void FramIngest::m_fail(const framIngestError t_error) {
+  // Rev: 10/19/26.  If the image came out wrong there's no telling which block is bad, so forget our progress and start over
+  // next time.  Otherwise the progress record stays, and the next run picks up where this one stopped.
+  m_error = t_error;
+  m_state = ingestFailed;
+  if (t_error == ingestImageCRCFailed) {
+    m_blocksDone = 0;
+    m_writeProgress();
+  }
+  m_reply('F', t_error);
+  return;
+}
@@ -0,0 +1,113 @@
+// Rev: 10/19/26
+// FramIngest receives a whole FRAM image from a PC over Serial, as framed binary blocks, and writes it straight into the FRAM.
+
+// Processing_Receive_Routes used to take the Route Reference table as ASCII text, one parseInt() or readBytes() per field, with a
+// one-minute timeout and a dead stop on any missing comma.  310 routes took minutes, and one dropped character meant starting over.
+// Now the PC builds the FRAM image (control block and all) and sends it with FramSend (see extras/host), and we just store it.
+// Protocol.  Everything is stop-and-wait: the PC sends one frame and waits for our one reply, so the Mega's 64-byte serial
+// buffer never overflows however long an FRAM write takes.
+//   Frame, PC to us:  SOF, type, sequence (2 bytes), payload length (2 bytes), payload, CRC.
+//     type 'S' = start: payload is the image length (4 bytes) and image ID (4 bytes); sequence is ignored.
+//     type 'B' = block: sequence is the block number; payload is image bytes (block * FRAM_INGEST_BLOCK_LEN) onward, a full
+//       FRAM_INGEST_BLOCK_LEN bytes except for the last block of an image whose length isn't a multiple of it.
+//   Reply, us to PC:  SOF, code, sequence (2 bytes), CRC.
+//     'A' = send block <sequence> next.  'N' = that frame was damaged or incomplete; send block <sequence>.
+//     'R' = we haven't had a start frame (we were probably reset); send one.  'D' = done, image stored and verified.
+//     'F' = failed; sequence is the framIngestError.
+//   Multi-byte numbers are low byte first.  The CRC is FramLayout::crc8() of everything after SOF.
+// We, not the PC, decide which block comes next, so resuming is automatic.  Blocks go in order 1, 2, ... last, and block 0,
+// which holds the control block, goes at the very end.  Until then the control block holds our progress record (see
+// FRAM_INGEST_MARKER) in place of the version date, so no module will accept a half-loaded FRAM, and if we're reset (or the PC
+// gives up) in the middle, the next start frame for the same image ID and length carries on from the next block we need.
+// The image ID is a CRC-32 of the whole image, worked out by the PC.  Before writing the control block we stream the whole image
+// back from the FRAM and check it against that CRC-32, and each block is also read back and compared as it is written.
+// Each block is one FRAM write stream of FRAM_INGEST_BLOCK_LEN bytes (apart from the control block in block 0.)
+// At FRAM_INGEST_BAUD a full 256KB MB85RS2MT image is 1,024 blocks and should take under 10 seconds: about 5.5 seconds on the
+// wire, the rest USB turnaround, FRAM, and the final check (see extras/host/FramIngestLoopback.cpp.)
+// Usage (see Processing_Receive_Routes):
+//   FramIngest ingest(&FRAM1, &Serial);
+//   Serial.begin(FRAM_INGEST_BAUD);
+//   then call ingest.poll() continuously until it returns ingestDone or ingestFailed.
+// poll() never blocks.  When it returns ingestBlockWritten, the block is safely in FRAM but the PC hasn't been told yet, and
+// won't send anything more until the next poll(), so that's the time to do anything slow such as updating the LCD.  Don't do
+// anything slow at any other time, or serial input will overflow while a frame is coming in.
+
+#ifndef FRAM_INGEST_H
+#define FRAM_INGEST_H
+
+#include "Arduino.h"
+#include "Hackscribble_Ferro.h"
+
+const long          FRAM_INGEST_BAUD             = 500000;  // Exact on a 16MHz Mega (U2X, UBRR = 3)
+const unsigned int  FRAM_INGEST_BLOCK_LEN        =    256;  // Image bytes per block
+const byte          FRAM_INGEST_SOF              =   0x7E;  // First byte of every frame and reply
+const byte          FRAM_INGEST_HEADER_LEN       =      6;  // SOF, type, sequence (2), payload length (2)
+const byte          FRAM_INGEST_REPLY_LEN        =      5;  // SOF, code, sequence (2), CRC
+const byte          FRAM_INGEST_START_LEN        =      8;  // Start frame payload: image length (4), image ID (4)
+const unsigned long FRAM_INGEST_BYTE_TIMEOUT_MS  =     50;  // A frame with a longer gap than this between bytes is abandoned
+const byte          FRAM_INGEST_MARKER           =   0xFF;  // Control block byte 0 while loading; never a valid month
+const byte          FRAM_INGEST_CHUNK            =     64;  // Bytes read back from FRAM at a time, for checking
+const byte          FRAM_INGEST_CONTROL_LEN      =    128;  // Control block size in our Hackscribble_Ferro; image bytes 0..127
+
+enum framIngestState {
+  ingestWaiting = 0,     // Nothing happening, or part way through receiving a frame
+  ingestBlockWritten,    // A block was just written and checked; the PC will be told on the next poll()
+  ingestDone,            // The whole image is in FRAM and checked; the control block has been written
+  ingestFailed           // Gave up; see getError().  The FRAM still holds our progress record, not a valid control block.
+};
+
+enum framIngestError {
+  ingestOK = 0,
+  ingestImageTooBig,     // Image is longer than the FRAM, or shorter than the control block
+  ingestFRAMError,       // The FRAM library returned an error
+  ingestVerifyFailed,    // A block read back from FRAM didn't match what we wrote
+  ingestImageCRCFailed   // The image in FRAM didn't match the PC's CRC-32; the load will start over next time
+};
+
+class FramIngest
+{
+  public:
+
+    FramIngest(Hackscribble_Ferro * t_FRAM, Stream * t_port);  // Constructor.  Touches neither the FRAM nor the port.
+
+    framIngestState poll();
+    // Reads whatever serial input is waiting and, if that completes a frame, acts on it.  See above.
+
+    unsigned int getBlocksDone();   // Blocks stored so far, including any done before a reset
+    unsigned int getBlockCount();   // Blocks in the image; 0 until we've had a start frame
+    framIngestError getError();
+
+    static uint32_t crc32(uint32_t t_crc, const byte t_data[], const unsigned int t_len);
+    // Continues the standard (zip/Ethernet) CRC-32 t_crc over t_len more bytes.  Start with 0.  The PC side uses this too, which
+    // is why it's uint32_t rather than unsigned long: on a PC that's 64 bits.
+
+  private:
+
+    void m_handleFrame();
+    void m_handleStart();
+    void m_handleBlock();
+    framIngestError m_writeBlock(const unsigned long t_address, byte t_data[], const unsigned int t_len);
+    framIngestError m_checkImage();
+    void m_writeProgress();
+    unsigned int m_nextBlock();
+    unsigned int m_blockLen(const unsigned int t_block);
+    void m_reply(const byte t_code, const unsigned int t_seq);
+    void m_fail(const framIngestError t_error);
+
+    Hackscribble_Ferro * m_FRAM;
+    Stream * m_port;
+    byte m_frame[FRAM_INGEST_HEADER_LEN + FRAM_INGEST_BLOCK_LEN + 1];  // One whole frame, CRC included
+    unsigned int m_frameLen;        // Bytes of m_frame[] received so far
+    unsigned long m_lastByteTime;   // millis() when the last byte of a partial frame arrived
+    bool m_started;                 // Had a start frame
+    bool m_replyPending;            // Block written; its 'A' goes out on the next poll()
+    unsigned long m_imageLen;
+    uint32_t m_imageID;
+    unsigned int m_blockCount;
+    unsigned int m_blocksDone;      // Blocks stored, in the order 1, 2, ... last, 0
+    framIngestState m_state;
+    framIngestError m_error;
+
+};
+
+#endif
@@ -0,0 +1,201 @@
+// Rev: 10/19/26
+// FramIngestLoopback: FramSender and FramIngest talking to each other over a pseudo-terminal pair on a Linux PC, with FramIngest
+// writing into an emulated MB85RS2MT, exactly as FramSend and Processing_Receive_Routes would over USB.
+// Build and run from the top of the repo:
+//   g++ -O2 -pthread -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramLayout
+//       -I libraries/FramIngest -I libraries/FramIngest/extras/host -o FramIngestLoopback
+//       libraries/FramIngest/extras/host/FramIngestLoopback.cpp libraries/FramIngest/extras/host/FramSender.cpp
+//       libraries/FramIngest/extras/host/HostSerial.cpp libraries/FramIngest/FramIngest.cpp
+//       libraries/FramLayout/FramLayout.cpp libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp
+//       libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp
+//   ./FramIngestLoopback
+// Exits 0 if every check passed.  After checking crc32() itself, three loads of a full 256KB image:
+//   1. With a damaged frame every so often, and the PC giving up part way; a second FramSender then has to carry on from where
+//      the first stopped, not from the beginning.
+//   2. With the "Mega" reset part way (a fresh FramIngest, as after a reset), which must also carry on.
+//   3. A clean load of a different image, which must start from block 1, for timing.
+// After each, the emulated FRAM must hold exactly the image.
+
+#include "FramSender.h"
+#include "FerroEmulator.h"
+#include "HostSerial.h"
+
+#include <atomic>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+const byte          PIN_FRAM1       = 53;
+const unsigned long IMAGE_LEN       = 262144;
+const unsigned int  CORRUPT_EVERY   = 97;    // Damage one block frame in this many
+const unsigned int  PC_STOPS_AFTER  = 400;   // Block frames the first FramSender sends before giving up
+const unsigned int  MEGA_RESETS_AT  = 700;   // Blocks done when the receiver is "reset"
+const long          BAUD            = FRAM_INGEST_BAUD;
+const double        USB_TURNAROUND_MS = 1.0;  // Rough USB latency per reply, for the estimate of time on a real Mega
+
+struct receiverJob {
+  Hackscribble_Ferro * FRAM;
+  int fd;
+  unsigned int resetAt;        // 0 = never
+  unsigned int resets;
+  framIngestState result;
+  framIngestError error;
+};
+
+std::atomic<bool> g_stopReceiver(false);
+
+void * receiverThread(void * t_job) {
+  // Plays the Mega: poll() continuously, as Processing_Receive_Routes does.
+  receiverJob * job = (receiverJob *)t_job;
+  HostSerial port(job->fd);
+  while (true) {
+    FramIngest ingest(job->FRAM, &port);
+    framIngestState state = ingestWaiting;
+    bool reset = false;
+    while ((state != ingestDone) && (state != ingestFailed) && !g_stopReceiver) {
+      state = ingest.poll();
+      if ((state == ingestBlockWritten) && (job->resetAt > 0) && (ingest.getBlocksDone() == job->resetAt)) {
+        reset = true;   // Block is written but never acknowledged, as if the reset came right then
+        break;
+      }
+    }
+    if (!reset) {
+      job->result = state;
+      job->error = ingest.getError();
+      return NULL;
+    }
+    job->resetAt = 0;
+    job->resets++;
+    usleep(200000);   // Bootloader
+  }
+}
+
+void makeImage(byte t_image[], unsigned long t_seed) {
+  // Pseudo-random contents, with something like a real control block in front
+  unsigned long x = t_seed;
+  for (unsigned long i = 0; i < IMAGE_LEN; i++) {
+    x = (x * 1103515245UL) + 12345UL;
+    t_image[i] = (x >> 16) & 0xFF;
+  }
+  memset(t_image, 0, 128);
+  t_image[0] = 10;
+  t_image[1] = 19;
+  t_image[2] = 26;
+  t_image[71] = 310 & 0xFF;
+  t_image[72] = 310 >> 8;
+}
+
+bool startReceiver(pthread_t * t_thread, receiverJob * t_job) {
+  g_stopReceiver = false;
+  return (pthread_create(t_thread, NULL, receiverThread, t_job) == 0);
+}
+
+bool check(const char t_label[], const bool t_ok) {
+  printf("%-60s %s\n", t_label, t_ok ? "OK" : "FAILED");
+  return t_ok;
+}
+
+void printSend(const char t_label[], const framSendStats & t_stats) {
+  printf("  %s: first block %u, %lu block frames, %lu start frames, %lu NAKs, %lu timeouts, %.2f s\n", t_label,
+         t_stats.firstBlock, t_stats.blockFrames, t_stats.startFrames, t_stats.naks, t_stats.timeouts, t_stats.seconds);
+}
+
+int main() {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0)) {
+    printf("Can't create a pseudo-terminal.\n");
+    return 1;
+  }
+  int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+  if ((slave < 0) || !FramSender::setRaw(master, BAUD) || !FramSender::setRaw(slave, BAUD)) {
+    printf("Can't set up the pseudo-terminal.\n");
+    return 1;
+  }
+
+  unlink("FramIngestLoopback.bin");
+  FerroEmulator FRAM1Chip(MB85RS2MT, PIN_FRAM1, "FramIngestLoopback.bin");
+  if (!FRAM1Chip.isOpen()) {
+    printf("Couldn't open the FRAM image file.\n");
+    return 1;
+  }
+  Hackscribble_Ferro FRAM1(MB85RS2MT, PIN_FRAM1);
+  if (FRAM1.begin() != ferroOK) {
+    printf("FRAM begin() failed.\n");
+    return 1;
+  }
+
+  byte * image = (byte *)malloc(IMAGE_LEN);
+  bool allOK = true;
+  allOK &= check("FramIngest::crc32() gives the standard check value", FramIngest::crc32(0, (const byte *)"123456789", 9) ==
+                 0xCBF43926UL);
+  pthread_t thread;
+  receiverJob job;
+  memset(&job, 0, sizeof(job));
+  job.FRAM = &FRAM1;
+  job.fd = slave;
+  framSendStats stats;
+
+  // *** 1. Damaged frames, and the PC gives up part way and is run again.
+  makeImage(image, 1);
+  startReceiver(&thread, &job);
+  FramSender firstTry(master);
+  firstTry.setCorruptEvery(CORRUPT_EVERY);
+  firstTry.setStopAfter(PC_STOPS_AFTER);
+  bool ok = firstTry.send(image, IMAGE_LEN, &stats);
+  printSend("first FramSender", stats);
+  allOK &= check("1. First FramSender stops part way", !ok);
+  unsigned long naks = stats.naks;
+  FramSender secondTry(master);
+  secondTry.setCorruptEvery(CORRUPT_EVERY);
+  ok = secondTry.send(image, IMAGE_LEN, &stats);
+  printSend("second FramSender", stats);
+  g_stopReceiver = true;
+  pthread_join(thread, NULL);
+  naks = naks + stats.naks;
+  allOK &= check("1. Second FramSender finishes", ok && (job.result == ingestDone));
+  allOK &= check("1. Second FramSender carries on where the first stopped", stats.firstBlock > (PC_STOPS_AFTER / 2));
+  allOK &= check("1. Damaged frames were NAKed", naks > 0);
+  allOK &= check("1. FRAM holds the image", memcmp(FRAM1Chip.memory(), image, IMAGE_LEN) == 0);
+
+  // *** 2. The Mega is reset part way.
+  makeImage(image, 2);
+  job.resetAt = MEGA_RESETS_AT;
+  job.resets = 0;
+  startReceiver(&thread, &job);
+  FramSender resetTry(master);
+  ok = resetTry.send(image, IMAGE_LEN, &stats);
+  printSend("FramSender", stats);
+  g_stopReceiver = true;
+  pthread_join(thread, NULL);
+  allOK &= check("2. Load finishes after the reset", ok && (job.result == ingestDone) && (job.resets == 1));
+  allOK &= check("2. No block was sent twice, not even the unacknowledged one",   // Its progress was saved before the reset
+                 stats.blockFrames == stats.blockCount);
+  allOK &= check("2. FRAM holds the image", memcmp(FRAM1Chip.memory(), image, IMAGE_LEN) == 0);
+
+  // *** 3. Clean load of a new image, for timing.
+  makeImage(image, 3);
+  FRAM1Chip.resetStats();
+  startReceiver(&thread, &job);
+  FramSender cleanTry(master);
+  ok = cleanTry.send(image, IMAGE_LEN, &stats);
+  printSend("FramSender", stats);
+  g_stopReceiver = true;
+  pthread_join(thread, NULL);
+  allOK &= check("3. Load finishes", ok && (job.result == ingestDone));
+  allOK &= check("3. A different image starts from block 1", stats.firstBlock == 1);
+  allOK &= check("3. FRAM holds the image", memcmp(FRAM1Chip.memory(), image, IMAGE_LEN) == 0);
+  FRAM1Chip.printStats("  FRAM1 during the clean load");
+  double serialSeconds = ((stats.bytesSent + stats.bytesReceived) * 10.0) / BAUD;
+  double megaSeconds = serialSeconds + (stats.blockFrames * USB_TURNAROUND_MS / 1000.0) +
+                       (FRAM1Chip.getStats().microseconds / 1e6);
+  printf("  Estimated on a Mega at %li baud: %.1f s serial + %.1f s USB turnaround + %.2f s FRAM = %.1f s,\n", BAUD,
+         serialSeconds, stats.blockFrames * USB_TURNAROUND_MS / 1000.0, FRAM1Chip.getStats().microseconds / 1e6, megaSeconds);
+  printf("  plus the CRC-32 arithmetic of the final check, which the emulator doesn't time.\n");
+
+  free(image);
+  close(slave);
+  close(master);
+  unlink("FramIngestLoopback.bin");
+  printf(allOK ? "All checks passed.\n" : "SOME CHECKS FAILED.\n");
+  return allOK ? 0 : 1;
+}
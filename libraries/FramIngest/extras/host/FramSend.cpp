@@ -0,0 +1,69 @@
+// Rev: 10/19/26
+// FramSend: sends an FRAM image file to a Mega running Processing_Receive_Routes (with RECEIVE_IMAGE defined) or anything else
+// that uses FramIngest.  See FramIngest.h.
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramLayout
+//       -I libraries/FramIngest -o FramSend libraries/FramIngest/extras/host/FramSend.cpp
+//       libraries/FramIngest/extras/host/FramSender.cpp libraries/FramIngest/FramIngest.cpp libraries/FramLayout/FramLayout.cpp
+//       libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp
+//   (FramSend only uses the CRC functions from those last four, but they come as a set.)
+// Run:
+//   ./FramSend /dev/ttyACM0 FRAM1.bin [baud]
+// baud defaults to FRAM_INGEST_BAUD and must match the sketch.  The image is the whole FRAM from address 0, control block
+// included; it may be shorter than the FRAM.  Opening the port resets the Mega, which is fine: we keep sending the start
+// frame until it answers.
+
+#include "FramSender.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+int main(int argc, char * argv[]) {
+  if (argc < 3) {
+    printf("Usage: FramSend <serial port> <image file> [baud]\n");
+    return 1;
+  }
+  long baud = (argc > 3) ? atol(argv[3]) : FRAM_INGEST_BAUD;
+
+  FILE * f = fopen(argv[2], "rb");
+  if (f == NULL) {
+    printf("Can't open %s.\n", argv[2]);
+    return 1;
+  }
+  fseek(f, 0, SEEK_END);
+  long len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  byte * image = (byte *)malloc(len > 0 ? len : 1);
+  if ((len <= 0) || (fread(image, 1, len, f) != (size_t)len)) {
+    printf("Can't read %s.\n", argv[2]);
+    return 1;
+  }
+  fclose(f);
+
+  int fd = open(argv[1], O_RDWR | O_NOCTTY);
+  if (fd < 0) {
+    printf("Can't open %s.\n", argv[1]);
+    return 1;
+  }
+  if (!FramSender::setRaw(fd, baud)) {
+    printf("Can't set %s to %li baud.\n", argv[1], baud);
+    return 1;
+  }
+
+  FramSender sender(fd);
+  framSendStats stats;
+  bool ok = sender.send(image, len, &stats);
+  printf("%li bytes, %u blocks, starting at block %u.  %lu block frames, %lu start frames, %lu NAKs, %lu timeouts, %.1f s.\n",
+         len, stats.blockCount, stats.firstBlock, stats.blockFrames, stats.startFrames, stats.naks, stats.timeouts,
+         stats.seconds);
+  if (ok) {
+    printf("Image stored and verified.\n");
+  } else if (stats.failCode != 0) {
+    printf("The Mega gave up with error %u (see framIngestError in FramIngest.h.)\n", stats.failCode);
+  } else {
+    printf("No reply from the Mega.  Run FramSend again to carry on from where it stopped.\n");
+  }
+  close(fd);
+  free(image);
+  return ok ? 0 : 1;
+}
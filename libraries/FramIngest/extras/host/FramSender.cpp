@@ -0,0 +1,177 @@
+// Rev: 10/19/26
+// FramSender is the PC end of the FramIngest protocol.  See FramSender.h.
+
+#include "FramSender.h"
+#include "FramLayout.h"
+
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+FramSender::FramSender(const int t_fd) {
+  // Rev: 10/19/26.
+  m_fd = t_fd;
+  m_corruptEvery = 0;
+  m_stopAfter = 0;
+  m_stats = NULL;
+}
+
+bool FramSender::send(const byte t_image[], const unsigned long t_len, framSendStats * t_stats) {
+  // Rev: 10/19/26.
+  m_stats = t_stats;
+  memset(m_stats, 0, sizeof(framSendStats));
+  m_stats->blockCount = (t_len + FRAM_INGEST_BLOCK_LEN - 1) / FRAM_INGEST_BLOCK_LEN;
+  struct timespec startTime;
+  struct timespec endTime;
+  clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+  byte start[FRAM_INGEST_START_LEN];
+  uint32_t imageID = FramIngest::crc32(0, t_image, t_len);
+  for (byte i = 0; i < 4; i++) {
+    start[i] = (t_len >> (8 * i)) & 0xFF;
+    start[4 + i] = (imageID >> (8 * i)) & 0xFF;
+  }
+  m_sendFrame('S', 0, start, FRAM_INGEST_START_LEN);
+  m_stats->startFrames++;
+
+  bool firstAsked = true;
+  bool done = false;
+  bool lastWasFinal = false;   // Last frame sent was block 0, which takes a long time to answer
+  byte timeoutsInARow = 0;
+  while (!done) {
+    byte code;
+    unsigned int seq;
+    if (!m_getReply(&code, &seq, lastWasFinal ? FRAM_SEND_FINAL_TIMEOUT_MS : FRAM_SEND_REPLY_TIMEOUT_MS)) {
+      m_stats->timeouts++;
+      if (++timeoutsInARow >= FRAM_SEND_MAX_TIMEOUTS) break;
+      m_sendFrame('S', 0, start, FRAM_INGEST_START_LEN);   // Whatever happened, the start frame will tell us where we are
+      m_stats->startFrames++;
+      lastWasFinal = false;
+      continue;
+    }
+    timeoutsInARow = 0;
+    if (code == 'D') {
+      done = true;
+    } else if (code == 'F') {
+      m_stats->failCode = seq;
+      break;
+    } else if (code == 'R') {
+      m_sendFrame('S', 0, start, FRAM_INGEST_START_LEN);
+      m_stats->startFrames++;
+      lastWasFinal = false;
+    } else if (((code == 'A') || (code == 'N')) && (seq < m_stats->blockCount)) {
+      if (code == 'N') m_stats->naks++;
+      if (firstAsked) {
+        m_stats->firstBlock = seq;
+        firstAsked = false;
+      }
+      if ((m_stopAfter > 0) && (m_stats->blockFrames >= m_stopAfter)) break;
+      unsigned long offset = (unsigned long)seq * FRAM_INGEST_BLOCK_LEN;
+      unsigned int len = FRAM_INGEST_BLOCK_LEN;
+      if ((t_len - offset) < FRAM_INGEST_BLOCK_LEN) len = t_len - offset;
+      m_sendFrame('B', seq, t_image + offset, len);
+      m_stats->blockFrames++;
+      lastWasFinal = (seq == 0);
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &endTime);
+  m_stats->seconds = (endTime.tv_sec - startTime.tv_sec) + ((endTime.tv_nsec - startTime.tv_nsec) / 1e9);
+  return done;
+}
+
+void FramSender::setCorruptEvery(const unsigned int t_frames) {
+  // Rev: 10/19/26.
+  m_corruptEvery = t_frames;
+  return;
+}
+
+void FramSender::setStopAfter(const unsigned int t_frames) {
+  // Rev: 10/19/26.
+  m_stopAfter = t_frames;
+  return;
+}
+
+bool FramSender::setRaw(const int t_fd, const long t_baud) {
+  // Rev: 10/19/26.
+  speed_t speed;
+  switch (t_baud) {
+    case 115200:  speed = B115200;  break;
+    case 230400:  speed = B230400;  break;
+    case 460800:  speed = B460800;  break;
+    case 500000:  speed = B500000;  break;
+    case 1000000: speed = B1000000; break;
+    default: return false;
+  }
+  struct termios t;
+  if (tcgetattr(t_fd, &t) != 0) return false;
+  cfmakeraw(&t);
+  t.c_cflag = t.c_cflag | CLOCAL | CREAD;
+  t.c_cc[VMIN] = 0;
+  t.c_cc[VTIME] = 0;
+  cfsetispeed(&t, speed);
+  cfsetospeed(&t, speed);
+  return (tcsetattr(t_fd, TCSANOW, &t) == 0);
+}
+
+void FramSender::m_sendFrame(const byte t_type, const unsigned int t_seq, const byte t_payload[], const unsigned int t_len) {
+  // Rev: 10/19/26.  Any reply still waiting belongs to an earlier frame, so throw it away first.
+  byte frame[FRAM_INGEST_HEADER_LEN + FRAM_INGEST_BLOCK_LEN + 1];
+  frame[0] = FRAM_INGEST_SOF;
+  frame[1] = t_type;
+  frame[2] = t_seq & 0xFF;
+  frame[3] = t_seq >> 8;
+  frame[4] = t_len & 0xFF;
+  frame[5] = t_len >> 8;
+  memcpy(frame + FRAM_INGEST_HEADER_LEN, t_payload, t_len);
+  unsigned int frameLen = FRAM_INGEST_HEADER_LEN + t_len + 1;
+  frame[frameLen - 1] = FramLayout::crc8(0, frame + 1, frameLen - 2);
+  if ((t_type == 'B') && (m_corruptEvery > 0) && (((m_stats->blockFrames + 1) % m_corruptEvery) == 0)) {
+    frame[FRAM_INGEST_HEADER_LEN + (t_len / 2)] ^= 0x10;
+  }
+  tcflush(m_fd, TCIFLUSH);
+  unsigned int done = 0;
+  while (done < frameLen) {
+    ssize_t n = write(m_fd, frame + done, frameLen - done);
+    if (n <= 0) break;
+    done = done + n;
+  }
+  m_stats->bytesSent = m_stats->bytesSent + frameLen;
+  return;
+}
+
+bool FramSender::m_getReply(byte * t_code, unsigned int * t_seq, const unsigned int t_timeoutMs) {
+  // Rev: 10/19/26.  Skips anything that isn't a well-formed reply, such as text the sketch printed before it started listening.
+  byte reply[FRAM_INGEST_REPLY_LEN];
+  byte have = 0;
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  double deadline = now.tv_sec + (now.tv_nsec / 1e9) + (t_timeoutMs / 1000.0);
+  while (true) {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double left = deadline - (now.tv_sec + (now.tv_nsec / 1e9));
+    if (left <= 0) return false;
+    struct pollfd p;
+    p.fd = m_fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    if (poll(&p, 1, (int)(left * 1000) + 1) <= 0) continue;
+    byte b;
+    if (read(m_fd, &b, 1) != 1) continue;
+    m_stats->bytesReceived++;
+    if ((have == 0) && (b != FRAM_INGEST_SOF)) continue;
+    reply[have++] = b;
+    if (have < FRAM_INGEST_REPLY_LEN) continue;
+    if (reply[4] == FramLayout::crc8(0, reply + 1, 3)) {
+      * t_code = reply[1];
+      * t_seq = reply[2] | (reply[3] << 8);
+      return true;
+    }
+    // Bad CRC: maybe that SOF was noise.  Start again from the next SOF within what we have.
+    byte i = 1;
+    while ((i < FRAM_INGEST_REPLY_LEN) && (reply[i] != FRAM_INGEST_SOF)) i++;
+    have = FRAM_INGEST_REPLY_LEN - i;
+    memmove(reply, reply + i, have);
+  }
+}
@@ -0,0 +1,61 @@
+// Rev: 10/19/26
+// FramSender is the PC end of the FramIngest protocol: it sends an FRAM image over a serial port (or pseudo-terminal) to a
+// sketch running FramIngest, sending whichever block the sketch asks for next, until the sketch says it's done.
+// Used by FramSend.cpp (the real thing) and FramIngestLoopback.cpp (the test).  See FramIngest.h for the protocol.
+// Give up after FRAM_SEND_MAX_TIMEOUTS replies in a row fail to arrive; after each missing reply the start frame is sent again,
+// which is all it takes to pick up again if the Mega was reset, including by our opening the port.
+
+#ifndef FRAM_SENDER_H
+#define FRAM_SENDER_H
+
+#include "Arduino.h"
+#include "FramIngest.h"
+
+const unsigned int FRAM_SEND_REPLY_TIMEOUT_MS = 1000;   // Normal wait for a reply
+const unsigned int FRAM_SEND_FINAL_TIMEOUT_MS = 15000;  // Block 0 is last; the Mega reads the whole image back before replying
+const byte         FRAM_SEND_MAX_TIMEOUTS     =   10;
+
+struct framSendStats {
+  unsigned long startFrames;    // Start frames sent, including the first
+  unsigned long blockFrames;    // Block frames sent, including repeats
+  unsigned long naks;           // 'N' replies
+  unsigned long timeouts;       // Replies that never came
+  unsigned long bytesSent;
+  unsigned long bytesReceived;
+  unsigned int  blockCount;     // Blocks in the image
+  unsigned int  firstBlock;     // First block asked for; anything but 1 means the sketch resumed an earlier load
+  byte          failCode;       // framIngestError from an 'F' reply, else 0
+  double        seconds;        // Wall-clock time
+};
+
+class FramSender
+{
+  public:
+
+    FramSender(const int t_fd);  // t_fd should already be in raw mode, at the right baud rate
+
+    bool send(const byte t_image[], const unsigned long t_len, framSendStats * t_stats);
+    // Sends the image; true once the sketch has replied 'D'.
+
+    void setCorruptEvery(const unsigned int t_frames);
+    // Test only: flip one bit in every t_frames'th block frame (0 = never), to exercise 'N' and resending.
+
+    void setStopAfter(const unsigned int t_frames);
+    // Test only: give up (return false) after sending t_frames block frames (0 = never), as if the PC had been unplugged.
+
+    static bool setRaw(const int t_fd, const long t_baud);
+    // Puts a serial port or pseudo-terminal in raw 8N1 mode at t_baud.  False if t_baud isn't one Linux knows.
+
+  private:
+
+    void m_sendFrame(const byte t_type, const unsigned int t_seq, const byte t_payload[], const unsigned int t_len);
+    bool m_getReply(byte * t_code, unsigned int * t_seq, const unsigned int t_timeoutMs);
+
+    int m_fd;
+    unsigned int m_corruptEvery;
+    unsigned int m_stopAfter;
+    framSendStats * m_stats;
+
+};
+
+#endif
@@ -0,0 +1,54 @@
+// Rev: 10/19/26
+// HostSerial is a Stream on a Linux file descriptor.  See HostSerial.h.
+
+#include "HostSerial.h"
+#include "FerroEmulator.h"
+
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+HostSerial::HostSerial(const int t_fd) {
+  // Rev: 10/19/26.
+  m_fd = t_fd;
+}
+
+int HostSerial::available() {
+  // Rev: 10/19/26.
+  int waiting = 0;
+  if (ioctl(m_fd, FIONREAD, &waiting) != 0) return 0;
+  if (waiting > 0) return waiting;
+  struct pollfd p;
+  p.fd = m_fd;
+  p.events = POLLIN;
+  p.revents = 0;
+  if (poll(&p, 1, 1) <= 0) {
+    FerroEmulator::advanceMicros(1000.0);
+    return 0;
+  }
+  if (ioctl(m_fd, FIONREAD, &waiting) != 0) return 0;
+  return waiting;
+}
+
+int HostSerial::read() {
+  // Rev: 10/19/26.
+  byte b;
+  if (::read(m_fd, &b, 1) != 1) return -1;
+  return b;
+}
+
+size_t HostSerial::write(uint8_t t_data) {
+  // Rev: 10/19/26.
+  return write(&t_data, 1);
+}
+
+size_t HostSerial::write(const uint8_t * t_buffer, size_t t_size) {
+  // Rev: 10/19/26.
+  size_t done = 0;
+  while (done < t_size) {
+    ssize_t n = ::write(m_fd, t_buffer + done, t_size - done);
+    if (n <= 0) break;
+    done = done + n;
+  }
+  return done;
+}
@@ -0,0 +1,29 @@
+// Rev: 10/19/26
+// HostSerial is a Stream on a Linux file descriptor (a serial port, or one end of a pseudo-terminal), so FramIngest can run on
+// a PC exactly as it does on the Mega.  See FramIngestLoopback.cpp.
+// available() waits up to 1ms for input when there is none, and advances FerroEmulator's modelled clock by that 1ms, so
+// millis()-based timeouts in the code under test still expire while it waits.
+
+#ifndef HOST_SERIAL_H
+#define HOST_SERIAL_H
+
+#include "Arduino.h"
+
+class HostSerial : public Stream
+{
+  public:
+
+    HostSerial(const int t_fd);  // t_fd should already be in raw mode
+
+    int available();
+    int read();
+    size_t write(uint8_t t_data);
+    size_t write(const uint8_t * t_buffer, size_t t_size);
+
+  private:
+
+    int m_fd;
+
+};
+
+#endif
@@ -0,0 +1,272 @@
+// Rev: 10/19/26
+// FramLayout stamps a FRAM with a description of the tables stored in it, keeps a CRC-8 of every record, and checks it all at
+// boot.  See FramLayout.h.
+
+#include "FramLayout.h"
+
+const byte FRAM_LAYOUT_SCAN_CHUNK = 64;  // scan() pulls record bytes off the stream this many at a time
+
+// Dallas/Maxim CRC-8 (reflected polynomial 0x8C) of every possible byte, so crc8() costs one lookup per byte instead of a loop
+// of eight shifts.  Kept in flash so it doesn't use 256 bytes of RAM.
+const byte FRAM_CRC8_TABLE[256] PROGMEM = {
+  0x00, 0x5E, 0xBC, 0xE2, 0x61, 0x3F, 0xDD, 0x83, 0xC2, 0x9C, 0x7E, 0x20, 0xA3, 0xFD, 0x1F, 0x41,
+  0x9D, 0xC3, 0x21, 0x7F, 0xFC, 0xA2, 0x40, 0x1E, 0x5F, 0x01, 0xE3, 0xBD, 0x3E, 0x60, 0x82, 0xDC,
+  0x23, 0x7D, 0x9F, 0xC1, 0x42, 0x1C, 0xFE, 0xA0, 0xE1, 0xBF, 0x5D, 0x03, 0x80, 0xDE, 0x3C, 0x62,
+  0xBE, 0xE0, 0x02, 0x5C, 0xDF, 0x81, 0x63, 0x3D, 0x7C, 0x22, 0xC0, 0x9E, 0x1D, 0x43, 0xA1, 0xFF,
+  0x46, 0x18, 0xFA, 0xA4, 0x27, 0x79, 0x9B, 0xC5, 0x84, 0xDA, 0x38, 0x66, 0xE5, 0xBB, 0x59, 0x07,
+  0xDB, 0x85, 0x67, 0x39, 0xBA, 0xE4, 0x06, 0x58, 0x19, 0x47, 0xA5, 0xFB, 0x78, 0x26, 0xC4, 0x9A,
+  0x65, 0x3B, 0xD9, 0x87, 0x04, 0x5A, 0xB8, 0xE6, 0xA7, 0xF9, 0x1B, 0x45, 0xC6, 0x98, 0x7A, 0x24,
+  0xF8, 0xA6, 0x44, 0x1A, 0x99, 0xC7, 0x25, 0x7B, 0x3A, 0x64, 0x86, 0xD8, 0x5B, 0x05, 0xE7, 0xB9,
+  0x8C, 0xD2, 0x30, 0x6E, 0xED, 0xB3, 0x51, 0x0F, 0x4E, 0x10, 0xF2, 0xAC, 0x2F, 0x71, 0x93, 0xCD,
+  0x11, 0x4F, 0xAD, 0xF3, 0x70, 0x2E, 0xCC, 0x92, 0xD3, 0x8D, 0x6F, 0x31, 0xB2, 0xEC, 0x0E, 0x50,
+  0xAF, 0xF1, 0x13, 0x4D, 0xCE, 0x90, 0x72, 0x2C, 0x6D, 0x33, 0xD1, 0x8F, 0x0C, 0x52, 0xB0, 0xEE,
+  0x32, 0x6C, 0x8E, 0xD0, 0x53, 0x0D, 0xEF, 0xB1, 0xF0, 0xAE, 0x4C, 0x12, 0x91, 0xCF, 0x2D, 0x73,
+  0xCA, 0x94, 0x76, 0x28, 0xAB, 0xF5, 0x17, 0x49, 0x08, 0x56, 0xB4, 0xEA, 0x69, 0x37, 0xD5, 0x8B,
+  0x57, 0x09, 0xEB, 0xB5, 0x36, 0x68, 0x8A, 0xD4, 0x95, 0xCB, 0x29, 0x77, 0xF4, 0xAA, 0x48, 0x16,
+  0xE9, 0xB7, 0x55, 0x0B, 0x88, 0xD6, 0x34, 0x6A, 0x2B, 0x75, 0x97, 0xC9, 0x4A, 0x14, 0xF6, 0xA8,
+  0x74, 0x2A, 0xC8, 0x96, 0x15, 0x4B, 0xA9, 0xF7, 0xB6, 0xE8, 0x0A, 0x54, 0xD7, 0x89, 0x6B, 0x35
+};
+
+static_assert(FRAM_LAYOUT_OFFSET + FRAM_LAYOUT_HEADER_LEN <= 128, "FramLayout header does not fit in the control block");
+static_assert(2 * (FRAM_LAYOUT_MAX_TABLES - 1) <= FRAM_LAYOUT_TABLE_LEN, "Per-table CRCs do not fit in one header slot");
+
+FramLayout::FramLayout(Hackscribble_Ferro * t_FRAM) {
+  // Rev: 10/19/26.
+  m_FRAM = t_FRAM;
+  m_tableCount = 0;
+  memset(m_table, 0, sizeof(m_table));
+  memset(m_name, 0, sizeof(m_name));
+  memset(m_tableCRC, 0, sizeof(m_tableCRC));
+}
+
+bool FramLayout::addTable(const unsigned long t_start, const unsigned int t_recs, const byte t_recLen, const char t_name[]) {
+  // Rev: 10/19/26.  The CRC area starts right after whichever table is added last, so work out every table's crcStart again.
+  if (m_tableCount >= FRAM_LAYOUT_MAX_TABLES) return false;
+  m_table[m_tableCount].start = t_start;
+  m_table[m_tableCount].recs = t_recs;
+  m_table[m_tableCount].recLen = t_recLen;
+  m_name[m_tableCount] = t_name;
+  m_tableCount++;
+  unsigned long crcAddress = t_start + ((unsigned long)t_recs * t_recLen);
+  for (byte i = 0; i < m_tableCount; i++) {
+    m_table[i].crcStart = crcAddress;
+    crcAddress = crcAddress + m_table[i].recs;
+  }
+  return true;
+}
+
+ferroResult FramLayout::setHeader(byte t_controlBuf[]) {
+  // Rev: 10/19/26.  The header goes in even if a table can't be read (i.e. it runs past the top of the FRAM), so that
+  // checkHeader() says why.
+  ferroResult result = ferroOK;
+  if (m_wholeTableCRCs()) {
+    for (byte t = 0; (t < m_tableCount) && (result == ferroOK); t++) {
+      result = m_tableCRC16(t, &m_tableCRC[t]);
+    }
+  }
+  m_packHeader(t_controlBuf + FRAM_LAYOUT_OFFSET);
+  return result;
+}
+
+framLayoutResult FramLayout::checkHeader(const byte t_controlBuf[]) {
+  // Rev: 10/19/26.  Rather than unpack what's on the FRAM, build the header we'd have written and compare the two.
+  const byte * header = t_controlBuf + FRAM_LAYOUT_OFFSET;
+  if (header[0] != FRAM_LAYOUT_MAGIC) return layoutMissing;
+  if (header[FRAM_LAYOUT_HEADER_LEN - 1] != crc8(0, header, FRAM_LAYOUT_HEADER_LEN - 1)) return layoutBadCRC;
+  if (header[1] != FRAM_LAYOUT_VERSION) return layoutWrongVersion;
+  // Per-table CRCs depend on the table contents, not the layout, so take them from the FRAM (for scan()) before comparing.
+  if (m_wholeTableCRCs()) {
+    const byte * slot = header + 3 + ((FRAM_LAYOUT_MAX_TABLES - 1) * FRAM_LAYOUT_TABLE_LEN);
+    for (byte t = 0; t < m_tableCount; t++) {
+      m_tableCRC[t] = slot[2 * t] | ((unsigned int)slot[(2 * t) + 1] << 8);
+    }
+  }
+  byte expected[FRAM_LAYOUT_HEADER_LEN];
+  m_packHeader(expected);
+  if (memcmp(header, expected, FRAM_LAYOUT_HEADER_LEN) != 0) return layoutMismatch;
+  if (m_tableCount > 0) {
+    const framTableDescriptor * last = &m_table[m_tableCount - 1];
+    if ((last->start + ((unsigned long)last->recs * last->recLen) - 1) > m_FRAM->getTopAddress()) return layoutTooBig;
+    if (!m_wholeTableCRCs() && ((last->crcStart + last->recs - 1) > m_FRAM->getTopAddress())) return layoutTooBig;
+  }
+  return layoutOK;
+}
+
+ferroResult FramLayout::writeRecordCRC(const byte t_table, const unsigned int t_index, const byte t_record[]) {
+  // Rev: 10/19/26.
+  if ((t_table >= m_tableCount) || (t_index >= m_table[t_table].recs)) return ferroBadArrayIndex;
+  if (m_wholeTableCRCs()) return ferroOK;   // setHeader() does the whole table once it's all written
+  byte crc = crc8(0, t_record, m_table[t_table].recLen);
+  return m_FRAM->write(m_table[t_table].crcStart + t_index, 1, &crc);
+}
+
+ferroResult FramLayout::scan(framBadRecord t_bad[], const byte t_maxBad, unsigned int * t_badCount) {
+  // Rev: 10/19/26.  For each table, a batch at a time (normally the whole table): fetch the stored CRCs, then stream every
+  // record of the batch in a single read, running the CRC over each chunk as it arrives and comparing at each record boundary.
+  // Nothing is ever held in RAM but one chunk and one batch of stored CRCs.  With a CRC per table, just compare those.
+  byte storedCRC[FRAM_LAYOUT_SCAN_RECS];
+  byte chunk[FRAM_LAYOUT_SCAN_CHUNK];
+  ferroResult result;
+  * t_badCount = 0;
+  if (m_wholeTableCRCs()) {
+    for (byte t = 0; t < m_tableCount; t++) {
+      unsigned int crc;
+      result = m_tableCRC16(t, &crc);
+      if (result != ferroOK) return result;
+      if (crc != m_tableCRC[t]) {
+        if (* t_badCount < t_maxBad) {
+          t_bad[* t_badCount].table = t;
+          t_bad[* t_badCount].index = FRAM_LAYOUT_WHOLE_TABLE;
+        }
+        (* t_badCount)++;
+      }
+    }
+    return ferroOK;
+  }
+  for (byte t = 0; t < m_tableCount; t++) {
+    const byte recLen = m_table[t].recLen;
+    for (unsigned int first = 0; first < m_table[t].recs; first = first + FRAM_LAYOUT_SCAN_RECS) {
+      byte batchRecs = FRAM_LAYOUT_SCAN_RECS;
+      if ((m_table[t].recs - first) < FRAM_LAYOUT_SCAN_RECS) batchRecs = m_table[t].recs - first;
+
+      result = m_FRAM->beginRead(m_table[t].crcStart + first, batchRecs);
+      if (result == ferroOK) result = m_FRAM->streamRead(batchRecs, storedCRC);
+      m_FRAM->endStream();
+      if (result != ferroOK) return result;
+
+      unsigned long bytesLeft = (unsigned long)batchRecs * recLen;
+      result = m_FRAM->beginRead(m_table[t].start + ((unsigned long)first * recLen), bytesLeft);
+      byte crc = 0;
+      byte recPos = 0;   // Bytes of the current record seen so far
+      byte rec = 0;      // Current record within this batch
+      while ((result == ferroOK) && (bytesLeft > 0)) {
+        byte chunkLen = FRAM_LAYOUT_SCAN_CHUNK;
+        if (bytesLeft < FRAM_LAYOUT_SCAN_CHUNK) chunkLen = bytesLeft;
+        result = m_FRAM->streamRead(chunkLen, chunk);
+        for (byte i = 0; i < chunkLen; i++) {
+          crc = pgm_read_byte(&FRAM_CRC8_TABLE[crc ^ chunk[i]]);
+          if (++recPos == recLen) {
+            if (crc != storedCRC[rec]) {
+              if (* t_badCount < t_maxBad) {
+                t_bad[* t_badCount].table = t;
+                t_bad[* t_badCount].index = first + rec;
+              }
+              (* t_badCount)++;
+            }
+            crc = 0;
+            recPos = 0;
+            rec++;
+          }
+        }
+        bytesLeft = bytesLeft - chunkLen;
+      }
+      m_FRAM->endStream();
+      if (result != ferroOK) return result;
+    }
+  }
+  return ferroOK;
+}
+
+bool FramLayout::verify(const byte t_controlBuf[], const char t_FRAMName[], char t_message[]) {
+  // Rev: 10/19/26.  Only the first bad record is named; the LCD has room for one line and the rest are only counted.  snprintf()
+  // cuts any message that's still too long to the width of the LCD.
+  t_message[0] = '\0';
+  framLayoutResult layoutStatus = checkHeader(t_controlBuf);
+  if (layoutStatus != layoutOK) {   // 1 = never stamped, 2 = header damaged, 3 = old library, 4 = wrong tables, 5 = won't fit
+    snprintf(t_message, FRAM_LAYOUT_MESSAGE_LEN, "%s bad layout %i", t_FRAMName, layoutStatus);
+    return false;
+  }
+  framBadRecord badRec;
+  unsigned int badRecs = 0;
+  if (scan(&badRec, 1, &badRecs) != ferroOK) {
+    snprintf(t_message, FRAM_LAYOUT_MESSAGE_LEN, "%s scan failed.", t_FRAMName);
+    return false;
+  }
+  if (badRecs == 0) return true;
+  char name[4] = { 'T', (char)('1' + badRec.table), '\0', '\0' };   // T1, T2... if the table has no name
+  if (m_name[badRec.table] != NULL) {
+    strncpy(name, m_name[badRec.table], 3);
+  }
+  if (badRec.index == FRAM_LAYOUT_WHOLE_TABLE) {
+    snprintf(t_message, FRAM_LAYOUT_MESSAGE_LEN, "%s bad %s table", t_FRAMName, name);
+  } else if (badRecs == 1) {
+    snprintf(t_message, FRAM_LAYOUT_MESSAGE_LEN, "%s bad %s %u", t_FRAMName, name, badRec.index + 1);  // Route number
+  } else {
+    snprintf(t_message, FRAM_LAYOUT_MESSAGE_LEN, "%s bad %s %u +%u", t_FRAMName, name, badRec.index + 1, badRecs - 1);
+  }
+  return false;
+}
+
+bool FramLayout::m_wholeTableCRCs() {
+  // Rev: 10/19/26.
+  if ((m_tableCount == 0) || (m_tableCount >= FRAM_LAYOUT_MAX_TABLES)) return false;
+  const framTableDescriptor * last = &m_table[m_tableCount - 1];
+  return ((last->crcStart + last->recs - 1) > m_FRAM->getTopAddress());
+}
+
+ferroResult FramLayout::m_tableCRC16(const byte t_table, unsigned int * t_crc) {
+  // Rev: 10/19/26.  One stream for the whole table, a chunk at a time.
+  byte chunk[FRAM_LAYOUT_SCAN_CHUNK];
+  unsigned long bytesLeft = (unsigned long)m_table[t_table].recs * m_table[t_table].recLen;
+  * t_crc = 0xFFFF;
+  ferroResult result = m_FRAM->beginRead(m_table[t_table].start, bytesLeft);
+  while ((result == ferroOK) && (bytesLeft > 0)) {
+    byte chunkLen = FRAM_LAYOUT_SCAN_CHUNK;
+    if (bytesLeft < FRAM_LAYOUT_SCAN_CHUNK) chunkLen = bytesLeft;
+    result = m_FRAM->streamRead(chunkLen, chunk);
+    * t_crc = crc16(* t_crc, chunk, chunkLen);
+    bytesLeft = bytesLeft - chunkLen;
+  }
+  m_FRAM->endStream();
+  return result;
+}
+
+void FramLayout::m_packHeader(byte t_header[]) {
+  // Rev: 10/19/26.  Byte 0 = magic, 1 = version, 2 = table count, then FRAM_LAYOUT_TABLE_LEN bytes for each of
+  // FRAM_LAYOUT_MAX_TABLES tables (zeroes for unused ones), then the CRC of everything before it.  With a CRC per table, every
+  // crcStart is 0 and the last slot holds each table's CRC-16, 2 bytes each.
+  const bool wholeTable = m_wholeTableCRCs();
+  memset(t_header, 0, FRAM_LAYOUT_HEADER_LEN);
+  t_header[0] = FRAM_LAYOUT_MAGIC;
+  t_header[1] = FRAM_LAYOUT_VERSION;
+  t_header[2] = m_tableCount;
+  for (byte i = 0; i < m_tableCount; i++) {
+    byte * p = t_header + 3 + (i * FRAM_LAYOUT_TABLE_LEN);
+    for (byte j = 0; j < 4; j++) p[j] = (m_table[i].start >> (8 * j)) & 0xFF;
+    p[4] = m_table[i].recs & 0xFF;
+    p[5] = m_table[i].recs >> 8;
+    p[6] = m_table[i].recLen;
+    if (!wholeTable) {
+      for (byte j = 0; j < 4; j++) p[7 + j] = (m_table[i].crcStart >> (8 * j)) & 0xFF;
+    }
+  }
+  if (wholeTable) {
+    byte * slot = t_header + 3 + ((FRAM_LAYOUT_MAX_TABLES - 1) * FRAM_LAYOUT_TABLE_LEN);
+    for (byte i = 0; i < m_tableCount; i++) {
+      slot[2 * i] = m_tableCRC[i] & 0xFF;
+      slot[(2 * i) + 1] = m_tableCRC[i] >> 8;
+    }
+  }
+  t_header[FRAM_LAYOUT_HEADER_LEN - 1] = crc8(0, t_header, FRAM_LAYOUT_HEADER_LEN - 1);
+  return;
+}
+
+byte FramLayout::crc8(byte t_crc, const byte t_data[], const unsigned int t_len) {
+  // Rev: 10/19/26.
+  for (unsigned int i = 0; i < t_len; i++) {
+    t_crc = pgm_read_byte(&FRAM_CRC8_TABLE[t_crc ^ t_data[i]]);
+  }
+  return t_crc;
+}
+
+unsigned int FramLayout::crc16(unsigned int t_crc, const byte t_data[], const unsigned int t_len) {
+  // Rev: 10/19/26.  Polynomial 0x1021, a bit at a time; it's only used for a whole-table CRC, once at boot.  Masked to 16 bits
+  // so it's the same where an int is longer (i.e. on a PC.)
+  for (unsigned int i = 0; i < t_len; i++) {
+    t_crc = t_crc ^ ((unsigned int)t_data[i] << 8);
+    for (byte bit = 0; bit < 8; bit++) {
+      t_crc = ((t_crc & 0x8000) ? ((t_crc << 1) ^ 0x1021) : (t_crc << 1)) & 0xFFFF;
+    }
+  }
+  return t_crc;
+}
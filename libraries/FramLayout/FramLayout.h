@@ -0,0 +1,123 @@
+// Rev: 10/19/26
+// FramLayout stamps a FRAM with a description of the tables stored in it, keeps a CRC-8 of every record, and checks it all at
+// boot.
+
+// Until now the only check was the 3-byte version date at the start of the control block.  A record half-written when the power
+// went off, or tables left over from an older run of Populate_FRAM_Route_Reference with different record lengths or counts,
+// went unnoticed until a train was routed wrongly.
+// Layout on the FRAM:
+//   Control block bytes FRAM_LAYOUT_OFFSET..FRAM_LAYOUT_OFFSET + FRAM_LAYOUT_HEADER_LEN - 1: the layout header, i.e. a layout
+//     version number plus, for each table, where it starts, how many records and how long each is, and where its CRCs are.
+//     The header has its own CRC.  See m_packHeader() for the byte layout; multi-byte numbers are low byte first.
+//   The tables themselves, unchanged, so every existing reader keeps working.
+//   Right after the last table, one CRC byte per record: all of table 0's, then all of table 1's, and so on.
+// The CRC is the same Dallas/Maxim CRC-8 used on our RS485 messages (see Message_RS485::calcChecksumCRC8), done by table lookup.
+// If the per-record CRCs won't fit below the top of the FRAM (the double-level tables fill all but 53 bytes of an 8K FRAM1,
+// and need 93 CRCs), each table gets one CRC-16 instead, kept in the header's unused last table slot, and every crcStart in the
+// header is 0.  That needs a free slot, so it only works with fewer than FRAM_LAYOUT_MAX_TABLES tables.  A damaged record is
+// still found, but scan() can only say which table it's in.
+// Usage:
+//   Every sketch describes the tables it expects with addTable(), in address order, the same way Populate wrote them.
+//   Populate_FRAM_Route_Reference then calls writeRecordCRC() after each record and, once every table has been written,
+//     setHeader() on its control block buffer.
+//   Everyone else calls verify() on the control block they just read, which does checkHeader() and scan() and, if there's
+//     anything wrong, puts an LCD line saying what into a message buffer.
+// extras/host/FramLayoutTest.cpp checks all this against FerroEmulator.
+
+#ifndef FRAM_LAYOUT_H
+#define FRAM_LAYOUT_H
+
+#include "Arduino.h"
+#include "Hackscribble_Ferro.h"
+
+const byte FRAM_LAYOUT_OFFSET     =  77;  // Header goes in the FRAM1 control block right after the speed calibration curves
+const byte FRAM_LAYOUT_MAGIC      = 'L';  // First byte of the header, so we can tell "never stamped" from "damaged"
+const byte FRAM_LAYOUT_VERSION    =   1;  // Bump this if framLayoutHeader itself changes
+const byte FRAM_LAYOUT_MAX_TABLES =   4;  // FRAM1 has three: Route, Park 1, Park 2
+const byte FRAM_LAYOUT_TABLE_LEN  =  11;  // Bytes per table in the header: start (4), recs (2), recLen (1), crcStart (4)
+const byte FRAM_LAYOUT_HEADER_LEN = 3 + (FRAM_LAYOUT_MAX_TABLES * FRAM_LAYOUT_TABLE_LEN) + 1;  // 48 bytes, so it ends at 124
+const byte FRAM_LAYOUT_SCAN_RECS  = 128;  // scan() fetches the stored CRCs of this many records at a time
+const byte FRAM_LAYOUT_MESSAGE_LEN = 21;  // verify()'s message: one 20-character LCD line plus the null
+const unsigned int FRAM_LAYOUT_WHOLE_TABLE = 0xFFFF;  // framBadRecord.index when there's only a CRC of the whole table
+
+enum framLayoutResult {
+  layoutOK = 0,
+  layoutMissing,         // No header at all; FRAM was populated before 10/19/26
+  layoutBadCRC,          // Header is there but damaged
+  layoutWrongVersion,    // Header was written by a different version of this library
+  layoutMismatch,        // Tables on the FRAM are not the ones this sketch was compiled for
+  layoutTooBig           // Tables plus CRCs would run past the top of the FRAM
+};
+
+struct framTableDescriptor {
+  unsigned long start;     // FRAM address of record 0
+  unsigned int  recs;      // Number of records
+  byte          recLen;    // Bytes per record
+  unsigned long crcStart;  // FRAM address of the CRC of record 0
+};
+
+struct framBadRecord {     // scan() reports each record whose CRC doesn't match as one of these
+  byte table;              // 0..tableCount-1, in the order they were added
+  unsigned int index;      // Record number 0..recs-1 in that table, or FRAM_LAYOUT_WHOLE_TABLE
+};
+
+class FramLayout
+{
+  public:
+
+    FramLayout(Hackscribble_Ferro * t_FRAM);  // Constructor.  Does not touch the FRAM.
+
+    bool addTable(const unsigned long t_start, const unsigned int t_recs, const byte t_recLen, const char t_name[] = NULL);
+    // Describes the next table.  Call once per table, in address order.  t_name (up to 3 characters, and must stay put) is only
+    // used in verify()'s message.  Returns false if there are already FRAM_LAYOUT_MAX_TABLES tables.
+
+    ferroResult setHeader(byte t_controlBuf[]);
+    // Populate only: puts the header describing our tables into a 128-byte control block buffer, ready for writeControlBlock().
+    // If there's only room for a CRC per table, the tables are read to work them out, so call this after they're written.
+
+    framLayoutResult checkHeader(const byte t_controlBuf[]);
+    // Compares the header in a control block buffer just read from the FRAM with the tables we were given.
+
+    ferroResult writeRecordCRC(const byte t_table, const unsigned int t_index, const byte t_record[]);
+    // Populate only: writes the CRC of one record, which the caller has just written to (or is about to write to) the FRAM.
+    // Does nothing if there's only room for a CRC per table.
+
+    ferroResult scan(framBadRecord t_bad[], const byte t_maxBad, unsigned int * t_badCount);
+    // Reads every record of every table and compares its CRC with the stored one.  The first t_maxBad bad records are put in
+    // t_bad[], and * t_badCount is set to the total number of bad records.  Returns any error from the FRAM, else ferroOK.
+    // Each table is streamed in one burst, and the CRC is worked out as the bytes arrive, so a full 8K FRAM1 takes about 20ms.
+    // If there's only a CRC per table, a damaged table is reported once, with index FRAM_LAYOUT_WHOLE_TABLE, and the CRC-16
+    // takes the time up to about 60ms.  Call checkHeader() first, which is where the per-table CRCs come from.
+
+    bool verify(const byte t_controlBuf[], const char t_FRAMName[], char t_message[]);
+    // checkHeader() then scan(), as every sketch does at boot.  Returns true if all is well.  If not, returns false with one LCD
+    // line saying what's wrong in t_message[] (FRAM_LAYOUT_MESSAGE_LEN bytes), starting with t_FRAMName, e.g. "FRAM1 bad
+    // layout 4", "FRAM1 scan failed.", "FRAM1 bad Rte 12 +2" (route 12 and two more records), or "FRAM1 bad Pk1 table".
+
+    static byte crc8(byte t_crc, const byte t_data[], const unsigned int t_len);
+    // Continues CRC t_crc over t_len more bytes.  Start with 0.  Same answer as Message_RS485::calcChecksumCRC8().
+
+    static unsigned int crc16(unsigned int t_crc, const byte t_data[], const unsigned int t_len);
+    // Continues CRC-16/CCITT t_crc over t_len more bytes.  Start with 0xFFFF.
+
+  private:
+
+    bool m_wholeTableCRCs();
+    // True if the per-record CRCs wouldn't fit below the top of the FRAM, but there's a free header slot for a CRC per table.
+
+    ferroResult m_tableCRC16(const byte t_table, unsigned int * t_crc);
+    // Streams all of table t_table and works out its CRC-16.
+
+    void m_packHeader(byte t_header[]);
+    // Writes the FRAM_LAYOUT_HEADER_LEN-byte header describing our tables, CRC and all, into t_header[].
+    // Done byte by byte rather than by memcpy() of a struct, so the header is the same whatever compiler builds it.
+
+    Hackscribble_Ferro * m_FRAM;
+    byte m_tableCount;
+    framTableDescriptor m_table[FRAM_LAYOUT_MAX_TABLES];
+    const char * m_name[FRAM_LAYOUT_MAX_TABLES];
+    unsigned int m_tableCRC[FRAM_LAYOUT_MAX_TABLES];   // Only used if m_wholeTableCRCs()
+
+};
+
+#endif
@@ -0,0 +1,213 @@
+// Rev: 10/19/26
+// FramLayoutTest: checks FramLayout against FerroEmulator on a PC, using an 8K FRAM1 (MB85RS64) like the one on the layout.
+// It populates FRAM1 the way Populate_FRAM_Route_Reference does, then checks that verify() passes, and that it (and scan())
+// report every kind of damage: a corrupted record, a corrupted CRC, a damaged header, tables that don't match, and tables that
+// don't fit.  Both ways of keeping CRCs are covered: per record (single-level tables, which leave room for them) and per table
+// (double-level tables, which fill all but 53 bytes of the 8K FRAM1.)
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramLayout
+//       -o FramLayoutTest libraries/FramLayout/extras/host/FramLayoutTest.cpp libraries/FramLayout/FramLayout.cpp
+//       libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp
+//   ./FramLayoutTest [FRAM image file]
+// The image file is created if it doesn't exist, and overwritten.
+
+#include "FerroEmulator.h"
+#include "FramLayout.h"
+
+const byte          PIN_FRAM1            =  11;
+const unsigned int  FRAM1_ROUTE_START    = 128;   // As in A-MAS, A-LED etc.
+const byte          FRAM1_ROUTE_REC_LEN  =  77;
+const byte          SINGLE_ROUTE_RECS    =  32;
+const byte          DOUBLE_ROUTE_RECS    =  70;
+const byte          FRAM1_PARK1_REC_LEN  = 127;
+const byte          FRAM1_PARK1_RECS     =  19;
+const byte          FRAM1_PARK2_REC_LEN  =  52;
+const byte          FRAM1_PARK2_RECS     =   4;
+
+FerroEmulator * chip;
+Hackscribble_Ferro * FRAM1;
+unsigned long failures = 0;
+
+void check(const bool t_ok, const char t_what[]) {
+  if (!t_ok) {
+    printf("FAIL %s\n", t_what);
+    failures++;
+  }
+  return;
+}
+
+void checkMessage(const char t_got[], const char t_expected[]) {
+  if (strcmp(t_got, t_expected) != 0) {
+    printf("FAIL message \"%s\", expected \"%s\"\n", t_got, t_expected);
+    failures++;
+  }
+  return;
+}
+
+// Describes FRAM1's Route, Park 1 and Park 2 tables, as every sketch does, with t_routeRecs routes.
+void describe(FramLayout * t_layout, const byte t_routeRecs) {
+  const unsigned long park1Start = FRAM1_ROUTE_START + ((unsigned long)FRAM1_ROUTE_REC_LEN * t_routeRecs);
+  const unsigned long park2Start = park1Start + ((unsigned long)FRAM1_PARK1_REC_LEN * FRAM1_PARK1_RECS);
+  t_layout->addTable(FRAM1_ROUTE_START, t_routeRecs, FRAM1_ROUTE_REC_LEN, "Rte");
+  t_layout->addTable(park1Start, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN, "Pk1");
+  t_layout->addTable(park2Start, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN, "Pk2");
+  return;
+}
+
+// Writes every record of every table (all different), with CRCs and then the header, the way Populate does.  Returns the
+// address just past the last table.
+unsigned long populate(const byte t_routeRecs) {
+  memset(chip->memory(), 0, chip->size());
+  FramLayout layout(FRAM1);
+  describe(&layout, t_routeRecs);
+  const byte recLen[3] = { FRAM1_ROUTE_REC_LEN, FRAM1_PARK1_REC_LEN, FRAM1_PARK2_REC_LEN };
+  const byte recs[3] = { t_routeRecs, FRAM1_PARK1_RECS, FRAM1_PARK2_RECS };
+  unsigned long address = FRAM1_ROUTE_START;
+  byte b[128];
+  for (byte t = 0; t < 3; t++) {
+    for (byte i = 0; i < recs[t]; i++) {
+      for (byte j = 0; j < recLen[t]; j++) b[j] = (byte)((t * 71) + (i * 13) + j);
+      FRAM1->write(address, recLen[t], b);
+      layout.writeRecordCRC(t, i, b);
+      address = address + recLen[t];
+    }
+  }
+  byte controlBuf[128];
+  memset(controlBuf, 0, sizeof(controlBuf));
+  check(layout.setHeader(controlBuf) == ferroOK, "setHeader()");
+  FRAM1->writeControlBlock(controlBuf);
+  return address;
+}
+
+// Runs verify() as a sketch does at boot, with t_routeRecs routes, and returns its result and message.
+bool boot(const byte t_routeRecs, char t_message[]) {
+  FramLayout layout(FRAM1);
+  describe(&layout, t_routeRecs);
+  byte controlBuf[128];
+  FRAM1->readControlBlock(controlBuf);
+  return layout.verify(controlBuf, "FRAM1", t_message);
+}
+
+int main(int argc, char * argv[]) {
+  FerroEmulator FRAM1Chip(MB85RS64, PIN_FRAM1, (argc > 1) ? argv[1] : "FramLayoutTest.bin");
+  if (!FRAM1Chip.isOpen()) {
+    printf("Couldn't open the FRAM image file.\n");
+    return 1;
+  }
+  chip = &FRAM1Chip;
+  Hackscribble_Ferro FRAM1Object(MB85RS64, PIN_FRAM1);
+  FRAM1 = &FRAM1Object;
+  if (FRAM1->begin() != ferroOK) {
+    printf("FRAM begin() failed.\n");
+    return 1;
+  }
+  char message[FRAM_LAYOUT_MESSAGE_LEN];
+  framBadRecord bad[4];
+  unsigned int badRecs;
+  byte controlBuf[128];
+
+  // *** The CRCs themselves.
+  const byte check9[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  check(FramLayout::crc8(0, check9, 9) == 0xA1, "crc8() of \"123456789\" is 0xA1 (Dallas/Maxim)");
+  check(FramLayout::crc16(0xFFFF, check9, 9) == 0x29B1, "crc16() of \"123456789\" is 0x29B1 (CCITT)");
+
+  // *** Single-level: a CRC per record, right after Park 2.
+  const unsigned long singleEnd = populate(SINGLE_ROUTE_RECS);
+  check(boot(SINGLE_ROUTE_RECS, message), "single-level tables pass verify()");
+  checkMessage(message, "");
+  check(chip->memory()[FRAM_LAYOUT_OFFSET + 3 + 7] == (singleEnd & 0xFF), "per-record CRCs start right after Park 2");
+
+  chip->memory()[FRAM1_ROUTE_START + (5 * FRAM1_ROUTE_REC_LEN) + 40] ^= 0x10;   // One bit of route 6
+  check(!boot(SINGLE_ROUTE_RECS, message), "a corrupted route fails verify()");
+  checkMessage(message, "FRAM1 bad Rte 6");
+  {
+    FramLayout layout(FRAM1);
+    describe(&layout, SINGLE_ROUTE_RECS);
+    FRAM1->readControlBlock(controlBuf);
+    check(layout.checkHeader(controlBuf) == layoutOK, "a corrupted record leaves the header OK");
+    check(layout.scan(bad, 4, &badRecs) == ferroOK, "scan()");
+    check((badRecs == 1) && (bad[0].table == 0) && (bad[0].index == 5), "scan() reports route record 5");
+  }
+  const unsigned long park2Start = singleEnd - (FRAM1_PARK2_REC_LEN * FRAM1_PARK2_RECS);
+  chip->memory()[park2Start + (2 * FRAM1_PARK2_REC_LEN)] ^= 0x01;   // First byte of Park 2 record 3
+  check(!boot(SINGLE_ROUTE_RECS, message), "two corrupted records fail verify()");
+  checkMessage(message, "FRAM1 bad Rte 6 +1");
+  {
+    FramLayout layout(FRAM1);
+    describe(&layout, SINGLE_ROUTE_RECS);
+    layout.scan(bad, 4, &badRecs);
+    check((badRecs == 2) && (bad[1].table == 2) && (bad[1].index == 2), "scan() reports Park 2 record 2 as well");
+    layout.scan(bad, 1, &badRecs);
+    check(badRecs == 2, "scan() counts bad records beyond t_maxBad");
+  }
+  populate(SINGLE_ROUTE_RECS);
+  chip->memory()[singleEnd + SINGLE_ROUTE_RECS + 7] ^= 0x80;   // The stored CRC of Park 1 record 8
+  check(!boot(SINGLE_ROUTE_RECS, message), "a corrupted CRC fails verify()");
+  checkMessage(message, "FRAM1 bad Pk1 8");
+
+  // *** Header problems.
+  populate(SINGLE_ROUTE_RECS);
+  check(!boot(DOUBLE_ROUTE_RECS, message), "tables populated for another layout fail verify()");
+  checkMessage(message, "FRAM1 bad layout 4");
+  chip->memory()[FRAM_LAYOUT_OFFSET + 5] ^= 0x01;
+  check(!boot(SINGLE_ROUTE_RECS, message), "a damaged header fails verify()");
+  checkMessage(message, "FRAM1 bad layout 2");
+  memset(chip->memory() + FRAM_LAYOUT_OFFSET, 0, FRAM_LAYOUT_HEADER_LEN);
+  check(!boot(SINGLE_ROUTE_RECS, message), "a FRAM never stamped fails verify()");
+  checkMessage(message, "FRAM1 bad layout 1");
+
+  // *** Double-level: 93 per-record CRCs won't fit in 8K, so each table gets a CRC-16 in the header instead.
+  const unsigned long doubleEnd = populate(DOUBLE_ROUTE_RECS);
+  check(doubleEnd + FRAM1_PARK1_RECS + FRAM1_PARK2_RECS + DOUBLE_ROUTE_RECS > 8192, "double-level CRCs really don't fit");
+  check(boot(DOUBLE_ROUTE_RECS, message), "double-level tables pass verify() on an 8K FRAM1");
+  checkMessage(message, "");
+  bool untouched = true;
+  for (unsigned long a = doubleEnd; a < chip->size(); a++) untouched = untouched && (chip->memory()[a] == 0);
+  check(untouched, "nothing is written past the last table");
+  chip->memory()[FRAM1_ROUTE_START + (FRAM1_ROUTE_REC_LEN * DOUBLE_ROUTE_RECS) + (3 * FRAM1_PARK1_REC_LEN) + 9] ^= 0x04;
+  check(!boot(DOUBLE_ROUTE_RECS, message), "a corrupted Park 1 record fails verify()");
+  checkMessage(message, "FRAM1 bad Pk1 table");
+  {
+    FramLayout layout(FRAM1);
+    describe(&layout, DOUBLE_ROUTE_RECS);
+    FRAM1->readControlBlock(controlBuf);
+    check(layout.checkHeader(controlBuf) == layoutOK, "the per-table header checks OK");
+    layout.scan(bad, 4, &badRecs);
+    check((badRecs == 1) && (bad[0].table == 1) && (bad[0].index == FRAM_LAYOUT_WHOLE_TABLE), "scan() reports all of Park 1");
+  }
+  populate(DOUBLE_ROUTE_RECS);
+  chip->memory()[FRAM1_ROUTE_START] ^= 0x01;
+  chip->memory()[doubleEnd - 1] ^= 0x01;
+  check(!boot(DOUBLE_ROUTE_RECS, message), "corrupted Route and Park 2 tables fail verify()");
+  checkMessage(message, "FRAM1 bad Rte table");
+  populate(DOUBLE_ROUTE_RECS);
+  chip->memory()[FRAM_LAYOUT_OFFSET + 3 + (3 * FRAM_LAYOUT_TABLE_LEN)] ^= 0x01;   // A stored table CRC
+  check(!boot(DOUBLE_ROUTE_RECS, message), "a damaged per-table CRC fails verify()");
+  checkMessage(message, "FRAM1 bad layout 2");
+
+  // *** Tables that don't fit at all.
+  {
+    FramLayout layout(FRAM1);
+    layout.addTable(FRAM1_ROUTE_START, 107, FRAM1_ROUTE_REC_LEN);   // Ends at 8366
+    memset(controlBuf, 0, sizeof(controlBuf));
+    check(layout.setHeader(controlBuf) != ferroOK, "setHeader() can't work out the CRC of a table past the top of the FRAM");
+    check(layout.checkHeader(controlBuf) == layoutTooBig, "a table past the top of the FRAM is layoutTooBig");
+  }
+  {
+    FramLayout layout(FRAM1);   // Four tables leave no slot for per-table CRCs
+    describe(&layout, DOUBLE_ROUTE_RECS);
+    layout.addTable(8139, 1, 8);
+    memset(controlBuf, 0, sizeof(controlBuf));
+    layout.setHeader(controlBuf);
+    check(layout.checkHeader(controlBuf) == layoutTooBig, "four tables whose CRCs don't fit are layoutTooBig");
+    check(!layout.verify(controlBuf, "FRAM1", message), "verify() of four tables whose CRCs don't fit");
+    checkMessage(message, "FRAM1 bad layout 5");
+  }
+
+  if (failures == 0) {
+    printf("FramLayout passed every check.\n");
+  } else {
+    printf("%lu FAILURES.\n", failures);
+  }
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// Rev: 10/19/26
+// FramRoutes: the Route Reference table on FRAM1, its origin index and its conflict matrix.  See FramRoutes.h.
+
+#include "FramRoutes.h"
+
+FramRouteIndex::FramRouteIndex(Hackscribble_Ferro * t_FRAM) {
+  // Rev: 10/19/26.
+  m_FRAM = t_FRAM;
+  m_routes = 0;
+}
+
+void FramRouteIndex::begin(const unsigned int t_routes) {
+  // Rev: 10/19/26.
+  m_routes = t_routes;
+  return;
+}
+
+ferroResult FramRouteIndex::find(const byte t_block, const byte t_type, framRouteMatch t_match[], const byte t_maxMatches,
+                                 unsigned int * t_matchCount) {
+  // Rev: 10/19/26.  Lower bound: the first entry whose (block, type) key is not below ours.  Only the 2 key bytes of each probe
+  // are read.  Then stream entries from there until the key changes.
+  const unsigned int key = ((unsigned int)t_block << 8) | t_type;
+  const unsigned long start = indexStart(m_routes);
+  byte entry[FRAM_ROUTE_INDEX_LEN];
+  ferroResult result;
+  * t_matchCount = 0;
+  unsigned int low = 0;
+  unsigned int high = m_routes;
+  while (low < high) {
+    unsigned int mid = low + ((high - low) / 2);
+    result = m_FRAM->read(start + ((unsigned long)mid * FRAM_ROUTE_INDEX_LEN), 2, entry);
+    if (result != ferroOK) return result;
+    if ((((unsigned int)entry[FRAM_ROUTE_IDX_BLOCK] << 8) | entry[FRAM_ROUTE_IDX_TYPE]) < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low == m_routes) return ferroOK;
+
+  result = m_FRAM->beginRead(start + ((unsigned long)low * FRAM_ROUTE_INDEX_LEN),
+                             (unsigned long)(m_routes - low) * FRAM_ROUTE_INDEX_LEN);
+  for (unsigned int i = low; (result == ferroOK) && (i < m_routes); i++) {
+    result = m_FRAM->streamRead(FRAM_ROUTE_INDEX_LEN, entry);
+    if ((result != ferroOK) || (entry[FRAM_ROUTE_IDX_BLOCK] != t_block) || (entry[FRAM_ROUTE_IDX_TYPE] != t_type)) break;
+    if (* t_matchCount < t_maxMatches) {
+      t_match[* t_matchCount].number = entry[FRAM_ROUTE_IDX_NUMBER] | ((unsigned int)entry[FRAM_ROUTE_IDX_NUMBER + 1] << 8);
+      t_match[* t_matchCount].record = entry[FRAM_ROUTE_IDX_RECORD] | ((unsigned int)entry[FRAM_ROUTE_IDX_RECORD + 1] << 8);
+    }
+    (* t_matchCount)++;
+  }
+  m_FRAM->endStream();
+  return result;
+}
+
+unsigned long FramRouteIndex::indexStart(const unsigned int t_routes) {
+  // Rev: 10/19/26.
+  return FRAM_ROUTE_START + ((unsigned long)t_routes * FRAM_ROUTE_REC_LEN);
+}
+
+FramRouteConflicts::FramRouteConflicts(Hackscribble_Ferro * t_FRAM) {
+  // Rev: 10/19/26.
+  m_FRAM = t_FRAM;
+  m_routes = 0;
+  m_rowLen = 0;
+  m_cachedRecord = 0;
+}
+
+bool FramRouteConflicts::begin(const byte t_controlBuf[]) {
+  // Rev: 10/19/26.
+  m_routes = t_controlBuf[FRAM_ROUTE_ADDR_ROUTE_RECS] | ((unsigned int)t_controlBuf[FRAM_ROUTE_ADDR_ROUTE_RECS + 1] << 8);
+  m_rowLen = 0;
+  m_cachedRecord = m_routes;
+  if ((t_controlBuf[FRAM_ROUTE_ADDR_CONFLICTS] != 1) || (rowLen(m_routes) > FRAM_ROUTE_MAX_ROW_LEN)) return false;
+  m_rowLen = rowLen(m_routes);
+  return true;
+}
+
+ferroResult FramRouteConflicts::canRun(const unsigned int t_record, const byte t_active[], bool * t_canRun) {
+  // Rev: 10/19/26.  A dispatcher tends to ask about the same route again as other routes are released, so the row is kept.
+  // The row is streamed, since rows run to FRAM_ROUTE_MAX_ROW_LEN, longer than the 128 bytes read() will take.
+  * t_canRun = false;
+  if ((m_rowLen == 0) || (t_record >= m_routes)) return ferroBadArrayIndex;
+  if (t_record != m_cachedRecord) {
+    ferroResult result = m_FRAM->beginRead(matrixStart(m_routes) + ((unsigned long)t_record * m_rowLen), m_rowLen);
+    if (result == ferroOK) result = m_FRAM->streamRead(m_rowLen, m_row);
+    m_FRAM->endStream();
+    if (result != ferroOK) {
+      m_cachedRecord = m_routes;
+      return result;
+    }
+    m_cachedRecord = t_record;
+  }
+  for (byte i = 0; i < m_rowLen; i++) {
+    if ((m_row[i] & t_active[i]) != 0) return ferroOK;
+  }
+  * t_canRun = true;
+  return ferroOK;
+}
+
+byte FramRouteConflicts::getRowLen() {
+  return m_rowLen;
+}
+
+void FramRouteConflicts::setActive(byte t_active[], const unsigned int t_record, const bool t_on) {
+  // Rev: 10/19/26.
+  if (t_on) {
+    t_active[t_record / 8] |= (1 << (t_record % 8));
+  } else {
+    t_active[t_record / 8] &= ~(1 << (t_record % 8));
+  }
+  return;
+}
+
+unsigned int FramRouteConflicts::rowLen(const unsigned int t_routes) {
+  // Rev: 10/19/26.
+  return (t_routes + 7) / 8;
+}
+
+unsigned long FramRouteConflicts::matrixStart(const unsigned int t_routes) {
+  // Rev: 10/19/26.
+  return FramRouteIndex::indexStart(t_routes) + ((unsigned long)t_routes * FRAM_ROUTE_INDEX_LEN);
+}
@@ -0,0 +1,148 @@
+// Rev: 10/19/26
+// FramRoutes describes the Route Reference table as it is stored on the 256KB FRAM1 (see Processing_Receive_Routes): where
+// things are in the control block, how a route record is laid out, and what the route step codes mean.
+
+// RouteCompiler (see extras/host) builds a complete FRAM1 image in this format on the PC, from a text file of routes, and
+// FramSend (see libraries/FramIngest/extras/host) loads it.  Everything that reads the table should use these numbers rather
+// than its own copies, so the two ends can't drift apart.
+// Route record, FRAM_ROUTE_REC_LEN bytes, the same bytes as Processing_Receive_Routes' struct routeReference on the Mega:
+//   0..1   route number, low byte first.  Not in sorted order.
+//   2..3   origin: step type (STEP_BE or STEP_BW) and block number
+//   4..5   destination: likewise
+//   6      levels: 1 or 2
+//   7      type: 'A'uto or 'P'ark
+//   8      priority: 1 (high) .. 5 (low)
+//   9..    FRAM_ROUTE_MAX_STEPS steps of 2 bytes each, type then value.  Step 0 repeats the origin, the last real step is the
+//          destination, and the rest are STEP_CM.
+// The record has no padding on the Mega, but would on a PC, so host code packs and unpacks it byte by byte using the
+// FRAM_ROUTE_OFS_ offsets below.
+// Origin index, right after the last route record (so at FRAM_ROUTE_START + (routes * FRAM_ROUTE_REC_LEN)): one
+// FRAM_ROUTE_INDEX_LEN-byte entry per route, sorted by origin block and then direction (BE before BW), and within the same
+// origin in table order (which should be priority order.)  Each entry is origin block, origin step type, route number (2 bytes) and
+// record number (2 bytes).  FramRouteIndex finds every route leaving a block by binary search on the entries, instead of
+// reading every record: about a dozen 2-byte reads for 2,700 routes, where reading the table is 240KB of SPI.
+// Conflict matrix, right after the index if it fits in the FRAM (control block byte FRAM_ROUTE_ADDR_CONFLICTS says whether it's
+// there): one row per route record, with one bit per route record, set if the two routes can't both be set at once because
+// they share a block or need a turnout in opposite positions.  Bit (r % 8) of byte (r / 8) of row x is for record r, and
+// every route conflicts with itself.  FramRouteConflicts keeps one row in RAM, so asking whether route x can run alongside a
+// set of active routes is one AND per byte of the row against the same-shaped bit set of active routes; a dispatcher never has
+// to walk two routes' steps.  A row is (routes + 7) / 8 bytes, so the matrix grows as the square of the number of routes and
+// only fits up to about 1,100 routes.
+// FramLayout treats the Route Reference table as table 0, the index as table 1 and the conflict matrix (if any) as table 2, so
+// they all have record CRCs.
+
+#ifndef FRAM_ROUTES_H
+#define FRAM_ROUTES_H
+
+#include "Arduino.h"
+#include "Hackscribble_Ferro.h"
+
+// FRAM1 control block
+const byte          FRAM_ROUTE_ADDR_VERSION    =   0;  // 3 bytes: version date MM, DD, YY
+const byte          FRAM_ROUTE_ADDR_TURNOUTS   =   3;  // 8 bytes: last-known turnout positions, 1 bit each, 0 = Normal
+const byte          FRAM_ROUTE_ADDR_TRAIN_LOCS =  11;  // 3 bytes per train: train number, last-known block, direction
+const byte          FRAM_ROUTE_ADDR_ROUTE_RECS =  71;  // 2 bytes: number of Route Reference records, low byte first
+const byte          FRAM_ROUTE_ADDR_CONFLICTS  =  73;  // 1 byte: 1 if the conflict matrix follows the index, else 0
+const byte          FRAM_ROUTE_MAX_TRAINS      =  10;  // Trains in the last-known location table
+const byte          FRAM_ROUTE_MAX_TURNOUTS    =  64;  // Bits in the last-known turnout positions
+
+// Route Reference table
+const unsigned long FRAM_ROUTE_START           = 128;  // Record 0, right after the control block
+const byte          FRAM_ROUTE_MAX_STEPS       =  40;  // Including the origin in step 0
+const byte          FRAM_ROUTE_OFS_NUMBER      =   0;
+const byte          FRAM_ROUTE_OFS_ORIGIN      =   2;
+const byte          FRAM_ROUTE_OFS_DEST        =   4;
+const byte          FRAM_ROUTE_OFS_LEVELS      =   6;
+const byte          FRAM_ROUTE_OFS_TYPE        =   7;
+const byte          FRAM_ROUTE_OFS_PRIORITY    =   8;
+const byte          FRAM_ROUTE_OFS_STEPS       =   9;
+const byte          FRAM_ROUTE_REC_LEN         = FRAM_ROUTE_OFS_STEPS + (2 * FRAM_ROUTE_MAX_STEPS);  // 89 bytes
+
+// Route step types, as in Processing_Receive_Routes.  Written in text as the two letters plus a number, i.e. "BE27", "CR06".
+const byte          STEP_CM                    =   0;  // CM00.  Unused step, padding after the destination
+const byte          STEP_FD                    =   1;  // FD00.  Put the loco in Forward
+const byte          STEP_RD                    =   2;  // RD00.  Put the loco in Reverse
+const byte          STEP_BE                    =   3;  // BEnn.  Block nn, eastbound
+const byte          STEP_BW                    =   4;  // BWnn.  Block nn, westbound
+const byte          STEP_CN                    =   5;  // CNnn.  Turnout nn, converging from its Normal fork
+const byte          STEP_CR                    =   6;  // CRnn.  Turnout nn, converging from its Reverse fork
+const byte          STEP_DN                    =   7;  // DNnn.  Turnout nn, diverging to its Normal fork
+const byte          STEP_DR                    =   8;  // DRnn.  Turnout nn, diverging to its Reverse fork
+const byte          STEP_TYPES                 =   9;
+
+// Origin index
+const byte          FRAM_ROUTE_INDEX_LEN       =   6;  // Bytes per index entry
+const byte          FRAM_ROUTE_IDX_BLOCK       =   0;  // Entry offsets, as above
+const byte          FRAM_ROUTE_IDX_TYPE        =   1;
+const byte          FRAM_ROUTE_IDX_NUMBER      =   2;
+const byte          FRAM_ROUTE_IDX_RECORD      =   4;
+
+// Conflict matrix
+const byte          FRAM_ROUTE_MAX_ROW_LEN     = 140;  // Longest row FramRouteConflicts can hold: 1,120 routes, more than fit
+
+struct framRouteMatch {    // FramRouteIndex::find() returns each route leaving the block as one of these
+  unsigned int number;     // Route number
+  unsigned int record;     // Record number in the Route Reference table, 0..routes-1
+};
+
+class FramRouteIndex
+{
+  public:
+
+    FramRouteIndex(Hackscribble_Ferro * t_FRAM);  // Constructor.  Does not touch the FRAM.
+
+    void begin(const unsigned int t_routes);
+    // t_routes is the Route Reference record count from control block bytes FRAM_ROUTE_ADDR_ROUTE_RECS..+1.
+
+    ferroResult find(const byte t_block, const byte t_type, framRouteMatch t_match[], const byte t_maxMatches,
+                     unsigned int * t_matchCount);
+    // Finds every route whose origin is block t_block going t_type (STEP_BE or STEP_BW).  The first t_maxMatches, in priority
+    // order, go in t_match[], and * t_matchCount is set to how many there are altogether.  Returns any error from the FRAM.
+    // Costs one 2-byte read per halving of the index, then one stream of just the matching entries.
+
+    static unsigned long indexStart(const unsigned int t_routes);
+    // FRAM address of index entry 0.
+
+  private:
+
+    Hackscribble_Ferro * m_FRAM;
+    unsigned int m_routes;
+
+};
+
+class FramRouteConflicts
+{
+  public:
+
+    FramRouteConflicts(Hackscribble_Ferro * t_FRAM);  // Constructor.  Does not touch the FRAM.
+
+    bool begin(const byte t_controlBuf[]);
+    // Takes the route count and whether there's a matrix from the FRAM1 control block just read.  Returns false if there's no
+    // conflict matrix, in which case canRun() always says no and returns ferroBadArrayIndex.
+
+    ferroResult canRun(const unsigned int t_record, const byte t_active[], bool * t_canRun);
+    // Sets * t_canRun to whether route record t_record conflicts with none of the records in t_active[], a set of getRowLen()
+    // bytes built with setActive().  Reads the record's row from the FRAM only if it isn't the row we already have, so asking
+    // about the same route again costs no SPI at all.  Returns ferroBadArrayIndex for a record that isn't in the table.
+
+    byte getRowLen();
+    // Bytes in a row, and in an active set.  0 if there's no matrix.
+
+    static void setActive(byte t_active[], const unsigned int t_record, const bool t_on);
+    // Adds record t_record to, or removes it from, the active set t_active[].  Start with all zeroes.
+
+    static unsigned int rowLen(const unsigned int t_routes);
+    static unsigned long matrixStart(const unsigned int t_routes);
+    // Row length and FRAM address of row 0, for a table of t_routes routes, whether or not the matrix would fit.
+
+  private:
+
+    Hackscribble_Ferro * m_FRAM;
+    unsigned int m_routes;
+    byte m_rowLen;
+    unsigned int m_cachedRecord;                 // Record whose row is in m_row[]; m_routes if none
+    byte m_row[FRAM_ROUTE_MAX_ROW_LEN];
+
+};
+
+#endif
@@ -0,0 +1,77 @@
+// Rev: 10/19/26
+// RouteCompile: checks a route file and, if it's clean, writes the FRAM1 image and the header of constants that go with it.
+// See RouteCompiler.h, and Routes.txt for the file format.
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramLayout
+//       -I libraries/FramIngest -I libraries/FramRoutes -o RouteCompile libraries/FramRoutes/extras/host/RouteCompile.cpp
+//       libraries/FramRoutes/extras/host/RouteCompiler.cpp libraries/FramRoutes/FramRoutes.cpp libraries/FramLayout/FramLayout.cpp
+//       libraries/FramIngest/FramIngest.cpp libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp
+//       libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp
+// Run:
+//   ./RouteCompile libraries/FramRoutes/extras/host/Routes.txt FRAM1.bin RouteImage.h
+//   ./FramSend /dev/ttyACM0 FRAM1.bin
+// The second step loads the image into a Mega running Processing_Receive_Routes with RECEIVE_IMAGE defined.
+// Nothing is written unless the route file is clean.  The exit status is the number of errors (at most 255), so a script can
+// stop before FramSend.
+
+#include "RouteCompiler.h"
+#include "FerroEmulator.h"
+#include "FramIngest.h"
+
+#include <time.h>
+#include <unistd.h>
+
+const byte PIN_FRAM1 = 53;   // As in Processing_Receive_Routes; only needs to match between the emulator and the library
+
+int main(int argc, char * argv[]) {
+  if (argc != 4) {
+    printf("Usage: RouteCompile <route file> <image file> <header file>\n");
+    return 1;
+  }
+  struct timespec startTime;
+  struct timespec endTime;
+  clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+  RouteCompiler compiler;
+  if (!compiler.readFile(argv[1])) {
+    printf("Can't open %s.\n", argv[1]);
+    return 1;
+  }
+  unsigned int errors = compiler.check();
+  if (errors > 0) {
+    printf("%u errors; nothing written.\n", errors);
+    return (errors > 255) ? 255 : errors;
+  }
+
+  // The image is built on an emulated MB85RS2MT whose memory is the image file itself, then cut down to what was written so
+  // FramSend doesn't send the empty rest of the FRAM.  Start from an empty file so nothing is left over from an older image.
+  unlink(argv[2]);
+  const unsigned long imageLen = compiler.getImageLen();
+  uint32_t imageID = 0;
+  {
+    FerroEmulator FRAM1Chip(MB85RS2MT, PIN_FRAM1, argv[2]);
+    if (!FRAM1Chip.isOpen()) {
+      printf("Can't create %s.\n", argv[2]);
+      return 1;
+    }
+    Hackscribble_Ferro FRAM1(MB85RS2MT, PIN_FRAM1);
+    if ((FRAM1.begin() != ferroOK) || (compiler.writeImage(&FRAM1) != ferroOK)) {
+      printf("Writing the image failed.\n");
+      return 1;
+    }
+    imageID = FramIngest::crc32(0, FRAM1Chip.memory(), imageLen);
+  }
+  if ((truncate(argv[2], imageLen) != 0) || !compiler.writeHeader(argv[3], imageID)) {
+    printf("Can't write %s or %s.\n", argv[2], argv[3]);
+    return 1;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &endTime);
+  double ms = ((endTime.tv_sec - startTime.tv_sec) * 1000.0) + ((endTime.tv_nsec - startTime.tv_nsec) / 1000000.0);
+  printf("%u routes, %lu byte image, ID %08X.  Took %.1f ms.\n", compiler.getRouteCount(), imageLen,
+         (unsigned int)imageID, ms);
+  if (!compiler.hasConflictMatrix()) {
+    printf("Too many routes for a conflict matrix in the FRAM; the image has none.\n");
+  }
+  return 0;
+}
@@ -0,0 +1,563 @@
+// Rev: 10/19/26
+// RouteCompiler: route file to FRAM1 image.  See RouteCompiler.h.
+
+#include "RouteCompiler.h"
+#include "FramLayout.h"
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <algorithm>
+
+const char STEP_NAME[STEP_TYPES][3] = { "CM", "FD", "RD", "BE", "BW", "CN", "CR", "DN", "DR" };
+
+RouteCompiler::RouteCompiler() {
+  // Rev: 10/19/26.
+  m_path = "";
+  m_line = 0;
+  m_errors = 0;
+  memset(m_version, 0, sizeof(m_version));
+  m_haveVersion = false;
+  m_blocks = 0;
+  m_turnouts = 0;
+}
+
+bool RouteCompiler::readFile(const char t_path[]) {
+  // Rev: 10/19/26.
+  FILE * f = fopen(t_path, "r");
+  if (f == NULL) return false;
+  m_path = t_path;
+  m_line = 0;
+  char text[ROUTE_COMPILER_MAX_LINE];
+  while (fgets(text, sizeof(text), f) != NULL) {
+    m_line++;
+    if ((strchr(text, '\n') == NULL) && !feof(f)) {
+      m_error(m_line, "line is longer than %u characters", ROUTE_COMPILER_MAX_LINE - 2);
+      int c;
+      while (((c = fgetc(f)) != EOF) && (c != '\n')) { }
+      continue;
+    }
+    m_parseLine(text);
+  }
+  fclose(f);
+  return true;
+}
+
+unsigned int RouteCompiler::check() {
+  // Rev: 10/19/26.
+  if (!m_haveVersion) m_error(0, "no \"version\" line; the modules check the version date in the control block");
+  if (m_blocks == 0) m_error(0, "no \"blocks\" line");
+  if (m_turnouts == 0) m_error(0, "no \"turnouts\" line");
+  if (m_turnouts > FRAM_ROUTE_MAX_TURNOUTS) {
+    m_error(0, "%u turnouts, but the control block only has last-known bits for %u", m_turnouts, FRAM_ROUTE_MAX_TURNOUTS);
+  }
+  if (m_route.size() == 0) m_error(0, "no routes");
+
+  m_joined.assign(ROUTE_COMPILER_ELEMENTS * ROUTE_COMPILER_ELEMENTS, false);
+  for (unsigned int i = 0; i < m_trackA.size(); i++) {
+    for (byte j = 0; j < 2; j++) {
+      unsigned int id = (j == 0) ? m_trackA[i] : m_trackB[i];
+      if ((id < 256) ? (id > m_blocks) : ((id - 256) > m_turnouts)) {
+        m_error(m_trackLine[i], "no such %s %u", (id < 256) ? "block" : "turnout", id % 256);
+      }
+    }
+    m_joined[(m_trackA[i] * ROUTE_COMPILER_ELEMENTS) + m_trackB[i]] = true;
+    m_joined[(m_trackB[i] * ROUTE_COMPILER_ELEMENTS) + m_trackA[i]] = true;
+  }
+
+  for (unsigned int i = 0; i < m_route.size(); i++) {
+    m_checkRoute(&m_route[i]);
+  }
+
+  // Duplicate route numbers: sort (number, index) pairs so each clash is reported once, next to the first use.
+  std::vector<unsigned long> byNumber(m_route.size());
+  for (unsigned int i = 0; i < m_route.size(); i++) {
+    byNumber[i] = ((unsigned long)m_route[i].number << 32) | i;
+  }
+  std::sort(byNumber.begin(), byNumber.end());
+  for (unsigned int i = 1; i < byNumber.size(); i++) {
+    if ((byNumber[i] >> 32) == (byNumber[i - 1] >> 32)) {
+      const routeCompilerRoute * first = &m_route[byNumber[i - 1] & 0xFFFFFFFFUL];
+      const routeCompilerRoute * again = &m_route[byNumber[i] & 0xFFFFFFFFUL];
+      m_error(again->line, "route %u is already on line %u", again->number, first->line);
+    }
+  }
+
+  if (m_route.size() > 65535) {
+    m_error(0, "%lu routes; the control block record count only goes to 65535", (unsigned long)m_route.size());
+  } else if (getImageLen() > 262144UL) {
+    m_error(0, "image is %lu bytes, which doesn't fit in a 256KB FRAM1", getImageLen());
+  }
+  return m_errors;
+}
+
+unsigned int RouteCompiler::getRouteCount() {
+  return m_route.size();
+}
+
+const routeCompilerRoute * RouteCompiler::getRoute(const unsigned int t_index) {
+  return &m_route[t_index];
+}
+
+bool RouteCompiler::hasConflictMatrix() {
+  // Rev: 10/19/26.  A row plus its CRC byte per route, on top of everything else.
+  const unsigned long routes = m_route.size();
+  const unsigned long rowLen = FramRouteConflicts::rowLen(routes);
+  return (routes > 0) && (rowLen <= FRAM_ROUTE_MAX_ROW_LEN) &&
+         (FRAM_ROUTE_START + (routes * (FRAM_ROUTE_REC_LEN + FRAM_ROUTE_INDEX_LEN + 2 + rowLen + 1)) <= 262144UL);
+}
+
+unsigned long RouteCompiler::getImageLen() {
+  // Rev: 10/19/26.  Control block, route records, index entries, matrix rows, then FramLayout's one CRC byte per record, per
+  // entry and per row.
+  const unsigned long routes = m_route.size();
+  unsigned long len = FRAM_ROUTE_START + (routes * (FRAM_ROUTE_REC_LEN + FRAM_ROUTE_INDEX_LEN + 2));
+  if (hasConflictMatrix()) len += routes * (FramRouteConflicts::rowLen(routes) + 1);
+  return len;
+}
+
+ferroResult RouteCompiler::writeImage(Hackscribble_Ferro * t_FRAM) {
+  // Rev: 10/19/26.  Records go as one write stream, the index as another and the matrix as a third, each followed by its CRCs,
+  // then the control block, the same order Populate uses.
+  const unsigned int recs = m_route.size();
+  const unsigned long indexStart = FramRouteIndex::indexStart(recs);
+  const bool matrix = hasConflictMatrix();
+  const unsigned int rowLen = FramRouteConflicts::rowLen(recs);
+  FramLayout layout(t_FRAM);
+  layout.addTable(FRAM_ROUTE_START, recs, FRAM_ROUTE_REC_LEN);
+  layout.addTable(indexStart, recs, FRAM_ROUTE_INDEX_LEN);
+  if (matrix) layout.addTable(FramRouteConflicts::matrixStart(recs), recs, rowLen);
+  byte rec[FRAM_ROUTE_REC_LEN];
+
+  ferroResult result = t_FRAM->beginWrite(FRAM_ROUTE_START, (unsigned long)recs * FRAM_ROUTE_REC_LEN);
+  for (unsigned int i = 0; (result == ferroOK) && (i < recs); i++) {
+    packRecord(&m_route[i], rec);
+    result = t_FRAM->streamWrite(FRAM_ROUTE_REC_LEN, rec);
+  }
+  t_FRAM->endStream();
+  for (unsigned int i = 0; (result == ferroOK) && (i < recs); i++) {
+    packRecord(&m_route[i], rec);
+    result = layout.writeRecordCRC(0, i, rec);
+  }
+
+  // Origin index: record numbers sorted by (origin block, direction), keeping table order among routes with the same origin.
+  std::vector<unsigned int> order(recs);
+  for (unsigned int i = 0; i < recs; i++) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [this](const unsigned int a, const unsigned int b) {
+    return ((m_route[a].stepVal[0] << 8) | m_route[a].stepType[0]) < ((m_route[b].stepVal[0] << 8) | m_route[b].stepType[0]);
+  });
+  byte entry[FRAM_ROUTE_INDEX_LEN];
+  if (result == ferroOK) result = t_FRAM->beginWrite(indexStart, (unsigned long)recs * FRAM_ROUTE_INDEX_LEN);
+  for (unsigned int i = 0; (result == ferroOK) && (i < recs); i++) {
+    packIndexEntry(&m_route[order[i]], order[i], entry);
+    result = t_FRAM->streamWrite(FRAM_ROUTE_INDEX_LEN, entry);
+  }
+  t_FRAM->endStream();
+  for (unsigned int i = 0; (result == ferroOK) && (i < recs); i++) {
+    packIndexEntry(&m_route[order[i]], order[i], entry);
+    result = layout.writeRecordCRC(1, i, entry);
+  }
+
+  // Conflict matrix: every route's mask once, then each row is its route's mask against all of them, a row at a time.
+  if (matrix) {
+    std::vector<byte> mask((unsigned long)recs * ROUTE_COMPILER_MASK_LEN);
+    for (unsigned int i = 0; i < recs; i++) {
+      routeMask(&m_route[i], &mask[(unsigned long)i * ROUTE_COMPILER_MASK_LEN]);
+    }
+    std::vector<byte> row((unsigned long)recs * rowLen, 0);
+    for (unsigned int i = 0; i < recs; i++) {
+      const byte * a = &mask[(unsigned long)i * ROUTE_COMPILER_MASK_LEN];
+      for (unsigned int j = 0; j < recs; j++) {
+        const byte * b = &mask[(unsigned long)j * ROUTE_COMPILER_MASK_LEN];
+        byte hit = 0;
+        for (byte k = 0; (hit == 0) && (k < 32); k++) {
+          hit = (a[k] & b[k]) | (a[32 + k] & b[64 + k]) | (a[64 + k] & b[32 + k]);
+        }
+        if (hit != 0) row[((unsigned long)i * rowLen) + (j / 8)] |= (1 << (j % 8));
+      }
+    }
+    if (result == ferroOK) result = t_FRAM->beginWrite(FramRouteConflicts::matrixStart(recs), (unsigned long)recs * rowLen);
+    for (unsigned int i = 0; (result == ferroOK) && (i < recs); i++) {
+      result = t_FRAM->streamWrite(rowLen, &row[(unsigned long)i * rowLen]);
+    }
+    t_FRAM->endStream();
+    for (unsigned int i = 0; (result == ferroOK) && (i < recs); i++) {
+      result = layout.writeRecordCRC(2, i, &row[(unsigned long)i * rowLen]);
+    }
+  }
+  if (result != ferroOK) return result;
+
+  byte controlBuf[128];
+  memset(controlBuf, 0, sizeof(controlBuf));
+  memcpy(controlBuf + FRAM_ROUTE_ADDR_VERSION, m_version, 3);
+  for (byte i = 0; i < FRAM_ROUTE_MAX_TRAINS; i++) {   // Same defaults as Processing_Receive_Routes: train n, block 0, ' '
+    controlBuf[FRAM_ROUTE_ADDR_TRAIN_LOCS + (i * 3)] = i + 1;
+    controlBuf[FRAM_ROUTE_ADDR_TRAIN_LOCS + (i * 3) + 2] = ' ';
+  }
+  controlBuf[FRAM_ROUTE_ADDR_ROUTE_RECS] = recs & 0xFF;
+  controlBuf[FRAM_ROUTE_ADDR_ROUTE_RECS + 1] = recs >> 8;
+  controlBuf[FRAM_ROUTE_ADDR_CONFLICTS] = matrix ? 1 : 0;
+  layout.setHeader(controlBuf);
+  t_FRAM->writeControlBlock(controlBuf);
+  return ferroOK;
+}
+
+bool RouteCompiler::writeHeader(const char t_path[], const uint32_t t_imageID) {
+  // Rev: 10/19/26.
+  FILE * f = fopen(t_path, "w");
+  if (f == NULL) return false;
+  unsigned int maxSteps = 0;
+  for (unsigned int i = 0; i < m_route.size(); i++) {
+    if (m_route[i].stepCount > maxSteps) maxSteps = m_route[i].stepCount;
+  }
+  const char * name = strrchr(m_path, '/');
+  name = (name == NULL) ? m_path : name + 1;
+  fprintf(f, "// Generated by RouteCompiler from %s.  Don't edit; change the route file and run RouteCompiler again.\n", name);
+  fprintf(f, "// Describes the FRAM1 image written by the same run.  The record layout itself is in FramRoutes.h.\n\n");
+  fprintf(f, "#ifndef ROUTE_IMAGE_H\n#define ROUTE_IMAGE_H\n\n");
+  fprintf(f, "const byte          ROUTE_IMAGE_VERSION[3]  = { %u, %u, %u };  // Control block bytes 0..2, MM DD YY\n",
+          m_version[0], m_version[1], m_version[2]);
+  fprintf(f, "const byte          ROUTE_IMAGE_BLOCKS      = %6u;  // Blocks are numbered 1..this\n", m_blocks);
+  fprintf(f, "const byte          ROUTE_IMAGE_TURNOUTS    = %6u;  // Turnouts are numbered 1..this\n", m_turnouts);
+  fprintf(f, "const unsigned int  ROUTE_IMAGE_ROUTES      = %6lu;  // Route Reference records, from FRAM_ROUTE_START\n",
+          (unsigned long)m_route.size());
+  fprintf(f, "const byte          ROUTE_IMAGE_MAX_STEPS   = %6u;  // Most real steps in any route, origin included\n",
+          maxSteps);
+  fprintf(f, "const unsigned long ROUTE_IMAGE_INDEX_START = %6lu;  // Origin index, FRAM_ROUTE_INDEX_LEN bytes per route\n",
+          FramRouteIndex::indexStart(m_route.size()));
+  const unsigned long matrixStart = FramRouteConflicts::matrixStart(m_route.size());
+  const unsigned int rowLen = hasConflictMatrix() ? FramRouteConflicts::rowLen(m_route.size()) : 0;
+  fprintf(f, "const unsigned long ROUTE_IMAGE_CONFLICTS   = %6lu;  // Conflict matrix, or 0 if it didn't fit\n",
+          (rowLen > 0) ? matrixStart : 0);
+  fprintf(f, "const byte          ROUTE_IMAGE_ROW_LEN     = %6u;  // Bytes per conflict matrix row, or 0\n", rowLen);
+  fprintf(f, "const unsigned long ROUTE_IMAGE_CRC_START   = %6lu;  // FramLayout CRCs, per route, per index entry, per row\n",
+          matrixStart + ((unsigned long)m_route.size() * rowLen));
+  fprintf(f, "const unsigned long ROUTE_IMAGE_LEN         = %6lu;  // Bytes in the image file\n", getImageLen());
+  fprintf(f, "const uint32_t      ROUTE_IMAGE_ID          = 0x%08XUL;  // CRC-32 of the image, as FramSend sends it\n",
+          (unsigned int)t_imageID);
+  fprintf(f, "\n#endif\n");
+  return (fclose(f) == 0);
+}
+
+void RouteCompiler::packRecord(const routeCompilerRoute * t_route, byte t_rec[]) {
+  // Rev: 10/19/26.
+  memset(t_rec, 0, FRAM_ROUTE_REC_LEN);   // STEP_CM is 0, so this pads the unused steps too
+  t_rec[FRAM_ROUTE_OFS_NUMBER] = t_route->number & 0xFF;
+  t_rec[FRAM_ROUTE_OFS_NUMBER + 1] = t_route->number >> 8;
+  t_rec[FRAM_ROUTE_OFS_ORIGIN] = t_route->stepType[0];
+  t_rec[FRAM_ROUTE_OFS_ORIGIN + 1] = t_route->stepVal[0];
+  t_rec[FRAM_ROUTE_OFS_DEST] = t_route->destType;
+  t_rec[FRAM_ROUTE_OFS_DEST + 1] = t_route->destVal;
+  t_rec[FRAM_ROUTE_OFS_LEVELS] = t_route->levels;
+  t_rec[FRAM_ROUTE_OFS_TYPE] = t_route->type;
+  t_rec[FRAM_ROUTE_OFS_PRIORITY] = t_route->priority;
+  for (byte i = 0; i < t_route->stepCount; i++) {
+    t_rec[FRAM_ROUTE_OFS_STEPS + (i * 2)] = t_route->stepType[i];
+    t_rec[FRAM_ROUTE_OFS_STEPS + (i * 2) + 1] = t_route->stepVal[i];
+  }
+  return;
+}
+
+void RouteCompiler::packIndexEntry(const routeCompilerRoute * t_route, const unsigned int t_record, byte t_entry[]) {
+  // Rev: 10/19/26.
+  t_entry[FRAM_ROUTE_IDX_BLOCK] = t_route->stepVal[0];
+  t_entry[FRAM_ROUTE_IDX_TYPE] = t_route->stepType[0];
+  t_entry[FRAM_ROUTE_IDX_NUMBER] = t_route->number & 0xFF;
+  t_entry[FRAM_ROUTE_IDX_NUMBER + 1] = t_route->number >> 8;
+  t_entry[FRAM_ROUTE_IDX_RECORD] = t_record & 0xFF;
+  t_entry[FRAM_ROUTE_IDX_RECORD + 1] = t_record >> 8;
+  return;
+}
+
+void RouteCompiler::routeMask(const routeCompilerRoute * t_route, byte t_mask[]) {
+  // Rev: 10/19/26.  FD, RD and CM steps don't occupy anything.
+  memset(t_mask, 0, ROUTE_COMPILER_MASK_LEN);
+  for (byte i = 0; i < t_route->stepCount; i++) {
+    const byte type = t_route->stepType[i];
+    const byte val = t_route->stepVal[i];
+    byte base;
+    if ((type == STEP_BE) || (type == STEP_BW)) {
+      base = 0;
+    } else if ((type == STEP_CN) || (type == STEP_DN)) {
+      base = 32;
+    } else if ((type == STEP_CR) || (type == STEP_DR)) {
+      base = 64;
+    } else {
+      continue;
+    }
+    t_mask[base + (val / 8)] |= (1 << (val % 8));
+  }
+  return;
+}
+
+void RouteCompiler::m_parseLine(char t_text[]) {
+  // Rev: 10/19/26.  Strip the comment and surrounding blanks, then go by the first word.  A line starting with a digit is a route.
+  char * hash = strchr(t_text, '#');
+  if (hash != NULL) * hash = '\0';
+  while (isspace((unsigned char)* t_text)) t_text++;
+  char * end = t_text + strlen(t_text);
+  while ((end > t_text) && isspace((unsigned char)end[-1])) * --end = '\0';
+  if (* t_text == '\0') return;
+  if (isdigit((unsigned char)* t_text)) {
+    m_parseRoute(t_text);
+    return;
+  }
+
+  const char * word[ROUTE_COMPILER_MAX_LINE / 2];
+  unsigned int words = 0;
+  for (char * p = strtok(t_text, " \t\r"); p != NULL; p = strtok(NULL, " \t\r")) {
+    word[words++] = p;
+  }
+  if (words == 0) return;
+  unsigned long val;
+  if (strcmp(word[0], "version") == 0) {
+    if (words != 4) {
+      m_error(m_line, "version needs month, day and year, i.e. \"version 10 19 26\"");
+      return;
+    }
+    for (byte i = 0; i < 3; i++) {
+      if (!m_parseNumber(word[i + 1], (i == 0) ? 12 : ((i == 1) ? 31 : 99), &val) || ((i < 2) && (val == 0))) {
+        m_error(m_line, "bad version date \"%s\"", word[i + 1]);
+        return;
+      }
+      m_version[i] = val;
+    }
+    m_haveVersion = true;
+  } else if ((strcmp(word[0], "blocks") == 0) || (strcmp(word[0], "turnouts") == 0)) {
+    if ((words != 2) || !m_parseNumber(word[1], 255, &val) || (val == 0)) {
+      m_error(m_line, "%s needs a count from 1 to 255", word[0]);
+      return;
+    }
+    if (word[0][0] == 'b') {
+      m_blocks = val;
+    } else {
+      m_turnouts = val;
+    }
+  } else if (strcmp(word[0], "track") == 0) {
+    if (words < 3) {
+      m_error(m_line, "track needs at least two elements, i.e. \"track B01 T06 B21\"");
+      return;
+    }
+    unsigned int prev = 0;
+    for (unsigned int i = 1; i < words; i++) {
+      unsigned int id;
+      if (!m_parseElement(word[i], &id)) {
+        m_error(m_line, "bad track element \"%s\"; expected Bnn or Tnn", word[i]);
+        return;
+      }
+      if (i > 1) {
+        m_trackA.push_back(prev);
+        m_trackB.push_back(id);
+        m_trackLine.push_back(m_line);
+      }
+      prev = id;
+    }
+  } else {
+    m_error(m_line, "don't know what \"%s\" means", word[0]);
+  }
+  return;
+}
+
+void RouteCompiler::m_parseRoute(char t_text[]) {
+  // Rev: 10/19/26.  number, origin, destination, levels, type and priority, then the steps after the origin: the same fields,
+  // in the same order, that the Processing program sent to Processing_Receive_Routes.  Trailing CM00 padding is dropped.
+  const char * field[ROUTE_COMPILER_MAX_LINE / 2];
+  unsigned int fields = 0;
+  char * p = t_text;
+  while (true) {
+    char * comma = strchr(p, ',');
+    if (comma != NULL) * comma = '\0';
+    while (isspace((unsigned char)* p)) p++;
+    char * end = p + strlen(p);
+    while ((end > p) && isspace((unsigned char)end[-1])) * --end = '\0';
+    field[fields++] = p;
+    if (comma == NULL) break;
+    p = comma + 1;
+  }
+  if (fields < 6) {
+    m_error(m_line, "a route needs number, origin, destination, levels, type and priority, and at least one step");
+    return;
+  }
+
+  routeCompilerRoute route;
+  memset(&route, 0, sizeof(route));
+  route.line = m_line;
+  unsigned long val;
+  if (!m_parseNumber(field[0], 65535, &val) || (val == 0)) {
+    m_error(m_line, "route number \"%s\" must be 1..65535", field[0]);
+    return;
+  }
+  route.number = val;
+  if (!m_parseStep(field[1], &route.stepType[0], &route.stepVal[0]) ||
+      !m_parseStep(field[2], &route.destType, &route.destVal)) {
+    m_error(m_line, "route %u: bad origin or destination", route.number);
+    return;
+  }
+  if (!m_parseNumber(field[3], 2, &val) || (val == 0)) {
+    m_error(m_line, "route %u: levels must be 1 or 2", route.number);
+    return;
+  }
+  route.levels = val;
+  if ((strlen(field[4]) != 2) || ((field[4][0] != 'A') && (field[4][0] != 'P')) ||
+      (field[4][1] < '1') || (field[4][1] > '5')) {
+    m_error(m_line, "route %u: type and priority \"%s\" must be A or P then 1..5, i.e. \"A1\"", route.number, field[4]);
+    return;
+  }
+  route.type = field[4][0];
+  route.priority = field[4][1] - '0';
+
+  unsigned int steps = fields - 5;
+  byte type;
+  byte stepVal;
+  while (steps > 0) {
+    if (!m_parseStep(field[5 + steps - 1], &type, &stepVal) || (type != STEP_CM)) break;
+    steps--;
+  }
+  if (steps + 1 > FRAM_ROUTE_MAX_STEPS) {
+    m_error(m_line, "route %u has %u steps after the origin; a record only holds %u", route.number, steps,
+            FRAM_ROUTE_MAX_STEPS - 1);
+    return;
+  }
+  route.stepCount = steps + 1;
+  for (unsigned int i = 1; i <= steps; i++) {
+    if (!m_parseStep(field[4 + i], &route.stepType[i], &route.stepVal[i])) {
+      m_error(m_line, "route %u: step %u \"%s\" isn't a step like BE01 or DR12, or its number is over 255", route.number, i,
+              field[4 + i]);
+      return;
+    }
+  }
+  m_route.push_back(route);
+  return;
+}
+
+bool RouteCompiler::m_parseStep(const char t_text[], byte * t_type, byte * t_val) {
+  // Rev: 10/19/26.  Two letters then the number, i.e. "BE01".  Numbers over 255 don't fit the step's value byte.
+  if (strlen(t_text) < 3) return false;
+  for (byte i = 0; i < STEP_TYPES; i++) {
+    if ((t_text[0] == STEP_NAME[i][0]) && (t_text[1] == STEP_NAME[i][1])) {
+      unsigned long val;
+      if (!m_parseNumber(t_text + 2, 255, &val)) return false;
+      * t_type = i;
+      * t_val = val;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RouteCompiler::m_parseNumber(const char t_text[], const unsigned long t_max, unsigned long * t_val) {
+  // Rev: 10/19/26.  Digits only, no sign, and at most t_max.
+  if ((* t_text == '\0') || (strlen(t_text) > 9)) return false;
+  unsigned long val = 0;
+  for (const char * p = t_text; * p != '\0'; p++) {
+    if (!isdigit((unsigned char)* p)) return false;
+    val = (val * 10) + (* p - '0');
+  }
+  if (val > t_max) return false;
+  * t_val = val;
+  return true;
+}
+
+bool RouteCompiler::m_parseElement(const char t_text[], unsigned int * t_id) {
+  // Rev: 10/19/26.  "B" or "T" and a number, for track lines.
+  unsigned long val;
+  if (((t_text[0] != 'B') && (t_text[0] != 'T')) || !m_parseNumber(t_text + 1, 255, &val) || (val == 0)) return false;
+  * t_id = (t_text[0] == 'B') ? val : 256 + val;
+  return true;
+}
+
+void RouteCompiler::m_checkRoute(const routeCompilerRoute * t_route) {
+  // Rev: 10/19/26.  Walk the steps once, keeping the last track element seen, which turnouts have been set which way, and which
+  // blocks have been entered since the last change of direction.
+  const unsigned int line = t_route->line;
+  const unsigned int num = t_route->number;
+  if ((t_route->stepType[0] != STEP_BE) && (t_route->stepType[0] != STEP_BW)) {
+    m_error(line, "route %u: origin must be a block, BEnn or BWnn", num);
+    return;
+  }
+  if ((t_route->destType != STEP_BE) && (t_route->destType != STEP_BW)) {
+    m_error(line, "route %u: destination must be a block, BEnn or BWnn", num);
+    return;
+  }
+  if (!m_checkElement(t_route, t_route->stepType[0], t_route->stepVal[0])) return;
+  if (!m_checkElement(t_route, t_route->destType, t_route->destVal)) return;
+
+  byte turnoutSet[256];          // 0 = not used yet, else 'N' or 'R'
+  bool blockEntered[256];
+  memset(turnoutSet, 0, sizeof(turnoutSet));
+  memset(blockEntered, 0, sizeof(blockEntered));
+  blockEntered[t_route->stepVal[0]] = true;
+  unsigned int prev = t_route->stepVal[0];
+  byte lastType = t_route->stepType[0];
+  byte lastVal = t_route->stepVal[0];
+  for (byte i = 1; i < t_route->stepCount; i++) {
+    const byte type = t_route->stepType[i];
+    const byte val = t_route->stepVal[i];
+    if (type == STEP_CM) continue;
+    if ((type == STEP_FD) || (type == STEP_RD)) {
+      memset(blockEntered, 0, sizeof(blockEntered));
+      continue;
+    }
+    if (!m_checkElement(t_route, type, val)) return;
+    const bool isBlock = ((type == STEP_BE) || (type == STEP_BW));
+    const unsigned int id = isBlock ? val : 256 + val;
+    if (id == prev) {
+      m_error(line, "route %u: step %u, %s%02u, is the same %s as the step before it", num, i, STEP_NAME[type], val,
+              isBlock ? "block" : "turnout");
+      return;
+    }
+    if ((m_trackA.size() > 0) && !m_joined[(prev * ROUTE_COMPILER_ELEMENTS) + id]) {
+      m_error(line, "route %u: step %u, %s%02u: no track joins %c%02u to %c%02u", num, i, STEP_NAME[type], val,
+              (prev < 256) ? 'B' : 'T', prev % 256, isBlock ? 'B' : 'T', val);
+      return;
+    }
+    if (isBlock) {
+      if (blockEntered[val]) {
+        m_error(line, "route %u: step %u enters block %u again without a change of direction", num, i, val);
+        return;
+      }
+      blockEntered[val] = true;
+    } else {
+      const byte position = ((type == STEP_CN) || (type == STEP_DN)) ? 'N' : 'R';
+      if ((turnoutSet[val] != 0) && (turnoutSet[val] != position)) {
+        m_error(line, "route %u: turnout %u is needed both Normal and Reverse", num, val);
+        return;
+      }
+      turnoutSet[val] = position;
+    }
+    prev = id;
+    lastType = type;
+    lastVal = val;
+  }
+  if ((lastType != t_route->destType) || (lastVal != t_route->destVal)) {
+    m_error(line, "route %u: the last step is %s%02u, not the destination %s%02u", num, STEP_NAME[lastType], lastVal,
+            STEP_NAME[t_route->destType], t_route->destVal);
+  }
+  return;
+}
+
+bool RouteCompiler::m_checkElement(const routeCompilerRoute * t_route, const byte t_type, const byte t_val) {
+  // Rev: 10/19/26.  Block and turnout numbers must be declared.
+  const bool isBlock = ((t_type == STEP_BE) || (t_type == STEP_BW));
+  if ((t_val == 0) || (t_val > (isBlock ? m_blocks : m_turnouts))) {
+    m_error(t_route->line, "route %u: %s%02u: there is no %s %u", t_route->number, STEP_NAME[t_type], t_val,
+            isBlock ? "block" : "turnout", t_val);
+    return false;
+  }
+  return true;
+}
+
+void RouteCompiler::m_error(const unsigned int t_line, const char t_format[], ...) {
+  // Rev: 10/19/26.  file:line: message, like a compiler, so editors can jump to it.  Line 0 means the file as a whole.
+  if (t_line > 0) {
+    printf("%s:%u: ", m_path, t_line);
+  } else {
+    printf("%s: ", m_path);
+  }
+  va_list args;
+  va_start(args, t_format);
+  vprintf(t_format, args);
+  va_end(args);
+  printf("\n");
+  m_errors++;
+  return;
+}
@@ -0,0 +1,116 @@
+// Rev: 10/19/26
+// RouteCompiler turns a route file (see Routes.txt for the format) into a ready-to-load FRAM1 image and a header of constants
+// to go with it, checking every route on the way.  RouteCompile.cpp is the command-line program that uses it.
+
+// Until now the tables were typed in as literal records in Populate_FRAM_Route_Reference, or sent a field at a time by the
+// Processing program, and nothing checked them: a turnout thrown both ways in one route, a missing turnout between two blocks,
+// or a route with more steps than the record holds all went into the FRAM as-is.
+// check() finds, with the file name and line number of each:
+//   Field widths: route numbers over 65535, block or turnout numbers over 255, too many steps for a record, levels, type and
+//     priority out of range, more turnouts than the last-known bits in the control block, a table too big for the FRAM.
+//   Unknown blocks and turnouts: anything above the "blocks" and "turnouts" counts.
+//   Turnout conflicts: a route that needs the same turnout both Normal and Reverse.
+//   Block continuity: every route must run from its origin to its destination, ending there; no element may follow itself;
+//     a block may not be entered twice without a change of direction; and, if the file has any "track" lines, each step must
+//     be joined by track to the one before it.
+//   Duplicate route numbers.
+// writeImage() then writes the image through Hackscribble_Ferro exactly as a sketch would, normally onto a FerroEmulator chip
+// whose file becomes the image: the control block (version, all turnouts Normal, no known train locations, record count), the
+// Route Reference table in file order starting at FRAM_ROUTE_START, the origin index and, if it fits, the conflict matrix (see
+// FramRoutes.h), and a FramLayout header and record CRCs for all of them.  Two routes conflict if any block appears in both,
+// in either direction, or one needs a turnout Normal that the other needs Reverse.  Every pair is compared through a bit mask
+// per route of the blocks it uses and the turnouts it needs each way, so 1,000 routes is a million 96-byte compares.
+// Everything is held in RAM and each route is parsed and checked in one pass, so thousands of routes take milliseconds.
+
+#ifndef ROUTE_COMPILER_H
+#define ROUTE_COMPILER_H
+
+#include "Arduino.h"
+#include "Hackscribble_Ferro.h"
+#include "FramRoutes.h"
+
+#include <vector>
+
+const unsigned int ROUTE_COMPILER_MAX_LINE = 1024;  // Longest line in a route file
+const unsigned int ROUTE_COMPILER_ELEMENTS = 512;   // Track element IDs: block n is n, turnout n is 256 + n
+const unsigned int ROUTE_COMPILER_MASK_LEN = 96;    // routeMask(): 32 bytes of blocks, 32 of Normal turnouts, 32 of Reverse
+
+struct routeCompilerRoute {
+  unsigned int number;
+  byte destType;                             // STEP_BE or STEP_BW
+  byte destVal;
+  byte levels;
+  char type;                                 // 'A' or 'P'
+  byte priority;
+  byte stepCount;                            // Real steps, origin in step 0 included; the rest of the record is STEP_CM
+  byte stepType[FRAM_ROUTE_MAX_STEPS];
+  byte stepVal[FRAM_ROUTE_MAX_STEPS];
+  unsigned int line;                         // Line of the route file it came from
+};
+
+class RouteCompiler
+{
+  public:
+
+    RouteCompiler();  // Constructor.  Starts with no routes and no layout.
+
+    bool readFile(const char t_path[]);
+    // Reads a whole route file, adding its routes and layout to any already read.  Lines that can't be understood are counted
+    // as errors and reported.  Returns false only if the file can't be opened.
+
+    unsigned int check();
+    // Runs every check described above and returns the total number of errors, including any found by readFile().  Each error
+    // is printed to stdout as it is found.  Don't write an image unless this returns 0.
+
+    unsigned int getRouteCount();
+    const routeCompilerRoute * getRoute(const unsigned int t_index);  // In file order, which is FRAM record order
+
+    bool hasConflictMatrix();
+    // Whether the image will have a conflict matrix: only if it fits in the FRAM, and in a FramRouteConflicts row.
+
+    unsigned long getImageLen();
+    // Bytes from address 0 to the last one writeImage() writes.  The image file should be cut to this length.
+
+    ferroResult writeImage(Hackscribble_Ferro * t_FRAM);
+    // Writes the whole image; the control block goes last.  t_FRAM must already have had begin() called.
+
+    bool writeHeader(const char t_path[], const uint32_t t_imageID);
+    // Writes the header of generated constants.  t_imageID is the CRC-32 of the image, as FramSend will send it.
+
+    static void packRecord(const routeCompilerRoute * t_route, byte t_rec[]);
+    // Fills a FRAM_ROUTE_REC_LEN-byte record the way the Mega lays it out.  See FramRoutes.h.
+
+    static void packIndexEntry(const routeCompilerRoute * t_route, const unsigned int t_record, byte t_entry[]);
+    // Fills a FRAM_ROUTE_INDEX_LEN-byte origin index entry for t_route, which is record t_record.
+
+    static void routeMask(const routeCompilerRoute * t_route, byte t_mask[]);
+    // Fills ROUTE_COMPILER_MASK_LEN bytes: a bit per block the route uses, then per turnout it needs Normal, then Reverse.
+    // Two routes conflict if (block & block) or (Normal & Reverse) or (Reverse & Normal) is non-zero anywhere.
+
+  private:
+
+    void m_parseLine(char t_text[]);
+    void m_parseRoute(char t_text[]);
+    bool m_parseStep(const char t_text[], byte * t_type, byte * t_val);
+    bool m_parseNumber(const char t_text[], const unsigned long t_max, unsigned long * t_val);
+    bool m_parseElement(const char t_text[], unsigned int * t_id);
+    void m_checkRoute(const routeCompilerRoute * t_route);
+    bool m_checkElement(const routeCompilerRoute * t_route, const byte t_type, const byte t_val);
+    void m_error(const unsigned int t_line, const char t_format[], ...);
+
+    const char * m_path;            // File being read, for error messages
+    unsigned int m_line;
+    unsigned int m_errors;
+    byte m_version[3];
+    bool m_haveVersion;
+    unsigned int m_blocks;          // 0 until a "blocks" line is read
+    unsigned int m_turnouts;
+    std::vector<routeCompilerRoute> m_route;
+    std::vector<unsigned int> m_trackA;     // Each "track" join, as two element IDs and the line it came from
+    std::vector<unsigned int> m_trackB;
+    std::vector<unsigned int> m_trackLine;
+    std::vector<bool> m_joined;             // ROUTE_COMPILER_ELEMENTS squared; built by check()
+
+};
+
+#endif
@@ -0,0 +1,191 @@
+// Rev: 10/19/26
+// RouteConflictTest: checks the conflict matrix RouteCompiler writes, and FramRouteConflicts' answers from it, against comparing
+// the two routes' steps directly, on a PC with FerroEmulator.  Also shows what a question costs on the Mega either way.
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramLayout
+//       -I libraries/FramRoutes -o RouteConflictTest libraries/FramRoutes/extras/host/RouteConflictTest.cpp
+//       libraries/FramRoutes/extras/host/RouteCompiler.cpp libraries/FramRoutes/FramRoutes.cpp libraries/FramLayout/FramLayout.cpp
+//       libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp
+// Run:
+//   ./RouteConflictTest libraries/FramRoutes/extras/host/Routes.txt
+// The routes in the file are used as they are, then repeated, renumbered, to make 1,000 routes, 1,100, close to the most that
+// leave room for the matrix and with 138-byte rows (longer than one Ferro read()), and 2,700, which doesn't leave room, so the
+// image must say there's no matrix.  For each size with a matrix, every
+// pair of routes is asked about, then random sets of up to 8 active routes.  The layout header and every CRC are checked too.
+// Scratch files RouteConflictTest.txt and RouteConflictTest.bin are left in the current directory.
+
+#include "RouteCompiler.h"
+#include "FramLayout.h"
+#include "FerroEmulator.h"
+
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+const byte         PIN_FRAM1      = 53;
+const byte         TEST_SIZE_COUNT = 4;
+const unsigned int TEST_SIZES[TEST_SIZE_COUNT] = { 0, 1000, 1100, 2700 };   // 0 means the file as it is
+const unsigned int RANDOM_SETS    = 20000;
+const byte         MAX_ACTIVE     = 8;
+
+// Makes a route file of t_routes routes from t_path by keeping its other lines and repeating its routes with new numbers.
+bool makeRouteFile(const char t_path[], const unsigned int t_routes, const char t_outPath[]) {
+  FILE * in = fopen(t_path, "r");
+  FILE * out = fopen(t_outPath, "w");
+  if ((in == NULL) || (out == NULL)) return false;
+  std::vector<std::string> routes;
+  char text[ROUTE_COMPILER_MAX_LINE];
+  while (fgets(text, sizeof(text), in) != NULL) {
+    const char * p = text;
+    while ((* p == ' ') || (* p == '\t')) p++;
+    if ((* p >= '0') && (* p <= '9')) {
+      routes.push_back(strchr(p, ','));
+    } else {
+      fputs(text, out);
+    }
+  }
+  fclose(in);
+  for (unsigned int i = 0; (routes.size() > 0) && (i < t_routes); i++) {
+    fprintf(out, "%u%s", i + 1, routes[i % routes.size()].c_str());
+  }
+  fclose(out);
+  return (routes.size() > 0);
+}
+
+// The slow, obvious way: every step of one route against every step of the other.
+bool stepsConflict(const routeCompilerRoute * t_a, const routeCompilerRoute * t_b) {
+  for (byte i = 0; i < t_a->stepCount; i++) {
+    const byte typeA = t_a->stepType[i];
+    const bool blockA = ((typeA == STEP_BE) || (typeA == STEP_BW));
+    const bool normalA = ((typeA == STEP_CN) || (typeA == STEP_DN));
+    const bool reverseA = ((typeA == STEP_CR) || (typeA == STEP_DR));
+    for (byte j = 0; j < t_b->stepCount; j++) {
+      const byte typeB = t_b->stepType[j];
+      if (t_a->stepVal[i] != t_b->stepVal[j]) continue;
+      if (blockA && ((typeB == STEP_BE) || (typeB == STEP_BW))) return true;
+      if (normalA && ((typeB == STEP_CR) || (typeB == STEP_DR))) return true;
+      if (reverseA && ((typeB == STEP_CN) || (typeB == STEP_DN))) return true;
+    }
+  }
+  return false;
+}
+
+int main(int argc, char * argv[]) {
+  if (argc != 2) {
+    printf("Usage: RouteConflictTest <route file>\n");
+    return 1;
+  }
+  unsigned long failures = 0;
+  srand(1019);
+  for (byte size = 0; size < TEST_SIZE_COUNT; size++) {
+    RouteCompiler compiler;
+    const char * path = argv[1];
+    if (TEST_SIZES[size] > 0) {
+      path = "RouteConflictTest.txt";
+      if (!makeRouteFile(argv[1], TEST_SIZES[size], path)) path = "";
+    }
+    if (!compiler.readFile(path) || (compiler.check() != 0)) {
+      printf("Couldn't make a clean route file from %s.\n", argv[1]);
+      return 1;
+    }
+    const unsigned int routes = compiler.getRouteCount();
+    unlink("RouteConflictTest.bin");
+    FerroEmulator FRAM1Chip(MB85RS2MT, PIN_FRAM1, "RouteConflictTest.bin");
+    Hackscribble_Ferro FRAM1(MB85RS2MT, PIN_FRAM1);
+    if (!FRAM1Chip.isOpen() || (FRAM1.begin() != ferroOK) || (compiler.writeImage(&FRAM1) != ferroOK)) {
+      printf("Couldn't build the image.\n");
+      return 1;
+    }
+
+    // What a sketch would do at startup: read the control block, check the layout, and pick up the matrix if there is one.
+    byte controlBuf[128];
+    FRAM1.readControlBlock(controlBuf);
+    FramRouteConflicts conflicts(&FRAM1);
+    const bool haveMatrix = conflicts.begin(controlBuf);
+    FramLayout layout(&FRAM1);
+    layout.addTable(FRAM_ROUTE_START, routes, FRAM_ROUTE_REC_LEN);
+    layout.addTable(FramRouteIndex::indexStart(routes), routes, FRAM_ROUTE_INDEX_LEN);
+    if (haveMatrix) layout.addTable(FramRouteConflicts::matrixStart(routes), routes, conflicts.getRowLen());
+    framBadRecord bad[1];
+    unsigned int badCount = 0;
+    if ((layout.checkHeader(controlBuf) != layoutOK) || (layout.scan(bad, 1, &badCount) != ferroOK) || (badCount != 0)) {
+      printf("%u routes: layout header or CRCs don't match (%u bad records).\n", routes, badCount);
+      failures++;
+    }
+    printf("*** %u routes, %lu byte image, ", routes, compiler.getImageLen());
+    if (!haveMatrix) {
+      printf("no conflict matrix\n");
+      if (compiler.hasConflictMatrix()) {
+        printf("The compiler wrote a matrix but FramRouteConflicts didn't find it.\n");
+        failures++;
+      }
+      continue;
+    }
+    printf("%u byte rows\n", conflicts.getRowLen());
+
+    // Every pair, one active route at a time.  Going row by row means each row is read from the FRAM once.
+    std::vector<byte> active(conflicts.getRowLen(), 0);
+    unsigned long pairConflicts = 0;
+    bool canRun;
+    FRAM1Chip.resetStats();
+    for (unsigned int x = 0; x < routes; x++) {
+      for (unsigned int y = 0; y < routes; y++) {
+        FramRouteConflicts::setActive(&active[0], y, true);
+        conflicts.canRun(x, &active[0], &canRun);
+        FramRouteConflicts::setActive(&active[0], y, false);
+        const bool expected = !stepsConflict(compiler.getRoute(x), compiler.getRoute(y));
+        if (canRun != expected) {
+          if (failures < 10) {
+            printf("MISMATCH: routes %u and %u: matrix says %s\n", compiler.getRoute(x)->number, compiler.getRoute(y)->number,
+                   canRun ? "no conflict" : "conflict");
+          }
+          failures++;
+        }
+        if (!canRun) pairConflicts++;
+      }
+    }
+    FRAM1Chip.printStats("Every pair");
+    printf("%-40s %12.1f us per row read; %lu of %lu pairs conflict\n", "", FRAM1Chip.getStats().microseconds / routes,
+           pairConflicts, (unsigned long)routes * routes);
+
+    // Random sets of active routes, with the candidate's row usually not the one already held.
+    unsigned long totalActive = 0;
+    FRAM1Chip.resetStats();
+    for (unsigned int t = 0; t < RANDOM_SETS; t++) {
+      std::fill(active.begin(), active.end(), 0);
+      const unsigned int candidate = rand() % routes;
+      const byte activeCount = rand() % (MAX_ACTIVE + 1);
+      bool expected = true;
+      for (byte i = 0; i < activeCount; i++) {
+        const unsigned int y = rand() % routes;
+        FramRouteConflicts::setActive(&active[0], y, true);
+        if (stepsConflict(compiler.getRoute(candidate), compiler.getRoute(y))) expected = false;
+      }
+      totalActive += activeCount;
+      conflicts.canRun(candidate, &active[0], &canRun);
+      if (canRun != expected) {
+        if (failures < 10) printf("MISMATCH: route %u against a set of %u\n", compiler.getRoute(candidate)->number, activeCount);
+        failures++;
+      }
+    }
+    FRAM1Chip.printStats("Matrix, random active sets");
+    printf("%-40s %12.1f us per question\n", "", FRAM1Chip.getStats().microseconds / RANDOM_SETS);
+
+    // Without the matrix the Mega would have to read the candidate's record and each active route's record and walk their
+    // steps; just the reads, for the same average number of active routes, cost this much.
+    byte rec[FRAM_ROUTE_REC_LEN];
+    const unsigned int recReads = RANDOM_SETS + totalActive;
+    FRAM1Chip.resetStats();
+    for (unsigned int i = 0; i < recReads; i++) {
+      FRAM1.read(FRAM_ROUTE_START + ((unsigned long)(rand() % routes) * FRAM_ROUTE_REC_LEN), FRAM_ROUTE_REC_LEN, rec);
+    }
+    FRAM1Chip.printStats("Reading records instead");
+    printf("%-40s %12.1f us per question, before comparing any steps\n", "", FRAM1Chip.getStats().microseconds / RANDOM_SETS);
+  }
+  if (failures == 0) {
+    printf("The matrix agrees with comparing steps for every question.\n");
+  } else {
+    printf("%lu FAILURES.\n", failures);
+  }
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+// Rev: 10/19/26
+// RouteIndexBench: what "which routes leave this block?" costs on the Mega, by reading the Route Reference table versus looking
+// it up in the origin index, measured against FerroEmulator on a PC.  Also checks that both give the same routes.
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramLayout
+//       -I libraries/FramRoutes -o RouteIndexBench libraries/FramRoutes/extras/host/RouteIndexBench.cpp
+//       libraries/FramRoutes/extras/host/RouteCompiler.cpp libraries/FramRoutes/FramRoutes.cpp libraries/FramLayout/FramLayout.cpp
+//       libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp
+// Run:
+//   ./RouteIndexBench libraries/FramRoutes/extras/host/Routes.txt
+// The routes in the file are repeated, renumbered, to make tables of 300 and 2,700 routes, so the origins are spread the way
+// the real layout's are.  2,700 is the most that fit in a 256KB FRAM1 with the index and CRCs; 3,000 routes of 89 bytes
+// would be 267KB on their own.  Every block in both directions is looked up once, which includes some with no routes.
+// Scratch files RouteIndexBench.txt and RouteIndexBench.bin are left in the current directory.
+
+#include "RouteCompiler.h"
+#include "FerroEmulator.h"
+
+#include <string>
+#include <unistd.h>
+
+const byte         PIN_FRAM1       = 53;
+const unsigned int BENCH_SIZES[2]  = { 300, 2700 };
+const byte         MAX_MATCHES     = 255;
+
+// Makes a route file of t_routes routes from t_path by keeping its other lines and repeating its routes with new numbers.
+bool makeRouteFile(const char t_path[], const unsigned int t_routes, const char t_outPath[]) {
+  FILE * in = fopen(t_path, "r");
+  FILE * out = fopen(t_outPath, "w");
+  if ((in == NULL) || (out == NULL)) return false;
+  std::vector<std::string> routes;
+  char text[ROUTE_COMPILER_MAX_LINE];
+  while (fgets(text, sizeof(text), in) != NULL) {
+    const char * p = text;
+    while ((* p == ' ') || (* p == '\t')) p++;
+    if ((* p >= '0') && (* p <= '9')) {
+      routes.push_back(strchr(p, ','));
+    } else {
+      fputs(text, out);
+    }
+  }
+  fclose(in);
+  for (unsigned int i = 0; (routes.size() > 0) && (i < t_routes); i++) {
+    fprintf(out, "%u%s", i + 1, routes[i % routes.size()].c_str());
+  }
+  fclose(out);
+  return (routes.size() > 0);
+}
+
+int main(int argc, char * argv[]) {
+  if (argc != 2) {
+    printf("Usage: RouteIndexBench <route file>\n");
+    return 1;
+  }
+  bool allMatch = true;
+  for (byte size = 0; size < 2; size++) {
+    const unsigned int routes = BENCH_SIZES[size];
+    RouteCompiler compiler;
+    if (!makeRouteFile(argv[1], routes, "RouteIndexBench.txt") || !compiler.readFile("RouteIndexBench.txt") ||
+        (compiler.check() != 0)) {
+      printf("Couldn't make a clean route file from %s.\n", argv[1]);
+      return 1;
+    }
+    unlink("RouteIndexBench.bin");
+    FerroEmulator FRAM1Chip(MB85RS2MT, PIN_FRAM1, "RouteIndexBench.bin");
+    Hackscribble_Ferro FRAM1(MB85RS2MT, PIN_FRAM1);
+    if (!FRAM1Chip.isOpen() || (FRAM1.begin() != ferroOK) || (compiler.writeImage(&FRAM1) != ferroOK)) {
+      printf("Couldn't build the image.\n");
+      return 1;
+    }
+    FramRouteIndex index(&FRAM1);
+    index.begin(routes);
+    unsigned int blocks = 0;
+    for (unsigned int i = 0; i < routes; i++) {
+      if (compiler.getRoute(i)->stepVal[0] > blocks) blocks = compiler.getRoute(i)->stepVal[0];
+    }
+    const unsigned int queries = blocks * 2;
+    printf("*** %u routes, %u lookups (blocks 1..%u, BE and BW)\n", routes, queries, blocks);
+
+    // What any sketch would do today: read() every record and look at its origin.
+    std::vector<std::vector<unsigned int> > scanFound(queries);
+    byte rec[FRAM_ROUTE_REC_LEN];
+    FRAM1Chip.resetStats();
+    for (unsigned int q = 0; q < queries; q++) {
+      for (unsigned int i = 0; i < routes; i++) {
+        FRAM1.read(FRAM_ROUTE_START + ((unsigned long)i * FRAM_ROUTE_REC_LEN), FRAM_ROUTE_REC_LEN, rec);
+        if ((rec[FRAM_ROUTE_OFS_ORIGIN + 1] == (q / 2) + 1) && (rec[FRAM_ROUTE_OFS_ORIGIN] == STEP_BE + (q % 2))) {
+          scanFound[q].push_back(rec[FRAM_ROUTE_OFS_NUMBER] | (rec[FRAM_ROUTE_OFS_NUMBER + 1] << 8));
+        }
+      }
+    }
+    FRAM1Chip.printStats("Scan, read() per record");
+    printf("%-40s %12.1f us per lookup\n", "", FRAM1Chip.getStats().microseconds / queries);
+
+    // The best a scan can do: the whole table as one stream.
+    FRAM1Chip.resetStats();
+    for (unsigned int q = 0; q < queries; q++) {
+      FRAM1.beginRead(FRAM_ROUTE_START, (unsigned long)routes * FRAM_ROUTE_REC_LEN);
+      for (unsigned int i = 0; i < routes; i++) {
+        FRAM1.streamRead(FRAM_ROUTE_REC_LEN, rec);
+      }
+      FRAM1.endStream();
+    }
+    FRAM1Chip.printStats("Scan, one stream");
+    printf("%-40s %12.1f us per lookup\n", "", FRAM1Chip.getStats().microseconds / queries);
+
+    framRouteMatch match[MAX_MATCHES];
+    unsigned int matchCount;
+    unsigned int mostMatches = 0;
+    FRAM1Chip.resetStats();
+    for (unsigned int q = 0; q < queries; q++) {
+      index.find((q / 2) + 1, STEP_BE + (q % 2), match, MAX_MATCHES, &matchCount);
+      if (matchCount > mostMatches) mostMatches = matchCount;
+    }
+    FRAM1Chip.printStats("Origin index");
+    printf("%-40s %12.1f us per lookup, up to %u routes each\n", "", FRAM1Chip.getStats().microseconds / queries,
+           mostMatches);
+
+    // Same routes, in the same order, as the scan found?
+    for (unsigned int q = 0; q < queries; q++) {
+      index.find((q / 2) + 1, STEP_BE + (q % 2), match, MAX_MATCHES, &matchCount);
+      bool same = (matchCount == scanFound[q].size());
+      for (unsigned int i = 0; same && (i < matchCount); i++) {
+        same = (match[i].number == scanFound[q][i]) && (compiler.getRoute(match[i].record)->number == match[i].number);
+      }
+      if (!same) {
+        printf("MISMATCH: block %u %s\n", (q / 2) + 1, (q % 2) ? "BW" : "BE");
+        allMatch = false;
+      }
+    }
+  }
+  printf(allMatch ? "Index and scan agree on every lookup.\n" : "Index and scan DISAGREE.\n");
+  return allMatch ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+// Rev: 10/19/26
+// FramTable is a typed view of one fixed-length table in FRAM, such as the Route Reference table in FRAM1 or the Delayed Action
+// table in FRAM2, with a small LRU cache of recently used records in RAM.
+
+// Instead of hand-computing FRAM1_ROUTE_START + ((routeNum - 1) * FRAM1_ROUTE_REC_LEN) and copying through a byte buffer, declare:
+//   FramTable<routeReference, FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, 4> routeTable(&FRAM1);
+// and then:
+//   if (routeTable.get(routeNum - 1, &routeElement) != ferroOK) ...fatal error...
+// Records are numbered 0..COUNT-1, and record i lives at BASE + (i * sizeof(T)), so sizeof(T) must equal the FRAM record length.
+// Records of any length are fine, including ones longer than the Ferro 128-byte buffer or the 255 bytes of one streamRead().
+// get() returns a cached copy if we have one, otherwise reads the record from FRAM and caches it, evicting the least recently
+// used slot.  put() only updates the cached copy and marks it dirty; repeated put()s of the same record cost nothing extra until
+// the slot is evicted or flush() is called, which writes each dirty record back exactly once.
+// IMPORTANT: Anything put() but not yet flush()ed is lost if power is lost, so call flush() whenever the data must be safe.
+// And if some other code writes this FRAM table directly, call invalidate() so we don't return stale copies.
+// This is a template, so it all lives in this header; there is no .cpp.  extras/host/FramTableTest.cpp checks it against
+// FerroEmulator.
+
+#ifndef FRAM_TABLE_H
+#define FRAM_TABLE_H
+
+#include "Arduino.h"
+#include "Hackscribble_Ferro.h"
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS = 4>
+class FramTable
+{
+  public:
+
+    FramTable(Hackscribble_Ferro * t_FRAM);  // Constructor.  Does not touch the FRAM, so it's fine to call before setup().
+
+    ferroResult get(const unsigned int t_index, T * t_record);
+    // Copies record t_index (0..COUNT-1) into *t_record.  Returns ferroBadArrayIndex if t_index is out of range, or whatever
+    // error the FRAM read (or a write-back of an evicted dirty record) returned.
+
+    ferroResult put(const unsigned int t_index, const T * t_record);
+    // Replaces record t_index (0..COUNT-1) with *t_record in the cache, to be written to FRAM later.
+
+    ferroResult flush();
+    // Writes every dirty cached record back to FRAM.
+
+    void invalidate();
+    // Forgets every cached record, without writing back dirty ones.
+
+  private:
+
+    struct cacheSlot {
+      bool valid;
+      bool dirty;
+      unsigned int index;       // Record number 0..COUNT-1 held in this slot
+      unsigned long lastUse;    // Value of m_useCount when this slot was last touched, for LRU
+      T record;
+    };
+
+    ferroResult m_transfer(const unsigned int t_index, T * t_record, const bool t_write);
+    ferroResult m_slotFor(const unsigned int t_index, byte * t_slot, bool * t_found);
+
+    Hackscribble_Ferro * m_FRAM;
+    cacheSlot m_slot[CACHE_SLOTS];
+    unsigned long m_useCount;
+
+};
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS>
+FramTable<T, BASE, COUNT, CACHE_SLOTS>::FramTable(Hackscribble_Ferro * t_FRAM) {
+  m_FRAM = t_FRAM;
+  m_useCount = 0;
+  invalidate();
+}
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS>
+ferroResult FramTable<T, BASE, COUNT, CACHE_SLOTS>::get(const unsigned int t_index, T * t_record) {
+  // Rev: 10/19/26.
+  if (t_index >= COUNT) return ferroBadArrayIndex;
+  byte slot;
+  bool found;
+  ferroResult result = m_slotFor(t_index, &slot, &found);
+  if (result != ferroOK) return result;
+  if (!found) {
+    result = m_transfer(t_index, &m_slot[slot].record, false);
+    if (result != ferroOK) return result;
+    m_slot[slot].valid = true;
+    m_slot[slot].dirty = false;
+    m_slot[slot].index = t_index;
+  }
+  m_slot[slot].lastUse = ++m_useCount;
+  memcpy(t_record, &m_slot[slot].record, sizeof(T));
+  return ferroOK;
+}
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS>
+ferroResult FramTable<T, BASE, COUNT, CACHE_SLOTS>::put(const unsigned int t_index, const T * t_record) {
+  // Rev: 10/19/26.  No need to read the old record first, since we are replacing all of it.
+  if (t_index >= COUNT) return ferroBadArrayIndex;
+  byte slot;
+  bool found;
+  ferroResult result = m_slotFor(t_index, &slot, &found);
+  if (result != ferroOK) return result;
+  memcpy(&m_slot[slot].record, t_record, sizeof(T));
+  m_slot[slot].valid = true;
+  m_slot[slot].dirty = true;
+  m_slot[slot].index = t_index;
+  m_slot[slot].lastUse = ++m_useCount;
+  return ferroOK;
+}
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS>
+ferroResult FramTable<T, BASE, COUNT, CACHE_SLOTS>::flush() {
+  // Rev: 10/19/26.
+  for (byte i = 0; i < CACHE_SLOTS; i++) {
+    if (m_slot[i].valid && m_slot[i].dirty) {
+      ferroResult result = m_transfer(m_slot[i].index, &m_slot[i].record, true);
+      if (result != ferroOK) return result;
+      m_slot[i].dirty = false;
+    }
+  }
+  return ferroOK;
+}
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS>
+void FramTable<T, BASE, COUNT, CACHE_SLOTS>::invalidate() {
+  // Rev: 10/19/26.
+  for (byte i = 0; i < CACHE_SLOTS; i++) {
+    m_slot[i].valid = false;
+    m_slot[i].dirty = false;
+  }
+  return;
+}
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS>
+ferroResult FramTable<T, BASE, COUNT, CACHE_SLOTS>::m_transfer(const unsigned int t_index, T * t_record, const bool t_write) {
+  // Rev: 10/19/26.  Read or write one whole record as one stream, so records may be longer than the Ferro 128-byte buffer.
+  // streamRead()/streamWrite() move at most 255 bytes per call, so longer records go in pieces of up to 255.
+  unsigned long address = BASE + ((unsigned long)t_index * sizeof(T));
+  byte * bytes = (byte *)t_record;
+  ferroResult result = t_write ? m_FRAM->beginWrite(address, sizeof(T)) : m_FRAM->beginRead(address, sizeof(T));
+  unsigned long done = 0;
+  while ((result == ferroOK) && (done < sizeof(T))) {
+    byte piece = ((sizeof(T) - done) > 255) ? 255 : (sizeof(T) - done);
+    result = t_write ? m_FRAM->streamWrite(piece, bytes + done) : m_FRAM->streamRead(piece, bytes + done);
+    done = done + piece;
+  }
+  m_FRAM->endStream();
+  return result;
+}
+
+template <class T, unsigned long BASE, unsigned int COUNT, byte CACHE_SLOTS>
+ferroResult FramTable<T, BASE, COUNT, CACHE_SLOTS>::m_slotFor(const unsigned int t_index, byte * t_slot, bool * t_found) {
+  // Rev: 10/19/26.  Returns the slot already holding t_index (* t_found = true), or else the slot to load it into: an empty
+  // one if there is one, otherwise the least recently used, which is written back first if dirty (* t_found = false.)
+  byte victim = 0;
+  for (byte i = 0; i < CACHE_SLOTS; i++) {
+    if (m_slot[i].valid && (m_slot[i].index == t_index)) {
+      * t_slot = i;
+      * t_found = true;
+      return ferroOK;
+    }
+    if (!m_slot[i].valid) {
+      victim = i;
+    } else if (m_slot[victim].valid && (m_slot[i].lastUse < m_slot[victim].lastUse)) {
+      victim = i;
+    }
+  }
+  * t_slot = victim;
+  * t_found = false;
+  if (m_slot[victim].valid && m_slot[victim].dirty) {
+    ferroResult result = m_transfer(m_slot[victim].index, &m_slot[victim].record, true);
+    if (result != ferroOK) return result;
+  }
+  m_slot[victim].valid = false;
+  m_slot[victim].dirty = false;
+  return ferroOK;
+}
+
+#endif
@@ -0,0 +1,198 @@
+// Rev: 10/19/26
+// FramTableTest: checks FramTable against FerroEmulator on a PC.  Every get() must return what's in FRAM (or what was put()),
+// and FRAM must only be read or written when the cache says it should: a miss reads the record once, a hit reads nothing,
+// put() writes nothing, the least recently used slot is the one evicted, a dirty slot is written back when it's evicted or
+// flush()ed and never twice, and invalidate() drops put()s.  Records longer than the Ferro 128-byte buffer and than one 255-byte
+// streamRead() are checked too.
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramTable -o FramTableTest
+//       libraries/FramTable/extras/host/FramTableTest.cpp libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp
+//       libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp
+//   ./FramTableTest [FRAM image file]
+// The image file is created if it doesn't exist, and overwritten with a test pattern.
+
+#include "FerroEmulator.h"
+#include "FramTable.h"
+
+const byte          PIN_FRAM        =   11;
+const unsigned long SMALL_START     =  128;   // 10 records of 12 bytes, like the Delayed Action table
+const unsigned int  SMALL_RECS      =   10;
+const unsigned long BIG_START       = 1024;   // 3 records of 300 bytes: more than one buffer, and more than one streamRead()
+const unsigned int  BIG_RECS        =    3;
+
+struct smallRecord { byte b[12]; };
+struct bigRecord { byte b[300]; };
+
+FerroEmulator * chip;
+unsigned long failures = 0;
+
+byte pattern(const unsigned long t_address) {
+  return (byte)((t_address * 7) + 3);
+}
+
+void check(const bool t_ok, const char t_what[]) {
+  if (!t_ok) {
+    printf("FAIL %s\n", t_what);
+    failures++;
+  }
+  return;
+}
+
+// True if t_rec holds t_len bytes of the test pattern from t_address.
+bool isPattern(const byte * t_rec, const unsigned long t_address, const unsigned int t_len) {
+  for (unsigned int i = 0; i < t_len; i++) {
+    if (t_rec[i] != pattern(t_address + i)) return false;
+  }
+  return true;
+}
+
+bool isFilled(const byte * t_rec, const byte t_value, const unsigned int t_len) {
+  for (unsigned int i = 0; i < t_len; i++) {
+    if (t_rec[i] != t_value) return false;
+  }
+  return true;
+}
+
+// Record counts moved since the last resetStats().
+unsigned long recordsRead(const unsigned int t_len) {
+  return chip->getStats().bytesRead / t_len;
+}
+
+unsigned long recordsWritten(const unsigned int t_len) {
+  return chip->getStats().bytesWritten / t_len;
+}
+
+void fillPattern() {
+  for (unsigned long a = 0; a < chip->size(); a++) chip->memory()[a] = pattern(a);
+  return;
+}
+
+int main(int argc, char * argv[]) {
+  FerroEmulator FRAMChip(MB85RS64, PIN_FRAM, (argc > 1) ? argv[1] : "FramTableTest.bin");
+  if (!FRAMChip.isOpen()) {
+    printf("Couldn't open the FRAM image file.\n");
+    return 1;
+  }
+  chip = &FRAMChip;
+  Hackscribble_Ferro FRAM(MB85RS64, PIN_FRAM);
+  if (FRAM.begin() != ferroOK) {
+    printf("FRAM begin() failed.\n");
+    return 1;
+  }
+  fillPattern();
+  const unsigned int S = sizeof(smallRecord);
+  smallRecord rec;
+  smallRecord newRec;
+
+  // *** get(): a miss reads the record once, a hit reads nothing, and out-of-range records are refused.
+  {
+    FramTable<smallRecord, SMALL_START, SMALL_RECS, 4> table(&FRAM);
+    chip->resetStats();
+    check(table.get(3, &rec) == ferroOK, "get() of record 3");
+    check(isPattern(rec.b, SMALL_START + (3 * S), S), "get() returns the record from FRAM");
+    check(recordsRead(S) == 1, "a miss reads the record once");
+    chip->resetStats();
+    check(table.get(3, &rec) == ferroOK, "get() of a cached record");
+    check(isPattern(rec.b, SMALL_START + (3 * S), S), "a hit returns the same record");
+    check(chip->getStats().transactions == 0, "a hit doesn't touch the FRAM");
+    check(table.get(SMALL_RECS, &rec) == ferroBadArrayIndex, "get() past the end is ferroBadArrayIndex");
+    check(table.put(SMALL_RECS, &rec) == ferroBadArrayIndex, "put() past the end is ferroBadArrayIndex");
+    check(chip->getStats().transactions == 0, "out-of-range records don't touch the FRAM");
+  }
+
+  // *** LRU eviction: fill the 4 slots with records 0..3, touch 0, then 4 must evict 1 (the least recently used.)
+  {
+    FramTable<smallRecord, SMALL_START, SMALL_RECS, 4> table(&FRAM);
+    for (unsigned int i = 0; i < 4; i++) table.get(i, &rec);
+    table.get(0, &rec);
+    chip->resetStats();
+    table.get(4, &rec);
+    check(isPattern(rec.b, SMALL_START + (4 * S), S), "get() of a fifth record");
+    check(recordsRead(S) == 1, "a fifth record is read once");
+    chip->resetStats();
+    table.get(0, &rec);
+    table.get(2, &rec);
+    table.get(3, &rec);
+    table.get(4, &rec);
+    check(chip->getStats().transactions == 0, "the recently used records are still cached");
+    table.get(1, &rec);
+    check(recordsRead(S) == 1, "the least recently used record was the one evicted");
+    check(isPattern(rec.b, SMALL_START + (1 * S), S), "an evicted record is read again correctly");
+  }
+
+  // *** put(), dirty write-back on eviction, and flush().
+  {
+    FramTable<smallRecord, SMALL_START, SMALL_RECS, 2> table(&FRAM);
+    memset(newRec.b, 0xA5, S);
+    chip->resetStats();
+    check(table.put(5, &newRec) == ferroOK, "put() of record 5");
+    check(chip->getStats().transactions == 0, "put() doesn't touch the FRAM");
+    check(table.get(5, &rec) == ferroOK, "get() of a put() record");
+    check(isFilled(rec.b, 0xA5, S), "get() returns what was put()");
+    check(isPattern(chip->memory() + SMALL_START + (5 * S), SMALL_START + (5 * S), S), "FRAM is unchanged until write-back");
+    memset(newRec.b, 0x5A, S);
+    table.put(5, &newRec);   // A second put() of a dirty record is still just one write later
+    table.get(6, &rec);      // Fills the second slot; 5 is now the least recently used
+    chip->resetStats();
+    table.get(7, &rec);      // Evicts 5, which must be written back first
+    check(recordsWritten(S) == 1, "evicting a dirty record writes it back once");
+    check(isFilled(chip->memory() + SMALL_START + (5 * S), 0x5A, S), "the last put() is what's written back");
+    check(isPattern(chip->memory() + SMALL_START + (4 * S), SMALL_START + (4 * S), S), "the record before is untouched");
+    check(isPattern(chip->memory() + SMALL_START + (6 * S), SMALL_START + (6 * S), S), "the record after is untouched");
+    chip->resetStats();
+    table.get(5, &rec);
+    check((recordsRead(S) == 1) && isFilled(rec.b, 0x5A, S), "a written-back record reads back from FRAM");
+
+    fillPattern();
+    table.invalidate();
+    memset(newRec.b, 0x11, S);
+    table.put(8, &newRec);
+    memset(newRec.b, 0x22, S);
+    table.put(9, &newRec);
+    chip->resetStats();
+    check(table.flush() == ferroOK, "flush()");
+    check(recordsWritten(S) == 2, "flush() writes each dirty record once");
+    check(isFilled(chip->memory() + SMALL_START + (8 * S), 0x11, S) &&
+          isFilled(chip->memory() + SMALL_START + (9 * S), 0x22, S), "flush() writes the put() records");
+    chip->resetStats();
+    check(table.flush() == ferroOK, "a second flush()");
+    check(chip->getStats().transactions == 0, "a second flush() writes nothing");
+    table.get(8, &rec);
+    table.get(9, &rec);
+    check(chip->getStats().transactions == 0, "flushed records are still cached");
+
+    table.put(8, &newRec);   // 0x22 now, but never flushed
+    table.invalidate();
+    chip->resetStats();
+    table.get(8, &rec);
+    check(chip->getStats().bytesWritten == 0, "invalidate() doesn't write back");
+    check(isFilled(rec.b, 0x11, S), "after invalidate(), get() reads FRAM again");
+  }
+
+  // *** Records longer than the Ferro buffer and than one streamRead().
+  {
+    fillPattern();
+    const unsigned int B = sizeof(bigRecord);
+    FramTable<bigRecord, BIG_START, BIG_RECS, 1> table(&FRAM);
+    bigRecord big;
+    chip->resetStats();
+    check(table.get(2, &big) == ferroOK, "get() of a 300-byte record");
+    check(isPattern(big.b, BIG_START + (2 * B), B), "a 300-byte record reads correctly");
+    check(recordsRead(B) == 1, "a 300-byte record is read once");
+    check(chip->getStats().transactions == 1, "a 300-byte record is read in one SPI transaction");
+    for (unsigned int i = 0; i < B; i++) big.b[i] = (byte)(255 - i);
+    table.put(1, &big);
+    check(table.flush() == ferroOK, "flush() of a 300-byte record");
+    bool same = true;
+    for (unsigned int i = 0; i < B; i++) same = same && (chip->memory()[BIG_START + B + i] == (byte)(255 - i));
+    check(same, "a 300-byte record is written correctly");
+    check(isPattern(chip->memory() + BIG_START + (2 * B), BIG_START + (2 * B), B), "the next 300-byte record is untouched");
+  }
+
+  if (failures == 0) {
+    printf("FramTable passed every check.\n");
+  } else {
+    printf("%lu FAILURES.\n", failures);
+  }
+  return (failures == 0) ? 0 : 1;
+}
@@ -1,4 +1,6 @@
-/*    MODIFIED 07/30/2019 by Randy: Eliminate FerroArray code to eliminate compiler warnings.
+/*    MODIFIED 10/19/2026 by Randy: Added streaming reads and writes (see Hackscribble_Ferro.h.)
+
+      MODIFIED 07/30/2019 by Randy: Eliminate FerroArray code to eliminate compiler warnings.
 
 	Hackscribble_Ferro Library
 	==========================
@@ -66,6 +68,8 @@ Hackscribble_Ferro::Hackscribble_Ferro(ferroPartNumber partNumber, byte chipSele
 	_addressLength = _addressLengthForPartNumber[_partNumber];
 	_numberOfBuffers = (_topAddress - _bottomAddress + 1) / _maxBufferSize;
 	_nextFreeByte = _bottomAddress;
+	_streamMode = _streamNone;
+	_streamRemaining = 0;
 }
 
 
@@ -311,6 +315,10 @@ ferroResult Hackscribble_Ferro::read(unsigned long startAddress, byte numberOfBy
 	//		0 < numberOfBytes <= maxBuffer
 	//		startAddress + numberOfBytes <= _topAddress
 		
+	if (_streamMode != _streamNone)
+	{
+		return ferroStreamAlreadyOpen;
+	}
 	if ((startAddress < _bottomAddress) || (startAddress > _topAddress))
 	{
 		return ferroBadStartAddress;
@@ -340,6 +348,10 @@ ferroResult Hackscribble_Ferro::write(unsigned long startAddress, byte numberOfB
 	//		0 < numberOfBytes <= maxBuffer
 	//		startAddress + numberOfBytes - 1 <= _topAddress
 		
+	if (_streamMode != _streamNone)
+	{
+		return ferroStreamAlreadyOpen;
+	}
 	if ((startAddress < _bottomAddress) || (startAddress > _topAddress))
 	{
 		return ferroBadStartAddress;
@@ -359,6 +371,132 @@ ferroResult Hackscribble_Ferro::write(unsigned long startAddress, byte numberOfB
 }
 
 
+//
+// STREAMING METHODS (Randy 10/19/2026)
+//
+
+ferroResult Hackscribble_Ferro::_checkStreamRange(unsigned long startAddress, unsigned long numberOfBytes)
+{
+	// Same validations as read() and write(), except that numberOfBytes is not limited to _maxBufferSize
+	if (_streamMode != _streamNone)
+	{
+		return ferroStreamAlreadyOpen;
+	}
+	if ((startAddress < _bottomAddress) || (startAddress > _topAddress))
+	{
+		return ferroBadStartAddress;
+	}
+	if (numberOfBytes == 0)
+	{
+		return ferroBadNumberOfBytes;
+	}
+	if ((startAddress + numberOfBytes - 1) > _topAddress)
+	{
+		return ferroBadFinishAddress;
+	}
+	return ferroOK;
+}
+
+
+void Hackscribble_Ferro::_sendOpcodeAndAddress(byte opcode, unsigned long address)
+{
+	SPI.transfer(opcode);
+	if (_addressLength == ADDRESS24BIT)
+	{
+		SPI.transfer(address / 65536);
+	}
+	SPI.transfer(address / 256);
+	SPI.transfer(address % 256);
+}
+
+
+ferroResult Hackscribble_Ferro::beginRead(unsigned long startAddress, unsigned long numberOfBytes)
+{
+	// Opens a read stream of numberOfBytes bytes starting at startAddress; chip stays selected until endStream()
+	ferroResult result = _checkStreamRange(startAddress, numberOfBytes);
+	if (result != ferroOK)
+	{
+		return result;
+	}
+	_select();
+	_sendOpcodeAndAddress(_READ, startAddress);
+	_streamMode = _streamReading;
+	_streamRemaining = numberOfBytes;
+	return ferroOK;
+}
+
+
+ferroResult Hackscribble_Ferro::beginWrite(unsigned long startAddress, unsigned long numberOfBytes)
+{
+	// Opens a write stream of numberOfBytes bytes starting at startAddress; chip stays selected until endStream()
+	ferroResult result = _checkStreamRange(startAddress, numberOfBytes);
+	if (result != ferroOK)
+	{
+		return result;
+	}
+	_select();
+	SPI.transfer(_WREN);
+	_deselect();
+	_select();
+	_sendOpcodeAndAddress(_WRITE, startAddress);
+	_streamMode = _streamWriting;
+	_streamRemaining = numberOfBytes;
+	return ferroOK;
+}
+
+
+ferroResult Hackscribble_Ferro::streamRead(byte numberOfBytes, byte *buffer)
+{
+	// Copies the next numberOfBytes bytes of an open read stream into buffer
+	if (_streamMode != _streamReading)
+	{
+		return ferroStreamNotOpen;
+	}
+	if (numberOfBytes > _streamRemaining)
+	{
+		return ferroStreamOverrun;
+	}
+	for (byte i = 0; i < numberOfBytes; i++)
+	{
+		buffer[i] = SPI.transfer(_dummy);
+	}
+	_streamRemaining -= numberOfBytes;
+	return ferroOK;
+}
+
+
+ferroResult Hackscribble_Ferro::streamWrite(byte numberOfBytes, byte *buffer)
+{
+	// Sends the next numberOfBytes bytes of buffer to an open write stream
+	if (_streamMode != _streamWriting)
+	{
+		return ferroStreamNotOpen;
+	}
+	if (numberOfBytes > _streamRemaining)
+	{
+		return ferroStreamOverrun;
+	}
+	for (byte i = 0; i < numberOfBytes; i++)
+	{
+		SPI.transfer(buffer[i]);
+	}
+	_streamRemaining -= numberOfBytes;
+	return ferroOK;
+}
+
+
+void Hackscribble_Ferro::endStream()
+{
+	// Closes any open stream.  A write stream is committed as soon as CS goes high; FRAM has no write delay.
+	if (_streamMode != _streamNone)
+	{
+		_deselect();
+		_streamMode = _streamNone;
+		_streamRemaining = 0;
+	}
+}
+
+
 unsigned long Hackscribble_Ferro::allocateMemory(unsigned long numberOfBytes, ferroResult& result)
 {
 	if ((_nextFreeByte + numberOfBytes) < _topAddress)
@@ -1,4 +1,7 @@
-/*   MODIFIED 07/20/2019 by Randy: Increased value of _maxBufferSize from 0x40 to 0x80 (64 bytes to 128 bytes).
+/*   MODIFIED 10/19/2026 by Randy: Added streaming beginRead()/beginWrite()/streamRead()/streamWrite()/endStream(), so a
+whole table can be read or written in one SPI transaction instead of one opcode+address per record.
+
+     MODIFIED 07/20/2019 by Randy: Increased value of _maxBufferSize from 0x40 to 0x80 (64 bytes to 128 bytes).
 Also commented out all FerroArray code to eliminate compiler warnings.
 
 	Hackscribble_Ferro Library
@@ -71,6 +74,9 @@ enum ferroResult
 	ferroBadArrayStartAddress,
 	ferroBadResponse,
 	ferroPartNumberMismatch,
+	ferroStreamNotOpen,
+	ferroStreamAlreadyOpen,
+	ferroStreamOverrun,
 	ferroUnknownError = 99
 };
 
@@ -115,6 +121,15 @@ private:
 	// FRAM current next byte to allocate
 	unsigned long _nextFreeByte;
 
+	// Streaming: which kind of stream (if any) is open, and how many bytes it may still transfer
+	static const byte _streamNone = 0;
+	static const byte _streamReading = 1;
+	static const byte _streamWriting = 2;
+	byte _streamMode;
+	unsigned long _streamRemaining;
+	ferroResult _checkStreamRange(unsigned long startAddress, unsigned long numberOfBytes);
+	void _sendOpcodeAndAddress(byte opcode, unsigned long address);
+
 	uint8_t _readStatusRegister(void);
 	void _writeStatusRegister(uint8_t value);
 	void _readMemory(unsigned long address, uint8_t numberOfBytes, uint8_t *buffer);
@@ -146,6 +161,17 @@ public:
 	unsigned long allocateMemory(unsigned long numberOfBytes, ferroResult& result);
 	ferroResult format();
 
+	// Streaming transfers (Randy 10/19/2026).  beginRead()/beginWrite() select the chip and send the opcode and address once;
+	// streamRead()/streamWrite() then move any number of bytes, in pieces of up to 255, until numberOfBytes have been moved;
+	// endStream() deselects the chip.  The FRAM advances its own address, so a whole table is one continuous SPI burst.
+	// Only one stream may be open at a time, and nothing else may use the SPI bus (including read()/write() on this or any
+	// other FRAM) until endStream().  endStream() is harmless if no stream is open.
+	ferroResult beginRead(unsigned long startAddress, unsigned long numberOfBytes);
+	ferroResult beginWrite(unsigned long startAddress, unsigned long numberOfBytes);
+	ferroResult streamRead(byte numberOfBytes, byte *buffer);
+	ferroResult streamWrite(byte numberOfBytes, byte *buffer);
+	void endStream();
+
 };
 
 /* Commenting out the FerroArray class...
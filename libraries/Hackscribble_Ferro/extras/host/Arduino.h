@@ -0,0 +1,72 @@
+// Rev: 10/19/26
+// Host (Linux) stand-in for the parts of Arduino.h that Hackscribble_Ferro, FramTable, FramLayout and FramIngest use, so they
+// can be built with g++ against FerroEmulator instead of a real FRAM.  See FerroEmulator.h.  TrainStopping's and
+// SensorFilter's host tests use it too, without the emulator.  Never used by the Arduino IDE, which ignores everything under a
+// library's extras folder.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT  0x0
+#define OUTPUT 0x1
+#define MSBFIRST 1
+#define LSBFIRST 0
+#define NOT_A_PIN 0
+#define NOT_ON_TIMER 0
+
+const uint8_t SS = 53;  // Mega hardware SS pin
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_dword(p) (*(p))
+
+// Time is FerroEmulator's modelled time, not wall-clock time, so sketch code that times itself with micros() reports what the
+// same code would take on the Mega.
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long t_ms);
+void delayMicroseconds(unsigned int t_us);
+
+void pinMode(uint8_t t_pin, uint8_t t_mode);
+void digitalWrite(uint8_t t_pin, uint8_t t_val);
+uint8_t digitalPinToTimer(uint8_t t_pin);
+uint8_t digitalPinToPort(uint8_t t_pin);
+uint8_t digitalPinToBitMask(uint8_t t_pin);
+volatile uint8_t * portOutputRegister(uint8_t t_port);
+
+// Hackscribble_Ferro drives chip select by writing the port register directly, inside cli() ... SREG = oldSREG.  Every chip
+// select change therefore ends with an assignment to SREG, which is where FerroEmulator notices it.
+struct HostSREG {
+  uint8_t value;
+  operator uint8_t() const { return value; }
+  HostSREG & operator=(uint8_t t_value);
+};
+extern HostSREG SREG;
+void cli();
+void sei();
+
+// Just the part of Arduino's Stream (and Print) that FramIngest uses; see FramIngest's extras/host/HostSerial.h for one.
+class Stream
+{
+  public:
+    virtual ~Stream() {}
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual size_t write(uint8_t t_data) = 0;
+    virtual size_t write(const uint8_t * t_buffer, size_t t_size) {
+      for (size_t i = 0; i < t_size; i++) write(t_buffer[i]);
+      return t_size;
+    }
+};
+
+#endif
@@ -0,0 +1,117 @@
+// Rev: 10/19/26
+// FerroBench: what our FRAM access patterns would cost on the Mega, measured against FerroEmulator on a PC.
+// Build and run from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro -I libraries/FramTable
+//       -I libraries/FramLayout -o FerroBench libraries/Hackscribble_Ferro/extras/host/FerroBench.cpp
+//       libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp
+//       libraries/FramLayout/FramLayout.cpp
+//   ./FerroBench [FRAM1 image file] [FRAM2 image file]
+// The Route table and Delayed Action scans are the before/after benchmark for the streaming reads added on 10/19/26: read() per
+// record versus one stream, each line with its modelled payload bytes/s.
+// Table sizes are the single-level ones from A-LED and A-LEG.  Contents don't matter for timing, so any image will do; the
+// files are created (all zeroes) if they don't exist.
+
+#include "FerroEmulator.h"
+#include "FramTable.h"
+#include "FramLayout.h"
+
+const byte          PIN_FRAM1            =  11;
+const byte          PIN_FRAM2            =  12;
+const unsigned int  FRAM1_ROUTE_START    = 128;
+const byte          FRAM1_ROUTE_REC_LEN  =  77;
+const byte          FRAM1_ROUTE_RECS     =  32;
+const unsigned int  FRAM1_PARK1_START    = FRAM1_ROUTE_START + (FRAM1_ROUTE_REC_LEN * FRAM1_ROUTE_RECS);
+const byte          FRAM1_PARK1_REC_LEN  = 127;
+const byte          FRAM1_PARK1_RECS     =  19;
+const unsigned int  FRAM1_PARK2_START    = FRAM1_PARK1_START + (FRAM1_PARK1_REC_LEN * FRAM1_PARK1_RECS);
+const byte          FRAM1_PARK2_REC_LEN  =  52;
+const byte          FRAM1_PARK2_RECS     =   4;
+const unsigned int  FRAM2_ACTION_START   = 128;
+const byte          FRAM2_ACTION_LEN     =  12;
+const unsigned int  FRAM2_ACTION_RECS    = 400;   // What A-LEG expects to need eventually
+const byte          ROUTE_COMMANDS       = 200;   // Route commands in a typical operating session, for the cache test
+
+struct routeRecord { byte b[FRAM1_ROUTE_REC_LEN]; };
+
+int main(int argc, char * argv[]) {
+  FerroEmulator FRAM1Chip(MB85RS64, PIN_FRAM1, (argc > 1) ? argv[1] : "FRAM1.bin");
+  FerroEmulator FRAM2Chip(MB85RS64, PIN_FRAM2, (argc > 2) ? argv[2] : "FRAM2.bin");
+  if (!FRAM1Chip.isOpen() || !FRAM2Chip.isOpen()) {
+    printf("Couldn't open the FRAM image files.\n");
+    return 1;
+  }
+  Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);
+  Hackscribble_Ferro FRAM2(MB85RS64, PIN_FRAM2);
+  if ((FRAM1.begin() != ferroOK) || (FRAM2.begin() != ferroOK)) {
+    printf("FRAM begin() failed.\n");
+    return 1;
+  }
+  byte b[128];
+
+  // *** Route Reference table: one read() per record, as A-SWT did before 10/19/26, versus one stream.
+  FRAM1Chip.resetStats();
+  for (byte i = 0; i < FRAM1_ROUTE_RECS; i++) {
+    FRAM1.read(FRAM1_ROUTE_START + (i * FRAM1_ROUTE_REC_LEN), FRAM1_ROUTE_REC_LEN, b);
+  }
+  FRAM1Chip.printStats("Route table, read() per record");
+  FRAM1Chip.resetStats();
+  FRAM1.beginRead(FRAM1_ROUTE_START, (unsigned long)FRAM1_ROUTE_REC_LEN * FRAM1_ROUTE_RECS);
+  for (byte i = 0; i < FRAM1_ROUTE_RECS; i++) {
+    FRAM1.streamRead(FRAM1_ROUTE_REC_LEN, b);
+  }
+  FRAM1.endStream();
+  FRAM1Chip.printStats("Route table, one stream");
+
+  // *** Route commands as A-LED sees them: the same three routes over and over.  Uncached read() versus FramTable.
+  FRAM1Chip.resetStats();
+  for (byte i = 0; i < ROUTE_COMMANDS; i++) {
+    FRAM1.read(FRAM1_ROUTE_START + ((i % 3) * FRAM1_ROUTE_REC_LEN), FRAM1_ROUTE_REC_LEN, b);
+  }
+  FRAM1Chip.printStats("Route commands, read() each time");
+  FRAM1Chip.resetStats();
+  FramTable<routeRecord, FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, 4> routeTable(&FRAM1);
+  routeRecord route;
+  for (byte i = 0; i < ROUTE_COMMANDS; i++) {
+    routeTable.get(i % 3, &route);
+  }
+  FRAM1Chip.printStats("Route commands, FramTable (4 slots)");
+
+  // *** Last-known turnout positions: write the control block after every turnout, versus once per route.
+  FRAM1.readControlBlock(b);
+  FRAM1Chip.resetStats();
+  for (byte i = 0; i < 11; i++) {
+    FRAM1.writeControlBlock(b);
+  }
+  FRAM1Chip.printStats("Last-known, 11 turnouts, each written");
+  FRAM1Chip.resetStats();
+  FRAM1.writeControlBlock(b);
+  FRAM1Chip.printStats("Last-known, 11 turnouts, written once");
+
+  // *** Delayed Action table scan on FRAM2, as A-LEG does every time a sensor trips.
+  FRAM2Chip.resetStats();
+  for (unsigned int i = 0; i < FRAM2_ACTION_RECS; i++) {
+    FRAM2.read(FRAM2_ACTION_START + (i * FRAM2_ACTION_LEN), FRAM2_ACTION_LEN, b);
+  }
+  FRAM2Chip.printStats("Delayed Action scan, read() per record");
+  FRAM2Chip.resetStats();
+  FRAM2.beginRead(FRAM2_ACTION_START, (unsigned long)FRAM2_ACTION_LEN * FRAM2_ACTION_RECS);
+  for (unsigned int i = 0; i < FRAM2_ACTION_RECS; i++) {
+    FRAM2.streamRead(FRAM2_ACTION_LEN, b);
+  }
+  FRAM2.endStream();
+  FRAM2Chip.printStats("Delayed Action scan, one stream");
+
+  // *** Startup integrity check of FRAM1.  Bad record counts are meaningless unless the image was stamped by Populate.
+  FramLayout FRAM1Layout(&FRAM1);
+  FRAM1Layout.addTable(FRAM1_ROUTE_START, FRAM1_ROUTE_RECS, FRAM1_ROUTE_REC_LEN);
+  FRAM1Layout.addTable(FRAM1_PARK1_START, FRAM1_PARK1_RECS, FRAM1_PARK1_REC_LEN);
+  FRAM1Layout.addTable(FRAM1_PARK2_START, FRAM1_PARK2_RECS, FRAM1_PARK2_REC_LEN);
+  framBadRecord badRec[1];
+  unsigned int badRecs = 0;
+  FRAM1Chip.resetStats();
+  FRAM1Layout.scan(badRec, 1, &badRecs);
+  FRAM1Chip.printStats("FramLayout CRC scan of FRAM1");
+
+  printf("Total modelled time %.1f ms\n", FerroEmulator::elapsedMicros() / 1000.0);
+  return 0;
+}
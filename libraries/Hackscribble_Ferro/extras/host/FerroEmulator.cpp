@@ -0,0 +1,312 @@
+// Rev: 10/19/26
+// FerroEmulator: an MB85RS FRAM chip, plus just enough of the Arduino core and SPI library, for running Hackscribble_Ferro on a
+// Linux PC.  See FerroEmulator.h.
+
+#include "FerroEmulator.h"
+#include "SPI.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const unsigned long HOST_F_CPU            = 16000000;  // Mega clock; the SPI clock is this divided by setClockDivider()
+const byte          HOST_PORTS            = 72;        // One fake port per Mega pin (0..69), numbered pin + 1
+
+// MB85RS opcodes, same as Hackscribble_Ferro's
+const byte FERRO_WREN                     = 0x06;
+const byte FERRO_WRDI                     = 0x04;
+const byte FERRO_WRITE                    = 0x02;
+const byte FERRO_READ                     = 0x03;
+const byte FERRO_RDSR                     = 0x05;
+const byte FERRO_WRSR                     = 0x01;
+const byte FERRO_RDID                     = 0x9F;
+
+// What the next byte clocked in to a selected chip means
+const byte STATE_OPCODE                   = 0;
+const byte STATE_ADDRESS                  = 1;
+const byte STATE_READ                     = 2;
+const byte STATE_WRITE                    = 3;
+const byte STATE_RDSR                     = 4;
+const byte STATE_WRSR                     = 5;
+const byte STATE_RDID                     = 6;
+const byte STATE_IGNORE                   = 7;  // Anything after a one-byte command, or a WRITE without WREN
+
+// Top address and address length of each part, indexed by ferroPartNumber, as in Hackscribble_Ferro's constructor.
+const unsigned long PART_TOP_ADDRESS[numberOfPartNumbers] = {
+  0x0007FFUL, 0x001FFFUL, 0x003FFFUL, 0x003FFFUL, 0x007FFFUL, 0x007FFFUL, 0x01FFFFUL, 0x03FFFFUL
+};
+const byte PART_ADDRESS_BYTES[numberOfPartNumbers] = { 2, 2, 2, 2, 2, 2, 3, 3 };
+// Third byte of the RDID response; Hackscribble_Ferro checks bits 4..0 against its density code.  0 = RDID not supported.
+const byte PART_RDID_DENSITY[numberOfPartNumbers] = { 0x00, 0x00, 0x00, 0x24, 0x00, 0x25, 0x27, 0x48 };
+const byte FUJITSU_RDID[4] = { 0x04, 0x7F, 0x00, 0x03 };  // Byte 2 is replaced by PART_RDID_DENSITY
+
+// Shared by every chip: the SPI bus, the modelled clock, and the fake port registers chip select is driven through.
+static FerroEmulator * g_chip[FERRO_EMULATOR_MAX_CHIPS];
+static byte g_chipCount = 0;
+static double g_spiClockHz = HOST_F_CPU / 4.0;     // AVR SPI library default is SPI_CLOCK_DIV4
+static double g_transactionMicros = 1.5;           // cli(), port write, SREG restore, and the call, for select plus deselect
+static double g_byteOverheadMicros = 0.6;          // SPI.transfer() call, SPIF polling and the caller's loop, per byte
+static double g_elapsedMicros = 0.0;
+static volatile uint8_t g_port[HOST_PORTS + 1];
+static bool g_portsInitialized = false;
+
+HostSREG SREG;
+SPIClass SPI;
+
+FerroEmulator::FerroEmulator(const ferroPartNumber t_partNumber, const byte t_chipSelect, const char t_path[]) {
+  // Rev: 10/19/26.
+  m_partNumber = t_partNumber;
+  m_chipSelect = t_chipSelect;
+  m_size = PART_TOP_ADDRESS[t_partNumber] + 1;
+  m_addressBytes = PART_ADDRESS_BYTES[t_partNumber];
+  m_memory = NULL;
+  m_selected = false;
+  m_state = STATE_IGNORE;
+  m_opcode = 0;
+  m_address = 0;
+  m_addressBytesLeft = 0;
+  m_idIndex = 0;
+  m_writeEnabled = false;
+  m_status = 0;
+  resetStats();
+  if (!g_portsInitialized) {   // All chip selects start HIGH, i.e. nothing selected
+    for (byte i = 0; i <= HOST_PORTS; i++) g_port[i] = 0xFF;
+    g_portsInitialized = true;
+  }
+  m_fd = open(t_path, O_RDWR | O_CREAT, 0644);
+  if (m_fd < 0) return;
+  struct stat fileInfo;
+  if ((fstat(m_fd, &fileInfo) != 0) ||
+      (((unsigned long)fileInfo.st_size < m_size) && (ftruncate(m_fd, m_size) != 0))) {
+    close(m_fd);
+    m_fd = -1;
+    return;
+  }
+  void * mapped = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (mapped == MAP_FAILED) {
+    close(m_fd);
+    m_fd = -1;
+    return;
+  }
+  m_memory = (byte *)mapped;
+  if (g_chipCount < FERRO_EMULATOR_MAX_CHIPS) {
+    g_chip[g_chipCount++] = this;
+  } else {
+    munmap(m_memory, m_size);
+    m_memory = NULL;
+  }
+}
+
+FerroEmulator::~FerroEmulator() {
+  // Rev: 10/19/26.
+  for (byte i = 0; i < g_chipCount; i++) {
+    if (g_chip[i] == this) {
+      g_chip[i] = g_chip[--g_chipCount];
+      break;
+    }
+  }
+  if (m_memory != NULL) {
+    msync(m_memory, m_size, MS_SYNC);
+    munmap(m_memory, m_size);
+  }
+  if (m_fd >= 0) close(m_fd);
+}
+
+bool FerroEmulator::isOpen() {
+  return (m_memory != NULL);
+}
+
+byte * FerroEmulator::memory() {
+  return m_memory;
+}
+
+unsigned long FerroEmulator::size() {
+  return m_size;
+}
+
+ferroEmulatorStats FerroEmulator::getStats() {
+  return m_stats;
+}
+
+void FerroEmulator::resetStats() {
+  memset(&m_stats, 0, sizeof(m_stats));
+  return;
+}
+
+void FerroEmulator::printStats(const char t_label[]) {
+  // Rev: 10/19/26.
+  const double bytesPerSecond = (m_stats.microseconds > 0.0) ?
+                                ((m_stats.bytesRead + m_stats.bytesWritten) * 1000000.0 / m_stats.microseconds) : 0.0;
+  printf("%-40s %7lu trans %9lu SPI bytes %9lu read %9lu written %12.1f us %10.0f bytes/s\n", t_label, m_stats.transactions,
+         m_stats.spiBytes, m_stats.bytesRead, m_stats.bytesWritten, m_stats.microseconds, bytesPerSecond);
+  return;
+}
+
+void FerroEmulator::setSPICosts(const double t_transactionMicros, const double t_byteOverheadMicros) {
+  g_transactionMicros = t_transactionMicros;
+  g_byteOverheadMicros = t_byteOverheadMicros;
+  return;
+}
+
+double FerroEmulator::elapsedMicros() {
+  return g_elapsedMicros;
+}
+
+void FerroEmulator::advanceMicros(const double t_micros) {
+  g_elapsedMicros = g_elapsedMicros + t_micros;
+  return;
+}
+
+void FerroEmulator::pinsChanged() {
+  // Rev: 10/19/26.  See whether any chip's select line has moved since we last looked.
+  for (byte i = 0; i < g_chipCount; i++) {
+    bool selectLow = ((g_port[g_chip[i]->m_chipSelect + 1] & 0x01) == 0);
+    if (selectLow && !g_chip[i]->m_selected) g_chip[i]->m_select();
+    if (!selectLow && g_chip[i]->m_selected) g_chip[i]->m_deselect();
+  }
+  return;
+}
+
+byte FerroEmulator::spiTransfer(const byte t_data) {
+  // Rev: 10/19/26.  Every byte costs bus time whether or not anyone is listening.  With nothing selected, MISO floats high.
+  double byteMicros = (8.0 * 1000000.0 / g_spiClockHz) + g_byteOverheadMicros;
+  g_elapsedMicros = g_elapsedMicros + byteMicros;
+  for (byte i = 0; i < g_chipCount; i++) {
+    if (g_chip[i]->m_selected) {
+      g_chip[i]->m_stats.spiBytes++;
+      g_chip[i]->m_stats.microseconds = g_chip[i]->m_stats.microseconds + byteMicros;
+      return g_chip[i]->m_transfer(t_data);
+    }
+  }
+  return 0xFF;
+}
+
+void FerroEmulator::spiSetClockDivider(const byte t_divider) {
+  // Rev: 10/19/26.  Same encoding as the AVR SPI library: bit 2 is SPI2X (double speed), bits 1..0 select /4, /16, /64, /128.
+  const unsigned int DIVIDERS[4] = { 4, 16, 64, 128 };
+  double divider = DIVIDERS[t_divider & 0x03];
+  if (t_divider & 0x04) divider = divider / 2;
+  g_spiClockHz = HOST_F_CPU / divider;
+  return;
+}
+
+void FerroEmulator::m_select() {
+  // Rev: 10/19/26.
+  m_selected = true;
+  m_state = STATE_OPCODE;
+  m_stats.transactions++;
+  m_stats.microseconds = m_stats.microseconds + g_transactionMicros;
+  g_elapsedMicros = g_elapsedMicros + g_transactionMicros;
+  return;
+}
+
+void FerroEmulator::m_deselect() {
+  // Rev: 10/19/26.  Like the real part, WEL is cleared at the end of any WRITE or WRSR, even an empty one.
+  m_selected = false;
+  if ((m_opcode == FERRO_WRITE) || (m_opcode == FERRO_WRSR)) m_writeEnabled = false;
+  m_opcode = 0;
+  return;
+}
+
+byte FerroEmulator::m_transfer(const byte t_data) {
+  // Rev: 10/19/26.
+  byte reply = 0x00;
+  switch (m_state) {
+    case STATE_OPCODE:
+      m_opcode = t_data;
+      m_state = STATE_IGNORE;
+      if (t_data == FERRO_WREN) {
+        m_writeEnabled = true;
+      } else if (t_data == FERRO_WRDI) {
+        m_writeEnabled = false;
+      } else if ((t_data == FERRO_READ) || (t_data == FERRO_WRITE)) {
+        m_address = 0;
+        m_addressBytesLeft = m_addressBytes;
+        m_state = STATE_ADDRESS;
+      } else if (t_data == FERRO_RDSR) {
+        m_state = STATE_RDSR;
+      } else if (t_data == FERRO_WRSR) {
+        if (m_writeEnabled) m_state = STATE_WRSR;
+      } else if ((t_data == FERRO_RDID) && (PART_RDID_DENSITY[m_partNumber] != 0x00)) {
+        m_idIndex = 0;
+        m_state = STATE_RDID;
+      }
+      break;
+    case STATE_ADDRESS:
+      m_address = (m_address << 8) | t_data;
+      if (--m_addressBytesLeft == 0) {
+        m_address = m_address % m_size;
+        if (m_opcode == FERRO_READ) {
+          m_state = STATE_READ;
+        } else if (m_writeEnabled) {
+          m_state = STATE_WRITE;
+        } else {
+          m_state = STATE_IGNORE;   // Real part ignores a WRITE that wasn't preceded by WREN
+        }
+      }
+      break;
+    case STATE_READ:              // The address wraps from the top of memory to 0, as on the real part
+      reply = m_memory[m_address];
+      m_address = (m_address + 1) % m_size;
+      m_stats.bytesRead++;
+      break;
+    case STATE_WRITE:
+      m_memory[m_address] = t_data;
+      m_address = (m_address + 1) % m_size;
+      m_stats.bytesWritten++;
+      break;
+    case STATE_RDSR:
+      reply = m_status | (m_writeEnabled ? 0x02 : 0x00);
+      break;
+    case STATE_WRSR:
+      m_status = t_data & 0xFC;   // WIP and WEL can't be written
+      m_state = STATE_IGNORE;
+      break;
+    case STATE_RDID:
+      if (m_idIndex < 4) {
+        reply = (m_idIndex == 2) ? PART_RDID_DENSITY[m_partNumber] : FUJITSU_RDID[m_idIndex];
+        m_idIndex++;
+      }
+      break;
+    default:
+      break;
+  }
+  return reply;
+}
+
+// *** Host Arduino core and SPI library.  Pins are numbered as on the Mega; each pin gets its own fake port, bit 0.
+
+HostSREG & HostSREG::operator=(uint8_t t_value) {
+  value = t_value;
+  FerroEmulator::pinsChanged();
+  return *this;
+}
+
+void cli() { }
+void sei() { }
+
+unsigned long micros() { return (unsigned long)FerroEmulator::elapsedMicros(); }
+unsigned long millis() { return (unsigned long)(FerroEmulator::elapsedMicros() / 1000.0); }
+void delay(unsigned long t_ms) { FerroEmulator::advanceMicros(t_ms * 1000.0); }
+void delayMicroseconds(unsigned int t_us) { FerroEmulator::advanceMicros(t_us); }
+
+void pinMode(uint8_t t_pin, uint8_t t_mode) { (void)t_pin; (void)t_mode; }
+
+void digitalWrite(uint8_t t_pin, uint8_t t_val) {
+  if (t_pin >= HOST_PORTS) return;
+  g_port[t_pin + 1] = t_val ? 0xFF : 0x00;
+  FerroEmulator::pinsChanged();
+}
+
+uint8_t digitalPinToTimer(uint8_t t_pin) { (void)t_pin; return NOT_ON_TIMER; }
+uint8_t digitalPinToPort(uint8_t t_pin) { return (t_pin < HOST_PORTS) ? (t_pin + 1) : NOT_A_PIN; }
+uint8_t digitalPinToBitMask(uint8_t t_pin) { (void)t_pin; return 0x01; }
+volatile uint8_t * portOutputRegister(uint8_t t_port) { return &g_port[t_port]; }
+
+void SPIClass::begin() { }
+void SPIClass::end() { }
+void SPIClass::setBitOrder(uint8_t t_bitOrder) { (void)t_bitOrder; }
+void SPIClass::setDataMode(uint8_t t_mode) { (void)t_mode; }
+void SPIClass::setClockDivider(uint8_t t_divider) { FerroEmulator::spiSetClockDivider(t_divider); }
+uint8_t SPIClass::transfer(uint8_t t_data) { return FerroEmulator::spiTransfer(t_data); }
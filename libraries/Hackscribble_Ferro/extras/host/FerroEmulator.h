@@ -0,0 +1,94 @@
+// Rev: 10/19/26
+// FerroEmulator lets the unmodified Hackscribble_Ferro library, and anything built on it (FramTable, FramLayout, the Route and
+// Delayed Action code), run on a Linux PC against an emulated MB85RS chip instead of a real one.
+
+// It works at the SPI level: this folder has host versions of Arduino.h and SPI.h, and SPI.transfer() is answered by whichever
+// emulated chip has its chip select pin LOW, which decodes the same WREN/READ/WRITE/RDSR/WRSR/RDID opcodes the real part does.
+// So the Hackscribble_Ferro.cpp that runs here is byte-for-byte the one that runs on the Mega.
+// Each chip's memory is a file mapped with mmap(), so whatever we write is still there next run, just like a real FRAM.
+// Every byte and every chip select is charged modelled time: 8 SPI clocks (F_CPU / the setClockDivider() divider) plus a
+// per-byte software overhead, plus a per-transaction overhead for each select/deselect.  micros() and millis() return this
+// modelled time, and each chip counts its transactions and bytes, so code can be compared by what it would cost on the Mega.
+// The overhead defaults are rough estimates for a 16MHz Mega; change them with setSPICosts() if we measure better ones.
+// Nothing here is ever compiled by the Arduino IDE, which ignores a library's extras folder.  To build a host program:
+//   g++ -I libraries/Hackscribble_Ferro/extras/host -I libraries/Hackscribble_Ferro [-I other libraries] myprog.cpp
+//       libraries/Hackscribble_Ferro/Hackscribble_Ferro.cpp libraries/Hackscribble_Ferro/extras/host/FerroEmulator.cpp
+// and in myprog.cpp create the emulated chip before calling begin() on the Hackscribble_Ferro object that uses it:
+//   FerroEmulator FRAM1Chip(MB85RS64, PIN_FRAM1, "FRAM1.bin");
+//   Hackscribble_Ferro FRAM1(MB85RS64, PIN_FRAM1);
+// See FerroBench.cpp for an example.
+
+#ifndef FERRO_EMULATOR_H
+#define FERRO_EMULATOR_H
+
+#include "Arduino.h"
+#include "Hackscribble_Ferro.h"
+
+const byte FERRO_EMULATOR_MAX_CHIPS = 4;   // FRAM1, FRAM2 and FRAM3 is all we've ever had on one Arduino
+
+struct ferroEmulatorStats {
+  unsigned long transactions;  // Number of times chip select went LOW
+  unsigned long spiBytes;      // Every byte clocked while selected, including opcodes and address bytes
+  unsigned long bytesRead;     // Data bytes returned by READ
+  unsigned long bytesWritten;  // Data bytes stored by WRITE
+  double        microseconds;  // Modelled time spent on this chip
+};
+
+class FerroEmulator
+{
+  public:
+
+    FerroEmulator(const ferroPartNumber t_partNumber, const byte t_chipSelect, const char t_path[]);
+    // Constructor.  Opens (creating if need be) t_path as the chip's memory, sized for t_partNumber.  A new file reads as 0s.
+    ~FerroEmulator();
+
+    bool isOpen();
+    // False if the file couldn't be opened or mapped, or there are already FERRO_EMULATOR_MAX_CHIPS chips.
+
+    byte * memory();
+    unsigned long size();
+    // The chip's whole memory, control block included, for checking results or loading an image without going through SPI.
+
+    ferroEmulatorStats getStats();
+    void resetStats();
+    void printStats(const char t_label[]);
+    // Prints one line of counts, modelled time and payload bytes/s (bytes read and written per modelled second) to stdout,
+    // after t_label.
+
+    static void setSPICosts(const double t_transactionMicros, const double t_byteOverheadMicros);
+    // Changes the per-transaction and per-byte overheads (microseconds) added on top of the SPI clock time.
+
+    static double elapsedMicros();
+    // Total modelled time since the program started, the same clock micros() reads.
+
+    // Called by the host Arduino.h and SPI.h; nothing else should need these.
+    static void pinsChanged();
+    static byte spiTransfer(const byte t_data);
+    static void spiSetClockDivider(const byte t_divider);
+    static void advanceMicros(const double t_micros);
+
+  private:
+
+    void m_select();
+    void m_deselect();
+    byte m_transfer(const byte t_data);
+
+    ferroPartNumber m_partNumber;
+    byte m_chipSelect;
+    int m_fd;
+    byte * m_memory;
+    unsigned long m_size;
+    byte m_addressBytes;        // 2 or 3
+    bool m_selected;
+    byte m_state;               // What the next byte clocked in means; see FerroEmulator.cpp
+    byte m_opcode;
+    unsigned long m_address;
+    byte m_addressBytesLeft;
+    byte m_idIndex;
+    bool m_writeEnabled;        // WEL: set by WREN, cleared when a WRITE or WRSR transaction ends
+    byte m_status;              // Status register (WPEN, BP1, BP0 and the spare bits 6..4; WEL is reported from m_writeEnabled)
+    ferroEmulatorStats m_stats;
+
+};
+
+#endif
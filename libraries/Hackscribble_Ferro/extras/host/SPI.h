@@ -0,0 +1,37 @@
+// Rev: 10/19/26
+// Host (Linux) stand-in for the Arduino SPI library.  transfer() goes to whichever FerroEmulator chip is selected.
+// See FerroEmulator.h.
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+// Same values as the AVR SPI library, so a sketch's setClockDivider() argument means the same thing here.
+#define SPI_CLOCK_DIV4   0x00
+#define SPI_CLOCK_DIV16  0x01
+#define SPI_CLOCK_DIV64  0x02
+#define SPI_CLOCK_DIV128 0x03
+#define SPI_CLOCK_DIV2   0x04
+#define SPI_CLOCK_DIV8   0x05
+#define SPI_CLOCK_DIV32  0x06
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPIClass
+{
+  public:
+    void begin();
+    void end();
+    void setBitOrder(uint8_t t_bitOrder);
+    void setDataMode(uint8_t t_mode);
+    void setClockDivider(uint8_t t_divider);
+    uint8_t transfer(uint8_t t_data);
+};
+
+extern SPIClass SPI;
+
+#endif
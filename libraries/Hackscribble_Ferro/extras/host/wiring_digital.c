@@ -0,0 +1,12 @@
+// Rev: 10/19/26
+// Host (Linux) stand-in.  Hackscribble_Ferro.cpp #includes the Arduino core's wiring_digital.c to get at turnOffPWM(); on the
+// host there is no PWM to turn off.  See FerroEmulator.h.
+
+#ifndef HOST_WIRING_DIGITAL_C
+#define HOST_WIRING_DIGITAL_C
+
+#include <stdint.h>
+
+static void turnOffPWM(uint8_t t_timer) { (void)t_timer; }
+
+#endif
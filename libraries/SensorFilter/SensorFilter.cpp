@@ -0,0 +1,77 @@
+// Rev: 10/19/26
+// SensorFilter: per-sensor trip/clear glitch filter for A-SNS.  See SensorFilter.h.
+
+#include "SensorFilter.h"
+
+SensorFilter::SensorFilter(const byte t_tripHoldMS[], const unsigned int t_clearHoldMS[]) {
+  // Rev: 10/19/26.
+  m_tripHoldMS = t_tripHoldMS;
+  m_clearHoldMS = t_clearHoldMS;
+  for (byte port = 0; port < SENSOR_FILTER_PORTS; port++) {
+    m_state[port] = 0xFFFF;
+    m_raw[port] = 0xFFFF;
+    m_pending[port] = 0;
+  }
+  memset(m_pendingMicros, 0, sizeof(m_pendingMicros));
+}
+
+void SensorFilter::begin(const byte t_port, const unsigned int t_raw) {
+  // Rev: 10/19/26.
+  m_state[t_port] = t_raw;
+  m_raw[t_port] = t_raw;
+  m_pending[t_port] = 0;
+  return;
+}
+
+void SensorFilter::processPortImage(const byte t_port, const unsigned int t_raw, const unsigned long t_micros) {
+  // Rev: 10/19/26.  changed uses Exclusive OR (^) to find bits that differ from the filtered state, one way or the other.  Bits
+  // that were pending but now match the filtered state again were a glitch, so they just drop out of the mask.
+  m_raw[t_port] = t_raw;
+  const unsigned int changed = m_state[t_port] ^ t_raw;
+  const unsigned int started = changed & ~m_pending[t_port];   // Newly different, so start timing these
+  m_pending[t_port] = changed;
+  if (started != 0) {
+    for (byte bit = 0; bit < 16; bit++) {
+      if (started & (1U << bit)) m_pendingMicros[(t_port * 16) + bit] = t_micros;
+    }
+  }
+  return;
+}
+
+bool SensorFilter::nextChange(const unsigned long t_nowMicros, byte * t_sensorNum, byte * t_changeType,
+                              unsigned long * t_captureMicros) {
+  // Rev: 10/19/26.  A pending bit that is now 1 in the raw reading is going to clear; 0 is going to tripped.  micros() wraps at
+  // 32 bits, so the subtraction is done in 32 bits even where unsigned long is longer (i.e. on a PC.)
+  for (byte port = 0; port < SENSOR_FILTER_PORTS; port++) {
+    if (m_pending[port] == 0) continue;
+    for (byte bit = 0; bit < 16; bit++) {
+      const unsigned int mask = 1U << bit;
+      if ((m_pending[port] & mask) == 0) continue;
+      const byte index = (port * 16) + bit;
+      const unsigned long heldMS = (uint32_t)(t_nowMicros - m_pendingMicros[index]) / 1000;
+      const bool clearing = ((m_raw[port] & mask) != 0);
+      if (heldMS < (clearing ? m_clearHoldMS[index] : (unsigned int)m_tripHoldMS[index])) continue;
+      if (clearing) {
+        m_state[port] |= mask;
+      } else {
+        m_state[port] &= ~mask;
+      }
+      m_pending[port] &= ~mask;
+      * t_sensorNum = index + 1;
+      * t_changeType = clearing ? 0 : 1;
+      * t_captureMicros = m_pendingMicros[index];
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SensorFilter::isPending() {
+  // Rev: 10/19/26.
+  return (m_pending[0] | m_pending[1] | m_pending[2] | m_pending[3]) != 0;
+}
+
+unsigned int SensorFilter::getState(const byte t_port) {
+  // Rev: 10/19/26.
+  return m_state[t_port];
+}
@@ -0,0 +1,62 @@
+// Rev: 10/19/26
+// SensorFilter is A-SNS's per-sensor glitch filter: a raw change in an occupancy sensor is only reported once it has held steady
+// for that sensor's hold time, which is short for trips and long for clears.
+
+// Brief gaps between cars used to be hidden by hardware time-delay relays set to several seconds, which delayed every trip *and*
+// clear.  With the filter, an arriving train is seen within milliseconds, and a gap between cars doesn't clear the block.
+// The filter works on the sensor Centipede's four 16-bit ports exactly as they are read: a bit is 1 if the sensor is clear and 0
+// if it is tripped (grounded), and port n bit b is sensor (n * 16) + b + 1.  For each port it keeps the filtered state (what we
+// have reported), the latest raw reading, and a mask of sensors whose raw reading differs from the filtered state and are being
+// timed.  The time kept for a pending sensor is when its raw reading first changed; that, not when the filter accepts the
+// change, is the time reported, so A-MAS's speed calculations aren't skewed by the hold time.
+// If the raw reading goes back to the filtered state before the hold time is up, the change was a glitch and is dropped, and a
+// later change starts timing again from scratch.  Times are micros() values passed in by the caller, so the filter can be
+// replayed on a PC (see extras/host/SensorFilterReplay.cpp); a hold time can be up to 65 seconds.
+
+#ifndef SENSOR_FILTER_H
+#define SENSOR_FILTER_H
+
+#include "Arduino.h"
+
+const byte SENSOR_FILTER_PORTS   =  4;  // One Centipede: four MCP23017s, 16 inputs each
+const byte SENSOR_FILTER_SENSORS = 64;
+
+class SensorFilter
+{
+  public:
+
+    SensorFilter(const byte t_tripHoldMS[], const unsigned int t_clearHoldMS[]);
+    // Constructor.  t_tripHoldMS[] and t_clearHoldMS[] are SENSOR_FILTER_SENSORS hold times in ms, for sensor 1 in element 0,
+    // and must stay put (i.e. be global const tables.)  Starts with every sensor clear and nothing pending.
+
+    void begin(const byte t_port, const unsigned int t_raw);
+    // Takes t_raw as both the filtered and raw state of port t_port, with nothing pending.  For the first reading at startup,
+    // which isn't reported as changes.
+
+    void processPortImage(const byte t_port, const unsigned int t_raw, const unsigned long t_micros);
+    // Takes a new raw reading of port t_port, made at t_micros, and starts (or stops) timing each sensor that now differs (or no
+    // longer differs) from the filtered state.
+
+    bool nextChange(const unsigned long t_nowMicros, byte * t_sensorNum, byte * t_changeType, unsigned long * t_captureMicros);
+    // If any pending sensor's raw reading has held long enough by t_nowMicros, accepts the change into the filtered state and
+    // returns true, with its sensor number (1..64), change type (0 = Cleared, 1 = Tripped) and the micros() its raw reading
+    // changed.  Returns false if there's nothing (more) to report.  Call it until it returns false.
+
+    bool isPending();
+    // True if any sensor is being timed, i.e. nextChange() may have something to report later even with no new readings.
+
+    unsigned int getState(const byte t_port);
+    // Filtered state of port t_port, in the same polarity as the Centipede: 1 = clear, 0 = tripped.
+
+  private:
+
+    const byte * m_tripHoldMS;
+    const unsigned int * m_clearHoldMS;
+    unsigned int m_state[SENSOR_FILTER_PORTS];         // Filtered state we have reported
+    unsigned int m_raw[SENSOR_FILTER_PORTS];           // Latest raw reading
+    unsigned int m_pending[SENSOR_FILTER_PORTS];       // Bit = 1 if raw differs from filtered and we're timing it
+    unsigned long m_pendingMicros[SENSOR_FILTER_SENSORS];  // When each pending sensor's raw reading changed
+
+};
+
+#endif
@@ -0,0 +1,187 @@
+// Rev: 10/19/26
+// SensorFilterReplay: replays recorded sensor port readings through SensorFilter on a PC, polling it every millisecond the way
+// A-SNS's loop() does, and checks every change it reports: which sensor, which way, when it was reported and what capture time
+// it carries.
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/SensorFilter -o SensorFilterReplay
+//       libraries/SensorFilter/extras/host/SensorFilterReplay.cpp libraries/SensorFilter/SensorFilter.cpp
+// Run:
+//   ./SensorFilterReplay               Runs the built-in recordings below, and fails if any report differs from what's expected
+//   ./SensorFilterReplay <recording>   Replays a file of "ms port raw" lines (raw in hex, as read from the Centipede; # starts
+//                                      a comment) with A-SNS's hold times, and prints each change reported
+// Hold times in the built-in recordings are A-SNS's (10 ms to trip, 2,000 ms to clear), except sensors 17..32, which take 50 ms
+// to trip and 300 ms to clear, so asymmetric and per-sensor timing are covered too.  Every recording is also replayed starting just
+// before micros() wraps.
+
+#include "SensorFilter.h"
+
+#include <vector>
+
+struct replayReading {
+  unsigned long ms;          // When the port was read
+  byte port;
+  unsigned int raw;          // Centipede bits: 1 = clear, 0 = tripped
+};
+
+struct replayChange {
+  unsigned long ms;          // When the filter reported it
+  byte sensorNum;
+  byte changeType;           // 0 = Cleared, 1 = Tripped
+  unsigned long captureMS;   // Capture time it reported
+};
+
+struct replayRecording {
+  const char * name;
+  std::vector<replayReading> readings;
+  std::vector<replayChange> expected;
+  unsigned long endMS;       // Keep polling until here
+};
+
+byte tripHoldMS[SENSOR_FILTER_SENSORS];
+unsigned int clearHoldMS[SENSOR_FILTER_SENSORS];
+
+const unsigned int CLEAR = 0xFFFF;
+const unsigned int S1    = 0xFFFE;   // Port 0 with sensor 1 tripped
+const unsigned int S2    = 0xFFFD;   // Port 0 with sensor 2 tripped
+const unsigned int S12   = 0xFFFC;   // Port 0 with sensors 1 and 2 tripped
+const unsigned int S17   = 0xFFFE;   // Port 1 with sensor 17 tripped
+
+std::vector<replayRecording> makeRecordings() {
+  std::vector<replayRecording> r;
+  r.push_back({ "Glitches shorter than the trip hold",
+                { {100, 0, S1}, {105, 0, CLEAR}, {200, 0, S1}, {209, 0, CLEAR}, {300, 0, S1}, {301, 0, CLEAR} },
+                { }, 3000 });
+  r.push_back({ "Trip held, then a real clear",
+                { {100, 0, S1}, {1000, 0, CLEAR} },
+                { {110, 1, 1, 100}, {3000, 1, 0, 1000} }, 4000 });
+  r.push_back({ "Gaps between cars shorter than the clear hold",
+                { {100, 0, S1}, {1000, 0, CLEAR}, {2500, 0, S1}, {3000, 0, CLEAR}, {4999, 0, S1}, {6000, 0, CLEAR} },
+                { {110, 1, 1, 100}, {8000, 1, 0, 6000} }, 9000 });
+  r.push_back({ "Re-trip during the clear window restarts the clear from scratch",
+                { {100, 0, S1}, {1000, 0, CLEAR}, {2999, 0, S1}, {3005, 0, CLEAR} },
+                { {110, 1, 1, 100}, {5005, 1, 0, 3005} }, 6000 });
+  r.push_back({ "Asymmetric per-sensor hold times",
+                { {100, 1, S17}, {140, 1, CLEAR}, {200, 1, S17}, {500, 1, CLEAR}, {700, 1, S17}, {710, 1, CLEAR} },
+                { {250, 17, 1, 200}, {1010, 17, 0, 710} }, 2000 });
+  r.push_back({ "Two sensors on one port, changing independently",
+                { {100, 0, S1}, {104, 0, S12}, {1000, 0, S2}, {1500, 0, S12}, {1600, 0, CLEAR} },
+                { {110, 1, 1, 100}, {114, 2, 1, 104}, {3600, 1, 0, 1600}, {3600, 2, 0, 1600} }, 5000 });
+  // In SENSOR_INTERRUPTS mode A-SNS processes INTCAP (the state at the first change) and then the current state, together.
+  r.push_back({ "Glitch latched by INTCAP and gone by the time it's read",
+                { {100, 0, S1}, {100, 0, CLEAR}, {200, 0, S1}, {200, 0, S1} },
+                { {210, 1, 1, 200} }, 1000 });
+  r.push_back({ "Same sensor number on every port",
+                { {100, 0, S1}, {100, 1, S17}, {100, 2, 0xFFFE}, {100, 3, 0xFFFE} },
+                { {110, 1, 1, 100}, {110, 33, 1, 100}, {110, 49, 1, 100}, {150, 17, 1, 100} }, 1000 });
+  return r;
+}
+
+// Replays t_rec with ms 0 at micros() t_baseMicros, polling every ms, and returns the changes reported.
+std::vector<replayChange> replay(const replayRecording & t_rec, const unsigned long t_baseMicros, const bool t_print) {
+  SensorFilter filter(tripHoldMS, clearHoldMS);
+  for (byte port = 0; port < SENSOR_FILTER_PORTS; port++) filter.begin(port, CLEAR);
+  std::vector<replayChange> reported;
+  size_t next = 0;
+  for (unsigned long ms = 0; ms <= t_rec.endMS; ms++) {
+    const unsigned long nowMicros = (uint32_t)(t_baseMicros + (ms * 1000UL));   // 32 bits, as on the Mega
+    while ((next < t_rec.readings.size()) && (t_rec.readings[next].ms == ms)) {
+      filter.processPortImage(t_rec.readings[next].port, t_rec.readings[next].raw, nowMicros);
+      next++;
+    }
+    replayChange change;
+    unsigned long captureMicros;
+    while (filter.nextChange(nowMicros, &change.sensorNum, &change.changeType, &captureMicros)) {
+      change.ms = ms;
+      change.captureMS = (uint32_t)(captureMicros - t_baseMicros) / 1000UL;
+      reported.push_back(change);
+      if (t_print) {
+        printf("%8lu ms  sensor %2u %s, captured at %lu ms\n", ms, change.sensorNum, change.changeType ? "tripped" : "cleared",
+               change.captureMS);
+      }
+    }
+  }
+  return reported;
+}
+
+bool readRecording(const char t_path[], replayRecording * t_rec) {
+  FILE * f = fopen(t_path, "r");
+  if (f == NULL) return false;
+  char text[256];
+  t_rec->name = t_path;
+  t_rec->endMS = 0;
+  while (fgets(text, sizeof(text), f) != NULL) {
+    char * hash = strchr(text, '#');
+    if (hash != NULL) * hash = '\0';
+    unsigned long ms;
+    unsigned int port;
+    unsigned int raw;
+    if (sscanf(text, "%lu %u %x", &ms, &port, &raw) != 3) continue;
+    if ((port >= SENSOR_FILTER_PORTS) || (ms < t_rec->endMS)) {
+      printf("%s: readings must be in time order, on ports 0..3\n", t_path);
+      fclose(f);
+      return false;
+    }
+    t_rec->readings.push_back({ ms, (byte)port, raw });
+    t_rec->endMS = ms;
+  }
+  fclose(f);
+  t_rec->endMS = t_rec->endMS + 2000;   // Long enough for any clear still pending at the end
+  return true;
+}
+
+int main(int argc, char * argv[]) {
+  for (byte i = 0; i < SENSOR_FILTER_SENSORS; i++) {   // As in A-SNS
+    tripHoldMS[i] = 10;
+    clearHoldMS[i] = 2000;
+  }
+  if (argc == 2) {
+    replayRecording rec;
+    if (!readRecording(argv[1], &rec)) {
+      printf("Can't read %s.\n", argv[1]);
+      return 1;
+    }
+    replay(rec, 0, true);
+    return 0;
+  }
+  if (argc != 1) {
+    printf("Usage: SensorFilterReplay [recording]\n");
+    return 1;
+  }
+  for (byte i = 16; i < 32; i++) {   // Sensors 17..32
+    tripHoldMS[i] = 50;
+    clearHoldMS[i] = 300;
+  }
+
+  const unsigned long BASES[2] = { 0, 0xFFFFFFFFUL - 1500000UL };   // From zero, and across the micros() wrap
+  unsigned int failures = 0;
+  std::vector<replayRecording> recordings = makeRecordings();
+  for (size_t r = 0; r < recordings.size(); r++) {
+    for (byte b = 0; b < 2; b++) {
+      std::vector<replayChange> got = replay(recordings[r], BASES[b], false);
+      const std::vector<replayChange> & want = recordings[r].expected;
+      bool same = (got.size() == want.size());
+      for (size_t i = 0; same && (i < got.size()); i++) {
+        same = (got[i].ms == want[i].ms) && (got[i].sensorNum == want[i].sensorNum) &&
+               (got[i].changeType == want[i].changeType) && (got[i].captureMS == want[i].captureMS);
+      }
+      printf("%-4s %s%s\n", same ? "OK" : "FAIL", recordings[r].name, b ? " (across the micros() wrap)" : "");
+      if (!same) {
+        failures++;
+        for (size_t i = 0; i < want.size(); i++) {
+          printf("       expected %6lu ms  sensor %2u %s, captured at %lu\n", want[i].ms, want[i].sensorNum,
+                 want[i].changeType ? "tripped" : "cleared", want[i].captureMS);
+        }
+        for (size_t i = 0; i < got.size(); i++) {
+          printf("       got      %6lu ms  sensor %2u %s, captured at %lu\n", got[i].ms, got[i].sensorNum,
+                 got[i].changeType ? "tripped" : "cleared", got[i].captureMS);
+        }
+      }
+    }
+  }
+  if (failures == 0) {
+    printf("Every recording reported exactly the expected changes.\n");
+  } else {
+    printf("%u FAILURES.\n", failures);
+  }
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+// Rev: 10/19/26
+// TrainStopping: stopping distance and slow-down delay from measured deceleration data.  See TrainStopping.h.
+
+#include "TrainStopping.h"
+
+trainStoppingStruct TrainStopping::build(const byte t_trainNum, const byte t_speed, const byte t_momentum,
+                                         const trainDecelerationStruct t_decel[], const byte t_decelRecs,
+                                         const long t_calibratedRate, const unsigned int t_latencyMS) {
+  // Rev: 10/19/26.  Find the measured fromSpeeds just below and just above t_speed for this train and momentum, and interpolate
+  // mm/sec and stopping distance between them.  An exact match needs no interpolation.  We don't extrapolate beyond the measured
+  // speeds, because an underestimated stopping distance would run the train past the exit sensor.
+  trainStoppingStruct tStop;
+  tStop.mmStopping = 0;
+  tStop.msPerMmQ8 = 0;
+  if (t_speed == 0) return tStop;   // Speed not defined for this train
+  int tBelow = -1;   // t_decel[] index of the highest measured fromSpeed <= t_speed
+  int tAbove = -1;   // t_decel[] index of the lowest measured fromSpeed >= t_speed
+  for (byte i = 0; i < t_decelRecs; i++) {
+    if ((t_decel[i].trainNum != t_trainNum) || (t_decel[i].momentum != t_momentum)) continue;
+    if ((t_decel[i].fromSpeed <= t_speed) && ((tBelow < 0) || (t_decel[i].fromSpeed > t_decel[tBelow].fromSpeed))) {
+      tBelow = i;
+    }
+    if ((t_decel[i].fromSpeed >= t_speed) && ((tAbove < 0) || (t_decel[i].fromSpeed < t_decel[tAbove].fromSpeed))) {
+      tAbove = i;
+    }
+  }
+  if ((tBelow < 0) || (tAbove < 0)) return tStop;   // No measurements on both sides of this speed at this momentum
+  long tRate = t_decel[tBelow].mmPerSecond;
+  long tDistance = t_decel[tBelow].mmDistance;
+  if (tAbove != tBelow) {   // Interpolate, using an 8-bit fixed-point fraction 0..256 of the way from tBelow to tAbove
+    long tFraction = ((long)(t_speed - t_decel[tBelow].fromSpeed) << 8) / (t_decel[tAbove].fromSpeed - t_decel[tBelow].fromSpeed);
+    tRate = tRate + ((((long)t_decel[tAbove].mmPerSecond - tRate) * tFraction) >> 8);
+    tDistance = tDistance + ((((long)t_decel[tAbove].mmDistance - tDistance) * tFraction) >> 8);
+  }
+  if (t_calibratedRate >= 0) tRate = t_calibratedRate;   // Measured speed beats interpolated speed
+  if (tRate < TRAIN_STOPPING_MIN_RATE) return tStop;    // Barely moving, and 256,000 / tRate wouldn't fit in msPerMmQ8
+  // Distance covered during t_latencyMS is traveled at full entry speed, so add it to the deceleration distance.
+  tDistance = tDistance + ((tRate * t_latencyMS) / 1000);
+  if (tDistance > 65535) return tStop;   // Longer than any siding, so of no use
+  tStop.mmStopping = tDistance;
+  tStop.msPerMmQ8 = (1000UL << 8) / tRate;
+  return tStop;
+}
+
+bool TrainStopping::slowDelay(const trainStoppingStruct * t_stop, const unsigned int t_blockLen, unsigned long * t_delayMS) {
+  // Rev: 10/19/26.  One multiply: the part of the siding not needed for stopping, at the entry speed.
+  * t_delayMS = 0;
+  if ((t_stop->msPerMmQ8 == 0) || (t_stop->mmStopping > t_blockLen)) return false;
+  * t_delayMS = ((unsigned long)(t_blockLen - t_stop->mmStopping) * t_stop->msPerMmQ8) >> 8;
+  return true;
+}
@@ -0,0 +1,50 @@
+// Rev: 10/19/26
+// TrainStopping works out, from measured deceleration data, how far a train travels between tripping the entry sensor of its
+// destination siding and reaching crawl speed, and how long to wait before slowing it so that it reaches crawl speed just as it
+// gets to the exit sensor.  A-LEG builds its Train Stopping table with it at startup; see trainStoppingInit() there.
+
+// The arithmetic is all integer: where a train's Legacy speed falls between two measured entry speeds, speed and stopping
+// distance are interpolated with an 8-bit fixed-point fraction, and the travel time per mm is kept times 256.  It's a library,
+// rather than part of the sketch, only so that extras/host/TrainStoppingTest can check it against A-LEG's data on a PC.
+
+#ifndef TRAIN_STOPPING_H
+#define TRAIN_STOPPING_H
+
+#include "Arduino.h"
+
+const byte TRAIN_STOPPING_MIN_RATE = 4;  // Slowest entry speed, mm/sec, we'll time a stop for; 256000 / rate must fit msPerMmQ8
+
+struct trainDecelerationStruct {
+  byte trainNum;                  // 1..8 matches Train Reference; not same as Legacy ID which could be a Train or Engine of any value up to 4 digits
+  byte fromSpeed;                 // The Legacy speed 1..199 that the train enters the siding; corresponds to Slow, Med, or High speed
+  unsigned int mmPerSecond;       // Speed in mm/second that the train travels at "fromSpeed."
+  byte toSpeed;                   // The Legacy speed 1..199 that is our target "crawl" speed.  Always 20 as of 1/17/17.
+  byte momentum;                  // The Legacy momentum setting 1..8 at which the stopping distance is calculated
+  unsigned int mmDistance;        // Distance required to slow from "fromSpeed" to "toSpeed" at "momentum", not including latency.
+};
+
+struct trainStoppingStruct {
+  unsigned int mmStopping;           // Distance traveled from tripping the entry sensor to reaching crawl speed, less the delay: latency plus deceleration.
+  unsigned int msPerMmQ8;            // Milliseconds to travel one mm at the entry speed, times 256.  0 if we have no data for this speed and momentum.
+};
+
+class TrainStopping
+{
+  public:
+
+    static trainStoppingStruct build(const byte t_trainNum, const byte t_speed, const byte t_momentum,
+                                     const trainDecelerationStruct t_decel[], const byte t_decelRecs,
+                                     const long t_calibratedRate, const unsigned int t_latencyMS);
+    // Returns the Train Stopping element for train t_trainNum (1..8) entering a siding at Legacy speed t_speed with momentum
+    // t_momentum, from the t_decelRecs measurements in t_decel[].  If the train has been calibrated, t_calibratedRate is its
+    // mm/sec at t_speed from the curve, which beats the interpolated one; otherwise pass -1.  t_latencyMS is how long the train
+    // keeps going at full speed before Legacy acts.  Both fields are 0 if the measurements don't bracket t_speed at this
+    // momentum (we never extrapolate), or the train would be too slow or the distance too long to be of any use.
+
+    static bool slowDelay(const trainStoppingStruct * t_stop, const unsigned int t_blockLen, unsigned long * t_delayMS);
+    // Sets * t_delayMS to the ms to wait before slowing, for a siding t_blockLen mm long, and returns true.  Returns false, with
+    // * t_delayMS 0, if t_stop has no data or the train can't slow down in time.
+
+};
+
+#endif
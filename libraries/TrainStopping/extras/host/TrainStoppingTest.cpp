@@ -0,0 +1,165 @@
+// Rev: 10/19/26
+// TrainStoppingTest: checks the Train Stopping table A-LEG builds at startup, and the slow-down delays it gives, against the
+// Train Deceleration data in A_LEG.ino itself, worked out again here in floating point.
+// Build from the top of the repo:
+//   g++ -O2 -I libraries/Hackscribble_Ferro/extras/host -I libraries/TrainStopping -o TrainStoppingTest
+//       libraries/TrainStopping/extras/host/TrainStoppingTest.cpp libraries/TrainStopping/TrainStopping.cpp
+// Run:
+//   ./TrainStoppingTest A_LEG/A_LEG.ino
+// The trainDeceleration[] rows, DECELERATION_RECS and LEGACY_LATENCY_MS are read out of the sketch, so the test always covers the
+// data A-LEG is actually built with.  Every train, momentum and Legacy speed 1..199 is built, and checked for:
+//   Measured speeds: exactly the measured distance plus latency, and 256000 / mm/sec.
+//   Speeds between two measurements: within the 8-bit fraction's rounding of straight-line interpolation.
+//   Speeds outside the measurements: no data, since we never extrapolate.
+// Then slow-down delays for a range of siding lengths, and calibrated rates either side of TRAIN_STOPPING_MIN_RATE.
+
+#include "TrainStopping.h"
+
+#include <math.h>
+#include <vector>
+
+const unsigned int TEST_MAX_RECS = 64;
+
+std::vector<trainDecelerationStruct> decel;
+unsigned int latencyMS = 0;
+unsigned long failures = 0;
+
+// Reads the data we need out of A_LEG.ino.  Returns false if any of it is missing or DECELERATION_RECS disagrees with the rows.
+bool readSketch(const char t_path[]) {
+  FILE * f = fopen(t_path, "r");
+  if (f == NULL) return false;
+  char text[1024];
+  unsigned int recs = 0;
+  bool inTable = false;
+  while (fgets(text, sizeof(text), f) != NULL) {
+    const char * p;
+    if ((p = strstr(text, "const unsigned int LEGACY_LATENCY_MS =")) != NULL) sscanf(strchr(p, '=') + 1, "%u", &latencyMS);
+    if ((p = strstr(text, "const byte DECELERATION_RECS =")) != NULL) sscanf(strchr(p, '=') + 1, "%u", &recs);
+    if (strstr(text, "trainDeceleration[DECELERATION_RECS] = {") != NULL) {
+      inTable = true;
+      continue;
+    }
+    if (!inTable) continue;
+    if (strstr(text, "};") != NULL) break;
+    unsigned int v[6];
+    if (sscanf(text, " {%u, %u, %u, %u, %u, %u", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6) continue;
+    trainDecelerationStruct rec = { (byte)v[0], (byte)v[1], v[2], (byte)v[3], (byte)v[4], v[5] };
+    decel.push_back(rec);
+  }
+  fclose(f);
+  printf("%s: %u deceleration rows (DECELERATION_RECS %u), latency %u ms\n", t_path, (unsigned int)decel.size(), recs,
+         latencyMS);
+  return (decel.size() > 0) && (decel.size() == recs) && (recs <= TEST_MAX_RECS) && (latencyMS > 0);
+}
+
+void fail(const char t_what[], const unsigned int t_train, const unsigned int t_speed, const unsigned int t_momentum,
+          const double t_expected, const double t_got) {
+  if (failures < 20) {
+    printf("FAIL %s: train %u speed %u momentum %u: expected %.2f, got %.2f\n", t_what, t_train, t_speed, t_momentum, t_expected,
+           t_got);
+  }
+  failures++;
+  return;
+}
+
+int main(int argc, char * argv[]) {
+  if (argc != 2) {
+    printf("Usage: TrainStoppingTest <path to A_LEG.ino>\n");
+    return 1;
+  }
+  if (!readSketch(argv[1])) {
+    printf("Couldn't read the Train Deceleration data.\n");
+    return 1;
+  }
+  const byte recs = decel.size();
+  unsigned long built = 0;
+  unsigned long exact = 0;
+  unsigned long interpolated = 0;
+  unsigned long delays = 0;
+  for (unsigned int train = 1; train <= 8; train++) {
+    for (unsigned int momentum = 1; momentum <= 8; momentum++) {
+      for (unsigned int speed = 1; speed <= 199; speed++) {
+        const trainStoppingStruct stop = TrainStopping::build(train, speed, momentum, &decel[0], recs, -1, latencyMS);
+        built++;
+
+        // Straight-line interpolation in floating point, between the nearest measurements either side.
+        int below = -1;
+        int above = -1;
+        for (int i = 0; i < recs; i++) {
+          if ((decel[i].trainNum != train) || (decel[i].momentum != momentum)) continue;
+          if ((decel[i].fromSpeed <= speed) && ((below < 0) || (decel[i].fromSpeed > decel[below].fromSpeed))) below = i;
+          if ((decel[i].fromSpeed >= speed) && ((above < 0) || (decel[i].fromSpeed < decel[above].fromSpeed))) above = i;
+        }
+        if ((below < 0) || (above < 0)) {
+          if ((stop.mmStopping != 0) || (stop.msPerMmQ8 != 0)) fail("extrapolated", train, speed, momentum, 0, stop.mmStopping);
+          continue;
+        }
+        double fraction = 0.0;
+        if (above != below) {
+          fraction = (double)(speed - decel[below].fromSpeed) / (decel[above].fromSpeed - decel[below].fromSpeed);
+        }
+        const double rate = decel[below].mmPerSecond + (fraction * ((double)decel[above].mmPerSecond - decel[below].mmPerSecond));
+        const double distance = decel[below].mmDistance + (fraction * ((double)decel[above].mmDistance - decel[below].mmDistance)) +
+                                (rate * latencyMS / 1000.0);
+        if (above == below) {
+          exact++;
+          if (stop.mmStopping != decel[below].mmDistance + ((unsigned long)decel[below].mmPerSecond * latencyMS / 1000)) {
+            fail("measured distance", train, speed, momentum, distance, stop.mmStopping);
+          }
+          if (stop.msPerMmQ8 != (1000UL << 8) / decel[below].mmPerSecond) {
+            fail("measured ms/mm", train, speed, momentum, 256000.0 / rate, stop.msPerMmQ8);
+          }
+        } else {
+          // The fraction is truncated to 1/256 and each product truncated again, so allow a 1/256 step of each span, plus one
+          // for each truncation, plus the latency distance at the rate error.
+          interpolated++;
+          const double rateSpan = fabs((double)decel[above].mmPerSecond - decel[below].mmPerSecond);
+          const double rateTol = (rateSpan / 256.0) + 1.0;
+          const double distTol = (fabs((double)decel[above].mmDistance - decel[below].mmDistance) / 256.0) + 2.0 +
+                                 (rateTol * latencyMS / 1000.0);
+          if (fabs(stop.mmStopping - distance) > distTol) fail("interpolated distance", train, speed, momentum, distance,
+                                                              stop.mmStopping);
+          const double gotRate = 256000.0 / stop.msPerMmQ8;
+          if (fabs(gotRate - rate) > rateTol + (gotRate * gotRate / 256000.0)) {
+            fail("interpolated mm/sec", train, speed, momentum, rate, gotRate);
+          }
+        }
+
+        // Slow-down delay: the rest of the siding at the entry speed, from the table's own distance and rate.
+        for (unsigned int blockLen = 0; blockLen <= 12000; blockLen += 250) {
+          unsigned long delayMS;
+          const bool ok = TrainStopping::slowDelay(&stop, blockLen, &delayMS);
+          delays++;
+          if (blockLen < stop.mmStopping) {
+            if (ok || (delayMS != 0)) fail("delay for a short siding", train, speed, momentum, 0, delayMS);
+            continue;
+          }
+          const double expected = (blockLen - stop.mmStopping) * 1000.0 / (256000.0 / stop.msPerMmQ8);
+          if (!ok || (fabs(delayMS - expected) > 1.0)) fail("delay", train, speed, momentum, expected, delayMS);
+        }
+      }
+    }
+  }
+
+  // A calibrated rate replaces the interpolated one; below TRAIN_STOPPING_MIN_RATE msPerMmQ8 would overflow, so there's no data.
+  const trainDecelerationStruct * first = &decel[0];
+  for (long rate = 0; rate <= 300; rate++) {
+    const trainStoppingStruct stop = TrainStopping::build(first->trainNum, first->fromSpeed, first->momentum, &decel[0], recs, rate,
+                                                          latencyMS);
+    if (rate < TRAIN_STOPPING_MIN_RATE) {
+      if (stop.msPerMmQ8 != 0) fail("calibrated rate too slow", first->trainNum, first->fromSpeed, first->momentum, 0,
+                                    stop.msPerMmQ8);
+    } else if ((stop.msPerMmQ8 != (1000UL << 8) / rate) ||
+               (stop.mmStopping != first->mmDistance + ((unsigned long)rate * latencyMS / 1000))) {
+      fail("calibrated rate", first->trainNum, first->fromSpeed, first->momentum, rate, 256000.0 / stop.msPerMmQ8);
+    }
+  }
+
+  printf("%lu elements built: %lu at measured speeds, %lu interpolated; %lu delays checked\n", built, exact, interpolated, delays);
+  if (failures == 0) {
+    printf("The Train Stopping table matches the Train Deceleration data.\n");
+  } else {
+    printf("%lu FAILURES.\n", failures);
+  }
+  return (failures == 0) ? 0 : 1;
+}
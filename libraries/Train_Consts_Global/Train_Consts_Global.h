@@ -144,6 +144,7 @@ const byte PIN_ROTARY_PUSH         = 19;  // Input: Rotary Encoder "Select" (pus
 const byte PIN_ROTARY_REGISTER     = 25;  // Input: Rotary mode "Register."  Pulled LOW.
 const byte PIN_ROTARY_START        = 33;  // Input: Rotary "Start" button.  Pulled LOW
 const byte PIN_ROTARY_STOP         = 35;  // Input: Rotary "Stop" button.  Pulled LOW
+const byte PIN_SNS_INT             =  2;  // A_SNS input: MCP23017 INTA/INTB of all four sensor chips (open drain, wired together.)  LOW on change.
 
 // *** OPERATING MODES AND STATES:
 const byte MODE_UNDEFINED  = 0;